@@ -0,0 +1,50 @@
+/*
+  HardwareSerial.cpp - USART0 for the host core
+*/
+
+#include "Arduino.h"
+#include "HardwareSerial.h"
+#include "Sim.h"
+
+void HardwareSerial::begin(unsigned long baud, uint8_t)
+{
+  sim::serialBegin(baud);
+}
+
+void HardwareSerial::end()
+{
+  flush();
+}
+
+int HardwareSerial::available(void)
+{
+  return sim::serialAvailable();
+}
+
+int HardwareSerial::peek(void)
+{
+  return sim::serialPeek();
+}
+
+int HardwareSerial::read(void)
+{
+  return sim::serialRead();
+}
+
+int HardwareSerial::availableForWrite(void)
+{
+  return sim::serialAvailableForWrite();
+}
+
+void HardwareSerial::flush(void)
+{
+  sim::serialFlush();
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  sim::serialWrite(c);
+  return 1;
+}
+
+HardwareSerial Serial;
@@ -0,0 +1,45 @@
+/*
+  HardwareSerial.h - USART0 for the host core
+
+  The byte stream is connected to the simulator's serial pipes (see
+  sim/Sim.h); transmission is paced at the configured baud rate through
+  a 64 byte buffer, so a sketch that prints more than the link can carry
+  blocks exactly as it would on the board.
+*/
+
+#ifndef HardwareSerial_h
+#define HardwareSerial_h
+
+#include <inttypes.h>
+
+#include "Stream.h"
+
+#define SERIAL_TX_BUFFER_SIZE 64
+#define SERIAL_RX_BUFFER_SIZE 64
+
+#define SERIAL_8N1 0x06
+
+class HardwareSerial : public Stream
+{
+  public:
+    HardwareSerial() {}
+    void begin(unsigned long baud) { begin(baud, SERIAL_8N1); }
+    void begin(unsigned long, uint8_t);
+    void end();
+    virtual int available(void);
+    virtual int peek(void);
+    virtual int read(void);
+    virtual int availableForWrite(void);
+    virtual void flush(void);
+    virtual size_t write(uint8_t);
+    inline size_t write(unsigned long n) { return write((uint8_t)n); }
+    inline size_t write(long n) { return write((uint8_t)n); }
+    inline size_t write(unsigned int n) { return write((uint8_t)n); }
+    inline size_t write(int n) { return write((uint8_t)n); }
+    using Print::write; // pull in write(str) and write(buf, size) from Print
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
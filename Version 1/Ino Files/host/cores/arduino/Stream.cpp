@@ -0,0 +1,185 @@
+/*
+  Stream.cpp - base class for character-based streams
+  Host core re-implementation of the Arduino API.
+*/
+
+#include "Arduino.h"
+#include "Stream.h"
+
+// private method to read stream with timeout
+int Stream::timedRead()
+{
+  int c;
+  _startMillis = millis();
+  do {
+    c = read();
+    if (c >= 0) return c;
+    yield();
+  } while(millis() - _startMillis < _timeout);
+  return -1;     // -1 indicates timeout
+}
+
+// private method to peek stream with timeout
+int Stream::timedPeek()
+{
+  int c;
+  _startMillis = millis();
+  do {
+    c = peek();
+    if (c >= 0) return c;
+    yield();
+  } while(millis() - _startMillis < _timeout);
+  return -1;     // -1 indicates timeout
+}
+
+// returns peek of the next digit in the stream or -1 if timeout
+// discards non-numeric characters
+int Stream::peekNextDigit()
+{
+  int c;
+  while (1) {
+    c = timedPeek();
+    if (c < 0) return c;  // timeout
+    if (c == '-') return c;
+    if (c >= '0' && c <= '9') return c;
+    read();  // discard non-numeric
+  }
+}
+
+// Public Methods
+//////////////////////////////////////////////////////////////
+
+void Stream::setTimeout(unsigned long timeout)  // sets the maximum number of milliseconds to wait
+{
+  _timeout = timeout;
+}
+
+bool Stream::find(const char *target)
+{
+  return find(target, strlen(target));
+}
+
+bool Stream::find(const char *target, size_t length)
+{
+  size_t index = 0;
+  if (length == 0) return true;
+  int c;
+  while ((c = timedRead()) >= 0) {
+    if (c == target[index]) {
+      if (++index >= length) return true;
+    } else {
+      index = (c == target[0]) ? 1 : 0;
+    }
+  }
+  return false;
+}
+
+bool Stream::findUntil(const char *target, const char *terminator)
+{
+  size_t index = 0;
+  size_t termIndex = 0;
+  size_t targetLen = strlen(target);
+  size_t termLen = strlen(terminator);
+  int c;
+  while ((c = timedRead()) >= 0) {
+    if (c == target[index]) {
+      if (++index >= targetLen) return true;
+    } else {
+      index = 0;
+    }
+    if (termLen > 0 && c == terminator[termIndex]) {
+      if (++termIndex >= termLen) return false;
+    } else {
+      termIndex = 0;
+    }
+  }
+  return false;
+}
+
+long Stream::parseInt()
+{
+  bool isNegative = false;
+  long value = 0;
+  int c = peekNextDigit();
+  if (c < 0) return 0; // zero returned if timeout
+
+  do {
+    if (c == '-') isNegative = true;
+    else if (c >= '0' && c <= '9') value = value * 10 + c - '0';
+    read();  // consume the character we got with peek
+    c = timedPeek();
+  } while ((c >= '0' && c <= '9') || (c == '-' && value == 0 && !isNegative));
+
+  return isNegative ? -value : value;
+}
+
+float Stream::parseFloat()
+{
+  bool isNegative = false;
+  bool isFraction = false;
+  long value = 0;
+  float fraction = 1.0;
+  int c = peekNextDigit();
+  if (c < 0) return 0; // zero returned if timeout
+
+  do {
+    if (c == '-') isNegative = true;
+    else if (c == '.') isFraction = true;
+    else if (c >= '0' && c <= '9') {
+      value = value * 10 + c - '0';
+      if (isFraction) fraction *= 0.1f;
+    }
+    read();  // consume the character we got with peek
+    c = timedPeek();
+  } while ((c >= '0' && c <= '9') || (c == '.' && !isFraction));
+
+  if (isNegative) value = -value;
+  if (isFraction) return value * fraction;
+  return value;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+  size_t count = 0;
+  while (count < length) {
+    int c = timedRead();
+    if (c < 0) break;
+    *buffer++ = (char)c;
+    count++;
+  }
+  return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length)
+{
+  size_t index = 0;
+  while (index < length) {
+    int c = timedRead();
+    if (c < 0 || c == terminator) break;
+    *buffer++ = (char)c;
+    index++;
+  }
+  return index; // return number of characters, not including null terminator
+}
+
+String Stream::readString()
+{
+  String ret;
+  int c = timedRead();
+  while (c >= 0) {
+    ret += (char)c;
+    c = timedRead();
+  }
+  return ret;
+}
+
+String Stream::readStringUntil(char terminator)
+{
+  String ret;
+  int c = timedRead();
+  while (c >= 0 && c != terminator) {
+    ret += (char)c;
+    c = timedRead();
+  }
+  return ret;
+}
@@ -0,0 +1,47 @@
+/*
+  Stream.h - base class for character-based streams
+  Host core re-implementation of the Arduino API.
+*/
+
+#ifndef Stream_h
+#define Stream_h
+
+#include <inttypes.h>
+#include "Print.h"
+
+class Stream : public Print
+{
+  protected:
+    unsigned long _timeout;      // number of milliseconds to wait for the next char before aborting timed read
+    unsigned long _startMillis;  // used for timeout measurement
+    int timedRead();    // private method to read stream with timeout
+    int timedPeek();    // private method to peek stream with timeout
+    int peekNextDigit(); // returns the next numeric digit in the stream or -1 if timeout
+
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    Stream() {_timeout=1000;}
+
+    void setTimeout(unsigned long timeout);
+    unsigned long getTimeout(void) { return _timeout; }
+
+    bool find(const char *target);
+    bool find(const char *target, size_t length);
+    bool findUntil(const char *target, const char *terminator);
+
+    long parseInt();
+    float parseFloat();
+
+    size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+    size_t readBytesUntil(char terminator, char *buffer, size_t length);
+    size_t readBytesUntil(char terminator, uint8_t *buffer, size_t length) { return readBytesUntil(terminator, (char *)buffer, length); }
+
+    String readString();
+    String readStringUntil(char terminator);
+};
+
+#endif
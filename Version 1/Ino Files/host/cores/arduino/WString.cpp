@@ -0,0 +1,141 @@
+/*
+  WString.cpp - String class for the host core
+*/
+
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "WString.h"
+
+static std::string toBase(unsigned long value, unsigned char base)
+{
+  char buf[8 * sizeof(long) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if (base < 2) base = 10;
+  do {
+    char c = value % base;
+    value /= base;
+    *--str = c < 10 ? c + '0' : c + 'a' - 10;
+  } while (value);
+  return std::string(str);
+}
+
+String::String(unsigned char value, unsigned char base) : buffer(toBase(value, base)) {}
+
+String::String(int value, unsigned char base) : String((long) value, base) {}
+
+String::String(unsigned int value, unsigned char base) : buffer(toBase(value, base)) {}
+
+String::String(long value, unsigned char base)
+{
+  if (base == 10 && value < 0) buffer = "-" + toBase(0UL - (unsigned long) value, 10);
+  else buffer = toBase((unsigned long) value, base);
+}
+
+String::String(unsigned long value, unsigned char base) : buffer(toBase(value, base)) {}
+
+String::String(float value, unsigned char decimalPlaces) : String((double) value, decimalPlaces) {}
+
+String::String(double value, unsigned char decimalPlaces)
+{
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+  buffer = buf;
+}
+
+unsigned char String::equalsIgnoreCase(const String &s) const
+{
+  if (buffer.size() != s.buffer.size()) return 0;
+  for (size_t i = 0; i < buffer.size(); i++) {
+    if (tolower(buffer[i]) != tolower(s.buffer[i])) return 0;
+  }
+  return 1;
+}
+
+unsigned char String::endsWith(const String &suffix) const
+{
+  if (suffix.buffer.size() > buffer.size()) return 0;
+  return buffer.compare(buffer.size() - suffix.buffer.size(), suffix.buffer.size(), suffix.buffer) == 0;
+}
+
+void String::getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index) const
+{
+  if (!bufsize || !buf) return;
+  if (index >= buffer.size()) {
+    buf[0] = 0;
+    return;
+  }
+  unsigned int n = bufsize - 1;
+  if (n > buffer.size() - index) n = buffer.size() - index;
+  memcpy(buf, buffer.c_str() + index, n);
+  buf[n] = 0;
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const
+{
+  size_t pos = buffer.find(ch, fromIndex);
+  return pos == std::string::npos ? -1 : (int) pos;
+}
+
+int String::indexOf(const String &str, unsigned int fromIndex) const
+{
+  size_t pos = buffer.find(str.buffer, fromIndex);
+  return pos == std::string::npos ? -1 : (int) pos;
+}
+
+int String::lastIndexOf(char ch) const
+{
+  size_t pos = buffer.rfind(ch);
+  return pos == std::string::npos ? -1 : (int) pos;
+}
+
+String String::substring(unsigned int left, unsigned int right) const
+{
+  if (left > right) {
+    unsigned int temp = right;
+    right = left;
+    left = temp;
+  }
+  String out;
+  if (left >= buffer.size()) return out;
+  if (right > buffer.size()) right = buffer.size();
+  out.buffer = buffer.substr(left, right - left);
+  return out;
+}
+
+void String::replace(char find, char replace)
+{
+  for (size_t i = 0; i < buffer.size(); i++) {
+    if (buffer[i] == find) buffer[i] = replace;
+  }
+}
+
+void String::replace(const String& find, const String& replace)
+{
+  if (find.buffer.empty()) return;
+  size_t pos = 0;
+  while ((pos = buffer.find(find.buffer, pos)) != std::string::npos) {
+    buffer.replace(pos, find.buffer.size(), replace.buffer);
+    pos += replace.buffer.size();
+  }
+}
+
+void String::toLowerCase(void)
+{
+  for (size_t i = 0; i < buffer.size(); i++) buffer[i] = tolower(buffer[i]);
+}
+
+void String::toUpperCase(void)
+{
+  for (size_t i = 0; i < buffer.size(); i++) buffer[i] = toupper(buffer[i]);
+}
+
+void String::trim(void)
+{
+  size_t begin = 0;
+  while (begin < buffer.size() && isspace(buffer[begin])) begin++;
+  size_t end = buffer.size();
+  while (end > begin && isspace(buffer[end - 1])) end--;
+  buffer = buffer.substr(begin, end - begin);
+}
@@ -0,0 +1,106 @@
+/*
+  WString.h - String class for the host core
+  Same interface as the Arduino String, backed by std::string. Like the
+  AVR version every mutation may hit the heap.
+*/
+
+#ifndef String_class_h
+#define String_class_h
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <string>
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+class String
+{
+  public:
+    String(const char *cstr = "") : buffer(cstr ? cstr : "") {}
+    String(const String &str) : buffer(str.buffer) {}
+    String(const __FlashStringHelper *str) : buffer(reinterpret_cast<const char *>(str)) {}
+    explicit String(char c) : buffer(1, c) {}
+    explicit String(unsigned char, unsigned char base = 10);
+    explicit String(int, unsigned char base = 10);
+    explicit String(unsigned int, unsigned char base = 10);
+    explicit String(long, unsigned char base = 10);
+    explicit String(unsigned long, unsigned char base = 10);
+    explicit String(float, unsigned char decimalPlaces = 2);
+    explicit String(double, unsigned char decimalPlaces = 2);
+
+    unsigned char reserve(unsigned int size) { buffer.reserve(size); return 1; }
+    unsigned int length(void) const { return buffer.size(); }
+
+    String & operator = (const String &rhs) { buffer = rhs.buffer; return *this; }
+    String & operator = (const char *cstr) { buffer = cstr ? cstr : ""; return *this; }
+
+    unsigned char concat(const String &str) { buffer += str.buffer; return 1; }
+    unsigned char concat(const char *cstr) { if (!cstr) return 0; buffer += cstr; return 1; }
+    unsigned char concat(char c) { buffer += c; return 1; }
+    unsigned char concat(unsigned char num) { return concat(String(num)); }
+    unsigned char concat(int num) { return concat(String(num)); }
+    unsigned char concat(unsigned int num) { return concat(String(num)); }
+    unsigned char concat(long num) { return concat(String(num)); }
+    unsigned char concat(unsigned long num) { return concat(String(num)); }
+    unsigned char concat(float num) { return concat(String(num)); }
+    unsigned char concat(double num) { return concat(String(num)); }
+
+    template <typename T>
+    String & operator += (T rhs) { concat(rhs); return (*this); }
+
+    friend String operator + (const String &lhs, const String &rhs) { String s(lhs); s.concat(rhs); return s; }
+    friend String operator + (const String &lhs, const char *rhs) { String s(lhs); s.concat(rhs); return s; }
+    friend String operator + (const String &lhs, char rhs) { String s(lhs); s.concat(rhs); return s; }
+    friend String operator + (const String &lhs, int rhs) { String s(lhs); s.concat(rhs); return s; }
+    friend String operator + (const String &lhs, long rhs) { String s(lhs); s.concat(rhs); return s; }
+    friend String operator + (const String &lhs, unsigned long rhs) { String s(lhs); s.concat(rhs); return s; }
+    friend String operator + (const String &lhs, double rhs) { String s(lhs); s.concat(rhs); return s; }
+
+    operator bool() const { return true; }
+    int compareTo(const String &s) const { return buffer.compare(s.buffer); }
+    unsigned char equals(const String &s) const { return buffer == s.buffer; }
+    unsigned char equals(const char *cstr) const { return buffer == (cstr ? cstr : ""); }
+    unsigned char operator == (const String &rhs) const { return equals(rhs); }
+    unsigned char operator == (const char *cstr) const { return equals(cstr); }
+    unsigned char operator != (const String &rhs) const { return !equals(rhs); }
+    unsigned char operator != (const char *cstr) const { return !equals(cstr); }
+    unsigned char operator <  (const String &rhs) const { return compareTo(rhs) < 0; }
+    unsigned char operator >  (const String &rhs) const { return compareTo(rhs) > 0; }
+    unsigned char equalsIgnoreCase(const String &s) const;
+    unsigned char startsWith(const String &prefix) const { return buffer.compare(0, prefix.buffer.size(), prefix.buffer) == 0; }
+    unsigned char endsWith(const String &suffix) const;
+
+    char charAt(unsigned int index) const { return index < buffer.size() ? buffer[index] : 0; }
+    void setCharAt(unsigned int index, char c) { if (index < buffer.size()) buffer[index] = c; }
+    char operator [] (unsigned int index) const { return charAt(index); }
+    char& operator [] (unsigned int index) { return buffer[index]; }
+    void getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index = 0) const;
+    void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const
+      { getBytes((unsigned char *)buf, bufsize, index); }
+    const char* c_str() const { return buffer.c_str(); }
+
+    int indexOf(char ch, unsigned int fromIndex = 0) const;
+    int indexOf(const String &str, unsigned int fromIndex = 0) const;
+    int lastIndexOf(char ch) const;
+    String substring(unsigned int beginIndex) const { return substring(beginIndex, length()); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    void replace(char find, char replace);
+    void replace(const String& find, const String& replace);
+    void remove(unsigned int index) { if (index < buffer.size()) buffer.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < buffer.size()) buffer.erase(index, count); }
+    void toLowerCase(void);
+    void toUpperCase(void);
+    void trim(void);
+
+    long toInt(void) const { return atol(buffer.c_str()); }
+    float toFloat(void) const { return (float) atof(buffer.c_str()); }
+    double toDouble(void) const { return atof(buffer.c_str()); }
+
+  private:
+    std::string buffer;
+};
+
+#endif
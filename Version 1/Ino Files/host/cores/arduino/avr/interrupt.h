@@ -0,0 +1,43 @@
+/*
+  avr/interrupt.h - interrupt vectors for the host core
+
+  ISR(vector) expands to a plain C function with the vector's name; the
+  core provides weak defaults so unused vectors still link, and the
+  simulator calls them when the matching peripheral fires.
+*/
+
+#ifndef _AVR_INTERRUPT_H_
+#define _AVR_INTERRUPT_H_
+
+void cli(void);
+void sei(void);
+
+#define ISR(vector, ...) extern "C" void vector(void)
+#define ISR_BLOCK
+#define ISR_NOBLOCK
+
+#define INT0_vect         __vector_int0
+#define INT1_vect         __vector_int1
+#define PCINT0_vect       __vector_pcint0
+#define PCINT1_vect       __vector_pcint1
+#define PCINT2_vect       __vector_pcint2
+#define TIMER1_CAPT_vect  __vector_timer1_capt
+#define TIMER1_COMPA_vect __vector_timer1_compa
+#define TIMER1_COMPB_vect __vector_timer1_compb
+#define TIMER1_OVF_vect   __vector_timer1_ovf
+#define TWI_vect          __vector_twi
+
+extern "C" {
+  void INT0_vect(void);
+  void INT1_vect(void);
+  void PCINT0_vect(void);
+  void PCINT1_vect(void);
+  void PCINT2_vect(void);
+  void TIMER1_CAPT_vect(void);
+  void TIMER1_COMPA_vect(void);
+  void TIMER1_COMPB_vect(void);
+  void TIMER1_OVF_vect(void);
+  void TWI_vect(void);
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+  avr/io.h - ATmega328P register stand-ins for the host core
+
+  Configuration registers are plain bytes the simulator inspects when it
+  dispatches interrupts (PCICR/PCMSKn) or clocks the bus (TWBR). Input
+  port registers are read through the simulated pin model, TCNT1 through
+  the simulated clock, and OCR1A arms a compare interrupt.
+*/
+
+#ifndef _AVR_IO_H_
+#define _AVR_IO_H_
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+#define _SFR_BYTE(sfr) (sfr)
+
+// pin change interrupts
+extern volatile uint8_t PCICR;
+extern volatile uint8_t PCIFR;
+extern volatile uint8_t PCMSK0;
+extern volatile uint8_t PCMSK1;
+extern volatile uint8_t PCMSK2;
+
+#define PCIE0 0
+#define PCIE1 1
+#define PCIE2 2
+#define PCIF0 0
+#define PCIF1 1
+#define PCIF2 2
+
+// two wire interface
+extern volatile uint8_t TWBR;
+extern volatile uint8_t TWSR;
+extern volatile uint8_t TWCR;
+extern volatile uint8_t TWDR;
+extern volatile uint8_t TWAR;
+
+// registers are macros on the AVR, libraries test them with #ifdef TWBR
+#define TWBR TWBR
+
+#define TWPS0 0
+#define TWPS1 1
+
+// timer 1, counting from the simulated clock at the rate set by the CS1x
+// bits of TCCR1B; of the waveform modes only normal mode is modelled, with
+// the compare A interrupt (TIMSK1 OCIE1A) firing as TCNT1 reaches OCR1A
+extern volatile uint8_t TCCR1A;
+extern volatile uint8_t TCCR1B;
+extern volatile uint8_t TIMSK1;
+extern volatile uint8_t TIFR1;
+
+struct SimTimer1Counter
+{
+  operator uint16_t() const;
+  SimTimer1Counter& operator=(uint16_t value);
+};
+extern SimTimer1Counter TCNT1;
+
+struct SimTimer1Compare
+{
+  operator uint16_t() const;
+  SimTimer1Compare& operator=(uint16_t value);
+};
+extern SimTimer1Compare OCR1A;
+
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define OCIE1A 1
+#define OCF1A 1
+
+// input ports, sampled from the simulated pins
+uint8_t sim_readPort(uint8_t port);
+#define PINB (sim_readPort(1))
+#define PINC (sim_readPort(2))
+#define PIND (sim_readPort(3))
+
+// status register, only the global interrupt flag is modelled
+struct SimStatusRegister
+{
+  operator uint8_t() const;
+  SimStatusRegister& operator=(uint8_t value);
+};
+extern SimStatusRegister SREG;
+
+#define SREG_I 7
+
+#endif
@@ -0,0 +1,27 @@
+/*
+  main.cpp - entry point for host builds of a sketch
+
+  Runs setup() once and loop() until the simulator says stop (--loops,
+  --seconds or Ctrl-C), timing every iteration. See sim/Sim.h for the
+  command line.
+*/
+
+#include "Arduino.h"
+#include "Sim.h"
+
+int main(int argc, char **argv)
+{
+  sim::begin(argc, argv);
+  init();
+
+  setup();
+
+  while (sim::running()) {
+    sim::loopBegin();
+    loop();
+    sim::loopEnd();
+  }
+
+  sim::end();
+  return 0;
+}
@@ -0,0 +1,73 @@
+/*
+  util/crc16.h - avr-libc CRC helpers for the host core
+
+  The C equivalents given in the avr-libc documentation for the inline
+  assembler versions; same polynomials, same results.
+*/
+
+#ifndef _UTIL_CRC16_H_
+#define _UTIL_CRC16_H_
+
+#include <stdint.h>
+
+// CRC-16 (0xA001), used by Modbus and USB
+static inline uint16_t _crc16_update(uint16_t crc, uint8_t a)
+{
+  crc ^= a;
+  for (uint8_t i = 0; i < 8; ++i)
+  {
+    if (crc & 1) crc = (crc >> 1) ^ 0xA001;
+    else crc = (crc >> 1);
+  }
+  return crc;
+}
+
+// CRC-CCITT (0x1021), XMODEM flavour
+static inline uint16_t _crc_xmodem_update(uint16_t crc, uint8_t data)
+{
+  crc = crc ^ ((uint16_t)data << 8);
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    if (crc & 0x8000) crc = (crc << 1) ^ 0x1021;
+    else crc <<= 1;
+  }
+  return crc;
+}
+
+// CRC-CCITT (0x8408), reflected, used by PPP and IrDA
+static inline uint16_t _crc_ccitt_update(uint16_t crc, uint8_t data)
+{
+  data ^= (uint8_t)crc;
+  data ^= data << 4;
+  return ((((uint16_t)data << 8) | (crc >> 8)) ^ (uint8_t)(data >> 4) ^ ((uint16_t)data << 3));
+}
+
+// Dallas/Maxim iButton 8 bit CRC (0x8C)
+static inline uint8_t _crc_ibutton_update(uint8_t crc, uint8_t data)
+{
+  crc = crc ^ data;
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    if (crc & 0x01) crc = (crc >> 1) ^ 0x8C;
+    else crc >>= 1;
+  }
+  return crc;
+}
+
+// 8 bit CRC-CCITT (0x07), as used by ATM HEC and SMBus
+static inline uint8_t _crc8_ccitt_update(uint8_t inCrc, uint8_t inData)
+{
+  uint8_t data = inCrc ^ inData;
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    if ((data & 0x80) != 0)
+    {
+      data <<= 1;
+      data ^= 0x07;
+    }
+    else data <<= 1;
+  }
+  return data;
+}
+
+#endif
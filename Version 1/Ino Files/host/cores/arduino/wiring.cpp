@@ -0,0 +1,347 @@
+/*
+  wiring.cpp - time, pins and interrupts for the host core
+
+  Thin layer over the simulator: the API keeps the Arduino semantics and
+  the simulator decides what the hardware does.
+*/
+
+#include <atomic>
+
+#include "Arduino.h"
+#include "Sim.h"
+
+// Registers ///////////////////////////////////////////////////////////////////
+
+volatile uint8_t PCICR;
+volatile uint8_t PCIFR;
+volatile uint8_t PCMSK0;
+volatile uint8_t PCMSK1;
+volatile uint8_t PCMSK2;
+
+volatile uint8_t TWBR;
+volatile uint8_t TWSR;
+volatile uint8_t TWCR;
+volatile uint8_t TWDR;
+volatile uint8_t TWAR;
+
+volatile uint8_t TCCR1A;
+volatile uint8_t TCCR1B;
+volatile uint8_t TIMSK1;
+volatile uint8_t TIFR1;
+
+SimTimer1Counter TCNT1;
+SimTimer1Compare OCR1A;
+
+SimStatusRegister SREG;
+
+SimStatusRegister::operator uint8_t() const
+{
+  return sim::interruptsEnabled() ? _BV(SREG_I) : 0;
+}
+
+SimStatusRegister& SimStatusRegister::operator=(uint8_t value)
+{
+  if (value & _BV(SREG_I)) sim::enableInterrupts();
+  else sim::disableInterrupts();
+  return *this;
+}
+
+// Timer 1 ////////////////////////////////////////////////////////////////////
+
+static uint16_t timer1Divider()
+{
+  static const uint16_t prescaler[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+  return prescaler[TCCR1B & 7];
+}
+
+// timer 1 ticks since boot at the current prescaler, 0 when stopped
+static uint64_t timer1Ticks()
+{
+  uint16_t divider = timer1Divider();
+  return divider ? sim::now() * (F_CPU / 1000000UL) / divider : 0;
+}
+
+static uint16_t timer1Offset;
+
+// raises TIMER1_COMPA_vect when TCNT1 reaches OCR1A, every 65536 ticks
+// if OCR1A is left alone
+class Timer1Compare : public sim::Peripheral
+{
+public:
+  Timer1Compare() : compare(0), due(UINT64_MAX), attached(false) {}
+
+  // after a write to OCR1A or TCNT1
+  void arm()
+  {
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    if (!attached)
+    {
+      attached = true;
+      sim::attach(this);
+    }
+    uint16_t divider = timer1Divider();
+    if (!divider)
+    {
+      due = UINT64_MAX;
+      return;
+    }
+    uint64_t ticks = timer1Ticks();
+    uint32_t delta = (uint16_t)(compare - (uint16_t)(ticks - timer1Offset));
+    if (delta == 0) delta = 65536;
+    target = ticks + delta;
+    due = dueTime(target);
+  }
+
+  void tick(uint64_t t)
+  {
+    {
+      std::lock_guard<std::recursive_mutex> guard(lock);
+      if (t < due) return;
+      // the next match if the ISR leaves OCR1A alone
+      target += 65536;
+      due = dueTime(target);
+    }
+    if (TIMSK1 & _BV(OCIE1A)) sim::raise(TIMER1_COMPA_vect);
+  }
+
+  uint64_t next() const
+  {
+    return due;
+  }
+
+  uint16_t compare;
+
+private:
+  // first whole us at or after the tick
+  static uint64_t dueTime(uint64_t ticks)
+  {
+    uint64_t perUs = F_CPU / 1000000UL;
+    uint16_t divider = timer1Divider();
+    return (ticks * divider + perUs - 1) / perUs;
+  }
+
+  std::recursive_mutex lock;
+  uint64_t target;
+  std::atomic<uint64_t> due;
+  bool attached;
+};
+
+static Timer1Compare timer1Compare;
+
+SimTimer1Counter::operator uint16_t() const
+{
+  return (uint16_t)(timer1Ticks() - timer1Offset);
+}
+
+SimTimer1Counter& SimTimer1Counter::operator=(uint16_t value)
+{
+  timer1Offset = (uint16_t)(timer1Ticks() - value);
+  timer1Compare.arm();
+  return *this;
+}
+
+SimTimer1Compare::operator uint16_t() const
+{
+  return timer1Compare.compare;
+}
+
+SimTimer1Compare& SimTimer1Compare::operator=(uint16_t value)
+{
+  timer1Compare.compare = value;
+  timer1Compare.arm();
+  return *this;
+}
+
+// Ports ///////////////////////////////////////////////////////////////////////
+
+uint8_t sim_readPort(uint8_t port)
+{
+  return sim::port(port);
+}
+
+void cli(void)
+{
+  sim::disableInterrupts();
+}
+
+void sei(void)
+{
+  sim::enableInterrupts();
+}
+
+// Unused vectors //////////////////////////////////////////////////////////////
+
+#define WEAK_VECTOR(vector) extern "C" void __attribute__((weak)) vector(void) {}
+
+WEAK_VECTOR(INT0_vect)
+WEAK_VECTOR(INT1_vect)
+WEAK_VECTOR(PCINT0_vect)
+WEAK_VECTOR(PCINT1_vect)
+WEAK_VECTOR(PCINT2_vect)
+WEAK_VECTOR(TIMER1_CAPT_vect)
+WEAK_VECTOR(TIMER1_COMPA_vect)
+WEAK_VECTOR(TIMER1_COMPB_vect)
+WEAK_VECTOR(TIMER1_OVF_vect)
+WEAK_VECTOR(TWI_vect)
+
+// Time ////////////////////////////////////////////////////////////////////////
+
+static void charge()
+{
+  // in virtual time a polling loop must still see the clock move
+  if (!sim::realtime() && !sim::inInterrupt()) sim::waitUntil(sim::now() + 4);
+}
+
+uint32_t micros(void)
+{
+  charge();
+  // timer0 ticks every 4 us on a 16 MHz board
+  return (uint32_t)(sim::now() & ~3ULL);
+}
+
+uint32_t millis(void)
+{
+  charge();
+  return (uint32_t)(sim::now() / 1000);
+}
+
+void delay(uint32_t ms)
+{
+  sim::wait(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  sim::wait(us);
+}
+
+void yield(void)
+{
+}
+
+void init(void)
+{
+}
+
+// Pins ////////////////////////////////////////////////////////////////////////
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (mode == INPUT_PULLUP) sim::drive(pin, HIGH);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  sim::output(pin, val);
+}
+
+int digitalRead(uint8_t pin)
+{
+  return sim::level(pin);
+}
+
+int analogRead(uint8_t pin)
+{
+  (void)pin;
+  return 0;
+}
+
+void analogReference(uint8_t mode)
+{
+  (void)mode;
+}
+
+void analogWrite(uint8_t pin, int val)
+{
+  sim::output(pin, val >= 128);
+}
+
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeout)
+{
+  uint32_t start = micros();
+  while (digitalRead(pin) == state) if (micros() - start >= timeout) return 0;
+  while (digitalRead(pin) != state) if (micros() - start >= timeout) return 0;
+  uint32_t edge = micros();
+  while (digitalRead(pin) == state) if (micros() - start >= timeout) return 0;
+  return micros() - edge;
+}
+
+void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val)
+{
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    if (bitOrder == LSBFIRST) digitalWrite(dataPin, !!(val & (1 << i)));
+    else digitalWrite(dataPin, !!(val & (1 << (7 - i))));
+    digitalWrite(clockPin, HIGH);
+    digitalWrite(clockPin, LOW);
+  }
+}
+
+uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder)
+{
+  uint8_t value = 0;
+  for (uint8_t i = 0; i < 8; ++i)
+  {
+    digitalWrite(clockPin, HIGH);
+    if (bitOrder == LSBFIRST) value |= digitalRead(dataPin) << i;
+    else value |= digitalRead(dataPin) << (7 - i);
+    digitalWrite(clockPin, LOW);
+  }
+  return value;
+}
+
+void tone(uint8_t _pin, unsigned int frequency, unsigned long duration)
+{
+  (void)_pin; (void)frequency; (void)duration;
+}
+
+void noTone(uint8_t _pin)
+{
+  (void)_pin;
+}
+
+// Interrupts //////////////////////////////////////////////////////////////////
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode)
+{
+  sim::attachExternal(interruptNum, userFunc, mode);
+}
+
+void detachInterrupt(uint8_t interruptNum)
+{
+  sim::detachExternal(interruptNum);
+}
+
+// Math ////////////////////////////////////////////////////////////////////////
+
+long random(long howbig)
+{
+  if (howbig == 0) return 0;
+  return ::random() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+  if (seed != 0) srandom(seed);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+uint16_t makeWord(uint16_t w)
+{
+  return w;
+}
+
+uint16_t makeWord(byte h, byte l)
+{
+  return (h << 8) | l;
+}
@@ -0,0 +1,81 @@
+/*
+  Servo.cpp - Interrupt driven Servo library for Arduino, host version
+*/
+
+#include "Arduino.h"
+#include "Servo.h"
+#include "Sim.h"
+
+static uint8_t ServoCount = 0;       // the total number of attached servos
+
+Servo::Servo()
+{
+  if (ServoCount < MAX_SERVOS) {
+    this->servoIndex = ServoCount++;
+  } else {
+    this->servoIndex = INVALID_SERVO;
+  }
+  this->pin = -1;
+  this->min = MIN_PULSE_WIDTH;
+  this->max = MAX_PULSE_WIDTH;
+  this->pulse = DEFAULT_PULSE_WIDTH;
+}
+
+uint8_t Servo::attach(int pin)
+{
+  return this->attach(pin, MIN_PULSE_WIDTH, MAX_PULSE_WIDTH);
+}
+
+uint8_t Servo::attach(int pin, int min, int max)
+{
+  if (this->servoIndex < MAX_SERVOS) {
+    pinMode(pin, OUTPUT);
+    this->pin = pin;
+    this->min = min;
+    this->max = max;
+    sim::servoPulse(pin, this->pulse);
+  }
+  return this->servoIndex;
+}
+
+void Servo::detach()
+{
+  if (this->pin >= 0) sim::servoPulse(this->pin, 0);
+  this->pin = -1;
+}
+
+void Servo::write(int value)
+{
+  if (value < MIN_PULSE_WIDTH)
+  {  // treat values less than 544 as angles in degrees (valid values in microseconds are handled as microseconds)
+    if (value < 0) value = 0;
+    if (value > 180) value = 180;
+    value = map(value, 0, 180, this->min, this->max);
+  }
+  this->writeMicroseconds(value);
+}
+
+void Servo::writeMicroseconds(int value)
+{
+  if (value < this->min)          // ensure pulse width is valid
+    value = this->min;
+  else if (value > this->max)
+    value = this->max;
+  this->pulse = value;
+  if (this->pin >= 0) sim::servoPulse(this->pin, value);
+}
+
+int Servo::read()
+{
+  return map(this->readMicroseconds() + 1, this->min, this->max, 0, 180);
+}
+
+int Servo::readMicroseconds()
+{
+  return this->pin >= 0 ? this->pulse : 0;
+}
+
+bool Servo::attached()
+{
+  return this->pin >= 0;
+}
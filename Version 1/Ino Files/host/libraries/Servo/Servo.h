@@ -0,0 +1,44 @@
+/*
+  Servo.h - Interrupt driven Servo library for Arduino, host version
+
+  Same interface as the AVR library. Instead of generating pulses from
+  timer 1, the commanded pulse width of each attached pin is handed to
+  the simulator, where tools can read it back with sim::servoPulse().
+*/
+
+#ifndef Servo_h
+#define Servo_h
+
+#include <inttypes.h>
+
+#define Servo_VERSION           2     // software version of this library
+
+#define MIN_PULSE_WIDTH       544     // the shortest pulse sent to a servo
+#define MAX_PULSE_WIDTH      2400     // the longest pulse sent to a servo
+#define DEFAULT_PULSE_WIDTH  1500     // default pulse width when servo is attached
+#define REFRESH_INTERVAL    20000     // minumim time to refresh servos in microseconds
+
+#define MAX_SERVOS             12
+#define INVALID_SERVO         255     // flag indicating an invalid servo index
+
+class Servo
+{
+public:
+  Servo();
+  uint8_t attach(int pin);           // attach the given pin to the next free channel, sets pinMode, returns channel number or 0 if failure
+  uint8_t attach(int pin, int min, int max); // as above but also sets min and max values for writes.
+  void detach();
+  void write(int value);             // if value is < 200 its treated as an angle, otherwise as pulse width in microseconds
+  void writeMicroseconds(int value); // Write pulse width in microseconds
+  int read();                        // returns current pulse width as an angle between 0 and 180 degrees
+  int readMicroseconds();            // returns current pulse width in microseconds for this servo (was read_us() in first release)
+  bool attached();                   // return true if this servo is attached, otherwise false
+private:
+  uint8_t servoIndex;                // index into the channel data for this servo
+  int8_t pin;
+  int min;                           // minimum pulse width in microseconds
+  int max;                           // maximum pulse width in microseconds
+  int pulse;                         // last commanded pulse width
+};
+
+#endif
@@ -0,0 +1,75 @@
+//
+//    FILE: Replay.h
+// PURPOSE: shared bits of the offline replay tools
+//
+// The tools in this directory have their own main(). They link a
+// sketch's object file, without the core's main(), and call into the
+// sketch directly: no setup(), no loop(), no bus, just the estimator
+// fed from a log (see sim/ImuLog.h) as fast as the host runs it.
+//
+
+#ifndef Replay_h
+#define Replay_h
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#include "Sim.h"
+
+namespace replay
+{
+
+// sim::begin() with a virtual clock and no simulated devices, so the
+// sketch's globals and Serial work but nothing runs on its own
+inline void begin(int argc, char **argv)
+{
+  static char virtualFlag[] = "--virtual";
+  static char bareFlag[] = "--bare";
+  std::vector<char *> args;
+  args.push_back(argv[0]);
+  args.push_back(virtualFlag);
+  args.push_back(bareFlag);
+  for (int i = 1; i < argc; i++) args.push_back(argv[i]);
+  args.push_back(NULL);
+  sim::begin((int)args.size() - 1, &args[0]);
+}
+
+inline double seconds()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// records, the flight time they cover and how long the replay took
+class Timing
+{
+public:
+  Timing() : _records(0), _flightMicros(0), _last(0), _start(seconds()) {}
+
+  void record(uint32_t time)
+  {
+    if (_records++) _flightMicros += (uint32_t)(time - _last);
+    _last = time;
+  }
+
+  void report(const char *what)
+  {
+    double wall = seconds() - _start;
+    double flight = _flightMicros / 1e6;
+    fprintf(stderr, "%s: %llu records, %.1f s of flight in %.3f s (%.0fx real time), %.1f ns per record\n",
+            what, (unsigned long long)_records, flight, wall,
+            wall > 0 ? flight / wall : 0, _records ? wall * 1e9 / _records : 0);
+  }
+
+private:
+  uint64_t _records;
+  uint64_t _flightMicros;
+  uint32_t _last;
+  double _start;
+};
+
+} // namespace replay
+
+#endif
+// END OF FILE
@@ -0,0 +1,252 @@
+//
+//    FILE: fdr_extract.cpp
+// PURPOSE: decode a FlightRecorder memory dump
+//
+//   build/fdr_extract --dump dump.txt --csv flight.csv --imu flight.imu
+//
+// Reads what examples/flightRecorderDump printed (hex lines), or a raw
+// image of the memory such as the simulator's --memory-image, puts the
+// blocks back in the order they were written and splits them into
+// flights at each begin(). Blocks with a bad crc, torn by a power cut
+// or never written, are skipped.
+//
+// One CSV line per frame: flight, time (us), then
+//   imu,ax,ay,az,gx,gy,gz    raw MPU-6050 counts
+//   rc,c1,c2,c3,c4           pulse widths in us
+// The IMU samples of one flight can also be written as a raw log
+// (sim/ImuLog.h, temperature 0) for Arduino_replay.
+//
+// Options:
+//   --dump PATH      hex dump or binary image, required
+//   --csv PATH       frames, default stdout, "none" for no CSV
+//   --imu PATH       raw IMU log of one flight
+//   --flight N       flight for --imu, 1 = oldest in the memory, default the last
+//
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "FlightRecorder.h"
+#include "ImuLog.h"
+#include "Replay.h"
+
+#include <util/crc16.h>
+
+static const uint32_t BLOCK = FLIGHT_RECORDER_BLOCK_SIZE;
+
+struct Frame
+{
+  unsigned flight;
+  uint32_t time;
+  uint8_t type;
+  const uint8_t *payload;
+};
+
+// hex lines "AAAAAA HHHH..." if there are any, the raw file otherwise
+static bool readDump(const char *path, std::vector<uint8_t> &image)
+{
+  FILE *f = fopen(path, "rb");
+  if (!f)
+  {
+    perror(path);
+    return false;
+  }
+  std::vector<uint8_t> raw;
+  uint8_t chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) raw.insert(raw.end(), chunk, chunk + n);
+  fclose(f);
+
+  bool hex = false;
+  raw.push_back('\n');
+  for (size_t start = 0, end; start < raw.size(); start = end + 1)
+  {
+    for (end = start; raw[end] != '\n'; end++);
+    const char *line = (const char *)&raw[start];
+    size_t length = end - start;
+    while (length > 0 && isspace((unsigned char)line[length - 1])) length--;
+    if (length < 8 || line[6] != ' ') continue;
+    bool ok = (length - 7) % 2 == 0;
+    for (size_t i = 0; ok && i < length; i++) ok = i == 6 || isxdigit((unsigned char)line[i]);
+    if (!ok) continue;
+
+    hex = true;
+    char field[7] = { 0 };
+    memcpy(field, line, 6);
+    uint32_t address = strtoul(field, NULL, 16);
+    size_t bytes = (length - 7) / 2;
+    if (image.size() < address + bytes) image.resize(address + bytes, 0xFF);
+    for (size_t i = 0; i < bytes; i++)
+    {
+      char byte[3] = { line[7 + 2 * i], line[8 + 2 * i], 0 };
+      image[address + i] = strtoul(byte, NULL, 16);
+    }
+  }
+  if (!hex)
+  {
+    raw.pop_back();
+    image.swap(raw);
+  }
+  return true;
+}
+
+static uint16_t sequence(const uint8_t *block)
+{
+  return block[0] | (block[1] << 8);
+}
+
+static bool valid(const uint8_t *block)
+{
+  uint8_t crc = 0;
+  for (uint32_t i = 0; i < BLOCK - 1; i++) crc = _crc8_ccitt_update(crc, block[i]);
+  return crc == block[BLOCK - 1] && block[FLIGHT_RECORDER_HEADER_SIZE] != FLIGHT_RECORDER_END;
+}
+
+static uint8_t payloadSize(uint8_t type)
+{
+  switch (type)
+  {
+    case FLIGHT_RECORDER_START: return 0;
+    case FLIGHT_RECORDER_IMU:   return FLIGHT_RECORDER_IMU_SIZE;
+    case FLIGHT_RECORDER_RC:    return FLIGHT_RECORDER_RC_SIZE;
+    default:                    return 0xFF;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  replay::begin(argc, argv);
+
+  const char *dumpPath = sim::option("dump");
+  if (!dumpPath)
+  {
+    fprintf(stderr, "usage: %s --dump PATH [--csv PATH] [--imu PATH [--flight N]]\n", argv[0]);
+    return 2;
+  }
+  std::vector<uint8_t> image;
+  if (!readDump(dumpPath, image)) return 1;
+  uint32_t blocks = image.size() / BLOCK;
+  if (blocks < 2)
+  {
+    fprintf(stderr, "%s: %u bytes, not a recorder memory\n", dumpPath, (unsigned)image.size());
+    return 1;
+  }
+
+  // the newest block, found the way FlightRecorder::begin() does; the
+  // oldest is the one after it
+  uint32_t newest = 0;
+  for (uint32_t b = 1; b < blocks; b++)
+  {
+    if (sequence(&image[b * BLOCK]) != (uint16_t)(sequence(&image[newest * BLOCK]) + 1)) break;
+    newest = b;
+  }
+
+  std::vector<Frame> frames;
+  unsigned flight = 0;
+  uint32_t good = 0, bad = 0, broken = 0;
+  for (uint32_t i = 1; i <= blocks; i++)
+  {
+    const uint8_t *block = &image[(newest + i) % blocks * BLOCK];
+    if (!valid(block))
+    {
+      bad++;
+      continue;
+    }
+    good++;
+    uint32_t blockTime = block[2] | (block[3] << 8) | ((uint32_t)block[4] << 16) | ((uint32_t)block[5] << 24);
+    for (uint32_t at = FLIGHT_RECORDER_HEADER_SIZE; at < BLOCK - 1 && block[at] != FLIGHT_RECORDER_END; )
+    {
+      uint8_t size = payloadSize(block[at]);
+      if (size == 0xFF || at + FLIGHT_RECORDER_FRAME_HEADER + size > BLOCK - 1)
+      {
+        broken++;
+        break;
+      }
+      Frame frame;
+      frame.type = block[at];
+      frame.time = blockTime + (block[at + 1] | (block[at + 2] << 8));
+      frame.payload = block + at + FLIGHT_RECORDER_FRAME_HEADER;
+      if (frame.type == FLIGHT_RECORDER_START || flight == 0) flight++;
+      frame.flight = flight;
+      frames.push_back(frame);
+      at += FLIGHT_RECORDER_FRAME_HEADER + size;
+    }
+  }
+  fprintf(stderr, "%s: %u blocks of %u bytes, %u written, %u empty or bad, %u with a bad frame\n",
+          dumpPath, (unsigned)blocks, (unsigned)BLOCK, (unsigned)good, (unsigned)bad, (unsigned)broken);
+
+  // per flight summary
+  for (unsigned f = 1; f <= flight; f++)
+  {
+    uint32_t imu = 0, rc = 0, first = 0, last = 0;
+    bool any = false;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+      if (frames[i].flight != f) continue;
+      if (!any) first = frames[i].time;
+      any = true;
+      last = frames[i].time;
+      if (frames[i].type == FLIGHT_RECORDER_IMU) imu++;
+      if (frames[i].type == FLIGHT_RECORDER_RC) rc++;
+    }
+    fprintf(stderr, "  flight %u: %.2f s, %u imu, %u rc frames\n", f, (last - first) / 1e6, (unsigned)imu, (unsigned)rc);
+  }
+
+  const char *csvPath = sim::option("csv", "-");
+  if (strcmp(csvPath, "none") != 0)
+  {
+    FILE *csv = strcmp(csvPath, "-") == 0 ? stdout : fopen(csvPath, "w");
+    if (!csv)
+    {
+      perror(csvPath);
+      return 1;
+    }
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+      const Frame &frame = frames[i];
+      const uint8_t *p = frame.payload;
+      if (frame.type == FLIGHT_RECORDER_IMU)
+      {
+        fprintf(csv, "%u,%lu,imu", frame.flight, (unsigned long)frame.time);
+        for (uint8_t n = 0; n < 6; n++) fprintf(csv, ",%d", (int16_t)(p[2 * n] << 8 | p[2 * n + 1]));
+        fprintf(csv, "\n");
+      }
+      else if (frame.type == FLIGHT_RECORDER_RC)
+      {
+        fprintf(csv, "%u,%lu,rc", frame.flight, (unsigned long)frame.time);
+        for (uint8_t n = 0; n < FLIGHT_RECORDER_RC_CHANNELS; n++) fprintf(csv, ",%d", (int16_t)(p[2 * n] | p[2 * n + 1] << 8));
+        fprintf(csv, "\n");
+      }
+    }
+    if (csv != stdout) fclose(csv);
+  }
+
+  const char *imuPath = sim::option("imu");
+  if (imuPath)
+  {
+    unsigned wanted = atoi(sim::option("flight", "0"));
+    if (wanted == 0) wanted = flight;
+    sim::ImuLogWriter log;
+    if (!log.open(imuPath, sim::IMU_LOG_RAW)) return 1;
+    uint32_t records = 0;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+      const Frame &frame = frames[i];
+      if (frame.flight != wanted || frame.type != FLIGHT_RECORDER_IMU) continue;
+      // back to the 14 registers from ACCEL_XOUT_H, TEMP_OUT 0
+      uint8_t registers[14] = { 0 };
+      memcpy(registers, frame.payload, 6);
+      memcpy(registers + 8, frame.payload + 6, 6);
+      log.write(frame.time, registers);
+      records++;
+    }
+    log.close();
+    fprintf(stderr, "%s: flight %u, %u records\n", imuPath, wanted, (unsigned)records);
+  }
+  return 0;
+}
+
+// END OF FILE
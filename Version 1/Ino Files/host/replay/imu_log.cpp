@@ -0,0 +1,101 @@
+//
+//    FILE: imu_log.cpp
+// PURPOSE: write a synthetic IMU log from the simulated MPU-6050
+//
+//   build/imu_log --out wobble.imu --seconds 3600
+//   build/imu_log --out wobble_dmp.imu --kind dmp
+//
+// Stands in for a recorded flight until there is one: the simulator's
+// MPU-6050, with the same wobble and noise options as the board, is
+// sampled at --rate and every sample is logged with its time.
+//
+// Options:
+//   --out PATH             log to write, required
+//   --kind raw|dmp         14 byte register dumps (default) or 42 byte DMP packets
+//   --seconds S            length, default 60
+//   --rate HZ              sample rate, 1000 / n, default 250
+//   --imu-amplitude DEG, --imu-hz HZ, --imu-noise A,G   as for the board
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ImuLog.h"
+#include "Replay.h"
+#include "SimMPU6050.h"
+
+static void writeRegister(sim::SimMPU6050 &imu, uint8_t reg, uint8_t value)
+{
+  uint8_t data[2] = { reg, value };
+  imu.write(data, 2);
+}
+
+int main(int argc, char **argv)
+{
+  replay::begin(argc, argv);
+
+  const char *outPath = sim::option("out");
+  if (!outPath)
+  {
+    fprintf(stderr, "usage: %s --out PATH [--kind raw|dmp] [--seconds S] [--rate HZ]\n", argv[0]);
+    return 2;
+  }
+  uint8_t kind = strcmp(sim::option("kind", "raw"), "dmp") == 0 ? sim::IMU_LOG_DMP : sim::IMU_LOG_RAW;
+  double seconds = atof(sim::option("seconds", "60"));
+  unsigned rate = atoi(sim::option("rate", "250"));
+  if (rate == 0 || rate > 1000) rate = 250;
+
+  sim::Wobble wobble(atof(sim::option("imu-amplitude", "10")), atof(sim::option("imu-hz", "0.5")));
+  float accel = 0.01f, gyro = 0.1f;
+  sscanf(sim::option("imu-noise", "0.01,0.1"), "%f,%f", &accel, &gyro);
+  sim::SimMPU6050 imu;
+  imu.setMotion(&wobble);
+  imu.setNoise(accel, gyro);
+  sim::attach((sim::Peripheral *)&imu);
+
+  writeRegister(imu, 0x1A, 0x01);                 // CONFIG: DLPF on, 1 kHz
+  writeRegister(imu, 0x19, 1000 / rate - 1);      // SMPLRT_DIV
+  if (kind == sim::IMU_LOG_DMP) writeRegister(imu, 0x6A, 0xC0);   // USER_CTRL: DMP, FIFO
+  writeRegister(imu, 0x6B, 0x00);                 // PWR_MGMT_1: wake up, first sample now
+
+  sim::ImuLogWriter log;
+  if (!log.open(outPath, kind)) return 1;
+
+  uint32_t period = 1000UL * (1000 / rate);       // what SMPLRT_DIV gives
+  uint64_t end = (uint64_t)(seconds * 1e6);
+  uint64_t records = 0;
+  for (uint64_t t = sim::now(); t < end; t += period)
+  {
+    sim::waitUntil(t);
+    uint8_t data[IMU_LOG_MAX_PAYLOAD];
+    if (kind == sim::IMU_LOG_RAW)
+    {
+      uint8_t reg = 0x3B;                         // ACCEL_XOUT_H
+      imu.write(&reg, 1);
+      imu.read(data, 14);
+      log.write((uint32_t)t, data);
+      records++;
+    }
+    else
+    {
+      uint8_t reg = 0x72;                         // FIFO_COUNTH
+      uint8_t count[2];
+      imu.write(&reg, 1);
+      imu.read(count, 2);
+      for (uint16_t n = count[0] << 8 | count[1]; n >= 42; n -= 42)
+      {
+        reg = 0x74;                               // FIFO_R_W
+        imu.write(&reg, 1);
+        imu.read(data, 42);
+        log.write((uint32_t)t, data);
+        records++;
+      }
+    }
+  }
+  log.close();
+  fprintf(stderr, "%s: %llu records, %.1f s\n", outPath, (unsigned long long)records, seconds);
+  return 0;
+}
+
+// END OF FILE
@@ -0,0 +1,148 @@
+//
+//    FILE: pin_timing.cpp
+// PURPOSE: pulse widths and periods from a simulator pin trace
+//
+//   build/servoEngine --virtual --bare --seconds 3 --pin-trace servo.csv
+//   build/pin_timing --trace servo.csv --from 0.5 --to 1.5
+//
+// Reads the "us,pin,level" lines written by --pin-trace and prints, for
+// each pin, the high pulses that started in the window: how many, their
+// width and the period from one rising edge to the next (min, mean and
+// max, us). With --pulses PATH every pulse goes to a CSV as well.
+//
+// Options:
+//   --trace PATH     the pin trace, required
+//   --from S, --to S window in seconds, default the whole trace
+//   --pin N          one pin only
+//   --pulses PATH    start (us), pin, width (us), period (us) per pulse
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Replay.h"
+
+#define PINS 20
+
+// min, mean and max of a series
+class Spread
+{
+public:
+  Spread() : _count(0), _sum(0), _min(0), _max(0) {}
+
+  void add(uint64_t value)
+  {
+    if (_count == 0 || value < _min) _min = value;
+    if (_count == 0 || value > _max) _max = value;
+    _sum += value;
+    _count++;
+  }
+
+  void print() const
+  {
+    if (_count == 0) printf("%8s %8s %8s", "-", "-", "-");
+    else printf("%8llu %8.1f %8llu", (unsigned long long)_min, (double)_sum / _count, (unsigned long long)_max);
+  }
+
+private:
+  uint32_t _count;
+  uint64_t _sum;
+  uint64_t _min;
+  uint64_t _max;
+};
+
+struct Pin
+{
+  Pin() : high(false), rise(0), lastRise(0), pulses(0) {}
+
+  bool     high;
+  uint64_t rise;
+  uint64_t lastRise;
+  uint32_t pulses;
+  Spread   width;
+  Spread   period;
+};
+
+int main(int argc, char **argv)
+{
+  replay::begin(argc, argv);
+
+  const char *tracePath = sim::option("trace");
+  if (!tracePath)
+  {
+    fprintf(stderr, "usage: %s --trace PATH [--from S] [--to S] [--pin N] [--pulses PATH]\n", argv[0]);
+    return 1;
+  }
+  FILE *trace = fopen(tracePath, "r");
+  if (!trace)
+  {
+    perror(tracePath);
+    return 1;
+  }
+  FILE *pulses = NULL;
+  const char *pulsesPath = sim::option("pulses");
+  if (pulsesPath)
+  {
+    pulses = fopen(pulsesPath, "w");
+    if (!pulses)
+    {
+      perror(pulsesPath);
+      return 1;
+    }
+    fprintf(pulses, "start,pin,width,period\n");
+  }
+
+  uint64_t from = (uint64_t)(atof(sim::option("from", "0")) * 1e6);
+  const char *to = sim::option("to");
+  uint64_t until = to ? (uint64_t)(atof(to) * 1e6) : UINT64_MAX;
+  int only = atoi(sim::option("pin", "-1"));
+
+  Pin pins[PINS];
+  char line[64];
+  unsigned long long t;
+  unsigned pin, level;
+  while (fgets(line, sizeof(line), trace))
+  {
+    if (sscanf(line, "%llu,%u,%u", &t, &pin, &level) != 3 || pin >= PINS) continue;
+    if (only >= 0 && (int)pin != only) continue;
+    Pin &p = pins[pin];
+    if (level && !p.high)
+    {
+      p.high = true;
+      p.rise = t;
+    }
+    else if (!level && p.high)
+    {
+      p.high = false;
+      if (p.rise < from || p.rise >= until) continue;
+      uint64_t width = t - p.rise;
+      uint64_t period = p.pulses ? p.rise - p.lastRise : 0;
+      p.width.add(width);
+      if (p.pulses) p.period.add(period);
+      p.lastRise = p.rise;
+      p.pulses++;
+      if (pulses)
+      {
+        fprintf(pulses, "%llu,%u,%llu,%llu\n", (unsigned long long)p.rise, pin,
+                (unsigned long long)width, (unsigned long long)period);
+      }
+    }
+  }
+  fclose(trace);
+  if (pulses) fclose(pulses);
+
+  printf("pin  pulses   width min     mean      max  period min     mean      max\n");
+  for (unsigned n = 0; n < PINS; n++)
+  {
+    if (pins[n].pulses == 0) continue;
+    printf("%3u %7u    ", n, pins[n].pulses);
+    pins[n].width.print();
+    printf("    ");
+    pins[n].period.print();
+    printf("\n");
+  }
+  return 0;
+}
+
+// END OF FILE
@@ -0,0 +1,67 @@
+//
+//    FILE: replay_angles.cpp
+// PURPOSE: replay a raw IMU log through the attitude estimator of Arduino.ino
+//
+//   build/Arduino_replay --log flight.imu --out angles.csv
+//
+// Every record goes through the sketch's traite_mesure(), the part of
+// update_angles() after the bus read, with the recorded time. One line
+// per record is written: time (us), angle x and angle y (degrees), the
+// values update_angles() would have left in angles[]. Linked with
+// Arduino_virgule_fixe it replays the integer estimator instead.
+//
+// Options:
+//   --log PATH       raw log (sim/ImuLog.h), required
+//   --out PATH       angles, default stdout
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "ImuLog.h"
+#include "Replay.h"
+
+// from the sketch
+extern int angles[2];
+void traite_mesure(const byte * mesure, unsigned long date_mesure);
+
+int main(int argc, char **argv)
+{
+  replay::begin(argc, argv);
+
+  const char *logPath = sim::option("log");
+  if (!logPath)
+  {
+    fprintf(stderr, "usage: %s --log PATH [--out PATH]\n", argv[0]);
+    return 2;
+  }
+  sim::ImuLogReader log;
+  if (!log.open(logPath)) return 1;
+  if (log.kind() != sim::IMU_LOG_RAW)
+  {
+    fprintf(stderr, "%s: not a raw register log\n", logPath);
+    return 1;
+  }
+  const char *outPath = sim::option("out", "-");
+  FILE *out = strcmp(outPath, "-") == 0 ? stdout : fopen(outPath, "w");
+  if (!out)
+  {
+    perror(outPath);
+    return 1;
+  }
+
+  replay::Timing timing;
+  sim::ImuRecord record;
+  while (log.read(record))
+  {
+    traite_mesure(record.data, record.time);
+    timing.record(record.time);
+    fprintf(out, "%lu,%.2f,%.2f\n", (unsigned long)record.time, angles[0] / 100.0, angles[1] / 100.0);
+  }
+  if (out != stdout) fclose(out);
+  timing.report(argv[0]);
+  return 0;
+}
+
+// END OF FILE
@@ -0,0 +1,55 @@
+//
+//    FILE: replay_dmp.cpp
+// PURPOSE: replay a DMP packet log through the packet processing of Programme_Arduino.ino
+//
+//   build/Programme_Arduino_replay --log flight.imu --serial-out ypr.txt
+//
+// Every record goes through the sketch's processPacket(), the quaternion,
+// gravity and yaw/pitch/roll math it runs on each FIFO packet, and its
+// output goes where Serial goes.
+//
+// Options:
+//   --log PATH         DMP log (sim/ImuLog.h), required
+//   --serial-out PATH  what the sketch prints, default stdout
+//
+
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "ImuLog.h"
+#include "Replay.h"
+
+// from the sketch
+void processPacket(const uint8_t *packet);
+
+int main(int argc, char **argv)
+{
+  replay::begin(argc, argv);
+
+  const char *logPath = sim::option("log");
+  if (!logPath)
+  {
+    fprintf(stderr, "usage: %s --log PATH [--serial-out PATH]\n", argv[0]);
+    return 2;
+  }
+  sim::ImuLogReader log;
+  if (!log.open(logPath)) return 1;
+  if (log.kind() != sim::IMU_LOG_DMP)
+  {
+    fprintf(stderr, "%s: not a DMP packet log\n", logPath);
+    return 1;
+  }
+
+  replay::Timing timing;
+  sim::ImuRecord record;
+  while (log.read(record))
+  {
+    processPacket(record.data);
+    timing.record(record.time);
+  }
+  Serial.flush();
+  timing.report(argv[0]);
+  return 0;
+}
+
+// END OF FILE
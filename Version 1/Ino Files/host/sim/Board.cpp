@@ -0,0 +1,83 @@
+//
+//    FILE: Board.cpp
+// PURPOSE: the Eagle airframe as seen by the sketches
+//
+// Options:
+//   --no-imu                  no MPU6050 on the bus
+//   --imu-amplitude DEG       wobble amplitude, default 10
+//   --imu-hz HZ               wobble frequency, default 0.5
+//   --imu-noise A,G           accel (g) and gyro (deg/s) noise, default 0.01,0.1
+//   --no-rc                   no receiver on pins 8..11
+//   --rc A,B,C,D              receiver pulse widths in us, default 1500,1500,1000,1500
+//   --rc-loss FROM,TO         no receiver frames between these times, seconds
+//   --rc-glitch N             a 20 us noise pulse on each channel every N frames
+//   --fram KB                 FRAM on 0x50 (MB85RC256V is 32)
+//   --eeprom KB               EEPROM on 0x50 instead, 64 byte pages, 5 ms write cycle
+//   --memory-image PATH       contents of the FRAM / EEPROM, read at start if
+//                             it exists and written back at exit
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Sim.h"
+#include "SimMemory.h"
+#include "SimMPU6050.h"
+#include "SimReceiver.h"
+
+namespace sim
+{
+
+static SimMPU6050 imu(0x68, 2);
+static Wobble wobble(10, 0.5f);
+static SimReceiver receiver(8, 4);
+static SimMemory memory(0x50, 0);
+
+static void saveMemory()
+{
+  memory.save(option("memory-image"));
+}
+
+void board()
+{
+  if (!flag("no-imu"))
+  {
+    wobble = Wobble(atof(option("imu-amplitude", "10")), atof(option("imu-hz", "0.5")));
+    imu.setMotion(&wobble);
+    float accel = 0.01f, gyro = 0.1f;
+    sscanf(option("imu-noise", "0.01,0.1"), "%f,%f", &accel, &gyro);
+    imu.setNoise(accel, gyro);
+    attach((I2CDevice *)&imu);
+    attach((Peripheral *)&imu);
+  }
+
+  if (!flag("no-rc"))
+  {
+    unsigned w[4] = { 1500, 1500, 1000, 1500 };
+    sscanf(option("rc", "1500,1500,1000,1500"), "%u,%u,%u,%u", &w[0], &w[1], &w[2], &w[3]);
+    for (uint8_t i = 0; i < 4; i++) receiver.setWidth(i, w[i]);
+    double from = 0, to = 0;
+    if (option("rc-loss") && sscanf(option("rc-loss"), "%lf,%lf", &from, &to) == 2)
+    {
+      receiver.setOutage((uint64_t)(from * 1e6), (uint64_t)(to * 1e6));
+    }
+    receiver.setGlitches(atoi(option("rc-glitch", "0")));
+    attach(&receiver);
+  }
+
+  if (option("fram") || option("eeprom"))
+  {
+    if (option("fram")) memory.resize(atoi(option("fram")) * 1024, 0, 0);
+    else memory.resize(atoi(option("eeprom")) * 1024, 64, 5000);
+    if (option("memory-image"))
+    {
+      memory.load(option("memory-image"));
+      atexit(saveMemory);
+    }
+    attach((I2CDevice *)&memory);
+  }
+}
+
+} // namespace sim
+
+// END OF FILE
@@ -0,0 +1,98 @@
+//
+//    FILE: ImuLog.cpp
+// PURPOSE: binary log of MPU-6050 samples, for offline replay on the host
+//
+// See ImuLog.h for the format.
+//
+
+#include <string.h>
+
+#include "ImuLog.h"
+
+namespace sim
+{
+
+static const uint8_t magic[4] = { 'I', 'M', 'U', 'L' };
+
+uint8_t imuLogPayloadSize(uint8_t kind)
+{
+  switch (kind)
+  {
+    case IMU_LOG_RAW: return 14;
+    case IMU_LOG_DMP: return 42;
+    default:          return 0;
+  }
+}
+
+bool ImuLogReader::open(const char *path)
+{
+  close();
+  _file = fopen(path, "rb");
+  if (!_file)
+  {
+    perror(path);
+    return false;
+  }
+  uint8_t header[IMU_LOG_HEADER_SIZE];
+  if (fread(header, 1, sizeof(header), _file) != sizeof(header)
+      || memcmp(header, magic, sizeof(magic)) != 0
+      || header[4] != IMU_LOG_VERSION
+      || imuLogPayloadSize(header[5]) == 0
+      || header[6] != imuLogPayloadSize(header[5]))
+  {
+    fprintf(stderr, "%s: not an IMU log (version %d)\n", path, IMU_LOG_VERSION);
+    close();
+    return false;
+  }
+  _kind = header[5];
+  _size = header[6];
+  return true;
+}
+
+void ImuLogReader::close()
+{
+  if (_file) fclose(_file);
+  _file = NULL;
+}
+
+bool ImuLogReader::read(ImuRecord &record)
+{
+  if (!_file) return false;
+  uint8_t t[4];
+  if (fread(t, 1, 4, _file) != 4) return false;
+  if (fread(record.data, 1, _size, _file) != _size) return false;
+  record.time = t[0] | (t[1] << 8) | ((uint32_t)t[2] << 16) | ((uint32_t)t[3] << 24);
+  return true;
+}
+
+bool ImuLogWriter::open(const char *path, uint8_t kind)
+{
+  close();
+  _size = imuLogPayloadSize(kind);
+  if (_size == 0) return false;
+  _file = fopen(path, "wb");
+  if (!_file)
+  {
+    perror(path);
+    return false;
+  }
+  uint8_t header[IMU_LOG_HEADER_SIZE] = { magic[0], magic[1], magic[2], magic[3], IMU_LOG_VERSION, kind, _size, 0 };
+  return fwrite(header, 1, sizeof(header), _file) == sizeof(header);
+}
+
+void ImuLogWriter::close()
+{
+  if (_file) fclose(_file);
+  _file = NULL;
+}
+
+bool ImuLogWriter::write(uint32_t time, const uint8_t *data)
+{
+  if (!_file) return false;
+  uint8_t t[4] = { (uint8_t)time, (uint8_t)(time >> 8), (uint8_t)(time >> 16), (uint8_t)(time >> 24) };
+  return fwrite(t, 1, 4, _file) == 4 && fwrite(data, 1, _size, _file) == _size;
+}
+
+} // namespace sim
+
+// END OF FILE
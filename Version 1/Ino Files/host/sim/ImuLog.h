@@ -0,0 +1,84 @@
+//
+//    FILE: ImuLog.h
+// PURPOSE: binary log of MPU-6050 samples, for offline replay on the host
+//
+// A log is an 8 byte header followed by fixed size records:
+//
+//   header   'I' 'M' 'U' 'L', version (1), kind, payload size, 0
+//   record   uint32 time in us (little endian), payload
+//
+// kind IMU_LOG_RAW: the payload is the 14 bytes read from ACCEL_XOUT_H
+// (accel, temperature, gyro; big endian, as on the bus). kind
+// IMU_LOG_DMP: the payload is a 42 byte MotionApps 2.0 FIFO packet.
+// Times are those of the board that recorded the log, they may wrap.
+//
+
+#ifndef ImuLog_h
+#define ImuLog_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace sim
+{
+
+enum ImuLogKind
+{
+  IMU_LOG_RAW = 0,
+  IMU_LOG_DMP = 1
+};
+
+#define IMU_LOG_VERSION      1
+#define IMU_LOG_HEADER_SIZE  8
+#define IMU_LOG_MAX_PAYLOAD  42
+
+struct ImuRecord
+{
+  uint32_t time;
+  uint8_t data[IMU_LOG_MAX_PAYLOAD];
+};
+
+class ImuLogReader
+{
+public:
+  ImuLogReader() : _file(NULL), _kind(IMU_LOG_RAW), _size(0) {}
+  ~ImuLogReader() { close(); }
+
+  // false, with a message on stderr, if the file is not a log
+  bool open(const char *path);
+  void close();
+
+  // false at the end of the log
+  bool read(ImuRecord &record);
+
+  uint8_t kind() const { return _kind; }
+  uint8_t payloadSize() const { return _size; }
+
+private:
+  FILE *_file;
+  uint8_t _kind;
+  uint8_t _size;
+};
+
+class ImuLogWriter
+{
+public:
+  ImuLogWriter() : _file(NULL), _size(0) {}
+  ~ImuLogWriter() { close(); }
+
+  bool open(const char *path, uint8_t kind);
+  void close();
+  bool write(uint32_t time, const uint8_t *data);
+
+private:
+  FILE *_file;
+  uint8_t _size;
+};
+
+// payload size of a kind, 0 if unknown
+uint8_t imuLogPayloadSize(uint8_t kind);
+
+} // namespace sim
+
+#endif
+// END OF FILE
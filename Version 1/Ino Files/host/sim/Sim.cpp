@@ -0,0 +1,675 @@
+//
+//    FILE: Sim.cpp
+// PURPOSE: host simulator behind the simulated Arduino core
+//
+// See Sim.h for the model. Everything here runs on the sketch thread
+// unless noted; the interrupt thread only exists in real time mode.
+//
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Arduino.h"
+#include "Sim.h"
+
+namespace sim
+{
+
+// --- options ----------------------------------------------------------------
+
+static std::map<std::string, std::string> g_options;
+
+static void parseOptions(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    if (arg.compare(0, 2, "--") != 0) continue;
+    std::string name = arg.substr(2);
+    if (i + 1 < argc && std::string(argv[i + 1]).compare(0, 2, "--") != 0)
+    {
+      g_options[name] = argv[++i];
+    }
+    else
+    {
+      g_options[name] = "";
+    }
+  }
+}
+
+const char *option(const char *name, const char *fallback)
+{
+  std::map<std::string, std::string>::const_iterator it = g_options.find(name);
+  if (it == g_options.end()) return fallback;
+  return it->second.c_str();
+}
+
+bool flag(const char *name)
+{
+  return g_options.find(name) != g_options.end();
+}
+
+// --- clock ------------------------------------------------------------------
+
+typedef std::chrono::steady_clock host_clock;
+
+static bool g_realtime = true;
+static host_clock::time_point g_boot;
+static std::atomic<uint64_t> g_virtual(0);
+static uint64_t g_blockedNs = 0;           // sketch thread only
+static std::thread::id g_sketchThread;
+
+static std::vector<Peripheral *> g_peripherals;
+static std::mutex g_peripheralLock;
+
+static uint64_t hostNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(host_clock::now() - g_boot).count();
+}
+
+uint64_t now()
+{
+  if (g_realtime) return hostNs() / 1000;
+  return g_virtual.load();
+}
+
+bool realtime()
+{
+  return g_realtime;
+}
+
+static uint64_t nextEvent()
+{
+  std::lock_guard<std::mutex> guard(g_peripheralLock);
+  uint64_t next = UINT64_MAX;
+  for (size_t i = 0; i < g_peripherals.size(); i++)
+  {
+    uint64_t n = g_peripherals[i]->next();
+    if (n < next) next = n;
+  }
+  return next;
+}
+
+static thread_local bool t_ticking = false;
+
+static void tickAll(uint64_t t)
+{
+  t_ticking = true;
+  std::vector<Peripheral *> list;
+  {
+    std::lock_guard<std::mutex> guard(g_peripheralLock);
+    list = g_peripherals;
+  }
+  for (size_t i = 0; i < list.size(); i++) list[i]->tick(t);
+  t_ticking = false;
+}
+
+void waitUntil(uint64_t t)
+{
+  uint64_t start = hostNs();
+  if (g_realtime)
+  {
+    for (;;)
+    {
+      uint64_t n = now();
+      if (n >= t) break;
+      if (t - n > 2000) std::this_thread::sleep_for(std::chrono::microseconds(t - n - 1000));
+      else std::this_thread::yield();
+    }
+  }
+  else
+  {
+    // step from event to event so every edge is seen at its own time;
+    // an ISR reading the clock from inside a tick only moves it forward
+    for (;;)
+    {
+      if (t_ticking)
+      {
+        if (g_virtual.load() < t) g_virtual.store(t);
+        break;
+      }
+      uint64_t next = nextEvent();
+      if (next > t)
+      {
+        if (g_virtual.load() < t) g_virtual.store(t);
+        break;
+      }
+      if (g_virtual.load() < next) g_virtual.store(next);
+      tickAll(g_virtual.load());
+    }
+  }
+  if (std::this_thread::get_id() == g_sketchThread) g_blockedNs += hostNs() - start;
+}
+
+void wait(uint32_t us)
+{
+  stats().waitMicros += us;
+  waitUntil(now() + us);
+}
+
+// --- interrupts -------------------------------------------------------------
+
+static std::mutex g_irq;
+static bool g_cli = false;                  // sketch thread holds g_irq
+static std::mutex g_pendingLock;
+static std::vector<void (*)(void)> g_pending;
+static thread_local bool t_inIsr = false;
+
+static bool blocked()
+{
+  return t_inIsr || (std::this_thread::get_id() == g_sketchThread && g_cli);
+}
+
+static void runIsr(void (*vector)(void))
+{
+  std::lock_guard<std::mutex> guard(g_irq);
+  t_inIsr = true;
+  vector();
+  t_inIsr = false;
+}
+
+// service requests that were raised while interrupts were off, oldest first
+static void runPending()
+{
+  while (!blocked())
+  {
+    void (*vector)(void);
+    {
+      std::lock_guard<std::mutex> guard(g_pendingLock);
+      if (g_pending.empty()) return;
+      vector = g_pending.front();
+      g_pending.erase(g_pending.begin());
+    }
+    runIsr(vector);
+  }
+}
+
+void disableInterrupts()
+{
+  if (t_inIsr || std::this_thread::get_id() != g_sketchThread) return;
+  if (!g_cli)
+  {
+    g_irq.lock();
+    g_cli = true;
+  }
+}
+
+void enableInterrupts()
+{
+  if (t_inIsr || std::this_thread::get_id() != g_sketchThread) return;
+  if (g_cli)
+  {
+    g_cli = false;
+    g_irq.unlock();
+  }
+  runPending();
+}
+
+bool interruptsEnabled()
+{
+  if (t_inIsr) return false;
+  if (std::this_thread::get_id() != g_sketchThread) return true;
+  return !g_cli;
+}
+
+bool inInterrupt()
+{
+  return t_inIsr;
+}
+
+void raise(void (*vector)(void))
+{
+  if (vector == NULL) return;
+  if (blocked())
+  {
+    // like the AVR flag bits: one pending request per vector
+    std::lock_guard<std::mutex> guard(g_pendingLock);
+    for (size_t i = 0; i < g_pending.size(); i++)
+    {
+      if (g_pending[i] == vector) return;
+    }
+    g_pending.push_back(vector);
+    return;
+  }
+  runIsr(vector);
+  runPending();
+}
+
+// --- pins -------------------------------------------------------------------
+
+#define SIM_PINS NUM_DIGITAL_PINS + 2
+
+static std::atomic<uint8_t> g_level[SIM_PINS];
+static void (*g_external[2])(void);
+static int g_externalMode[2];
+
+static void (*const g_pcint[3])(void) = { PCINT0_vect, PCINT1_vect, PCINT2_vect };
+
+void drive(uint8_t pin, uint8_t value)
+{
+  if (pin >= SIM_PINS) return;
+  value = value ? HIGH : LOW;
+  uint8_t old = g_level[pin].exchange(value);
+  if (old == value) return;
+
+  // pin change interrupts, grouped per port as on the ATmega328P
+  uint8_t group = digitalPinToPCICRbit(pin);
+  uint8_t mask = *digitalPinToPCMSK(pin);
+  if ((PCICR & _BV(group)) && (mask & _BV(digitalPinToPCMSKbit(pin))))
+  {
+    raise(g_pcint[group]);
+  }
+
+  // external interrupts INT0/INT1
+  int irq = digitalPinToInterrupt(pin);
+  if (irq >= 0 && g_external[irq])
+  {
+    int mode = g_externalMode[irq];
+    if (mode == CHANGE || (mode == RISING && value) || ((mode == FALLING || mode == LOW) && !value))
+    {
+      raise(g_external[irq]);
+    }
+  }
+}
+
+uint8_t level(uint8_t pin)
+{
+  if (pin >= SIM_PINS) return LOW;
+  return g_level[pin].load();
+}
+
+// --pin-trace: "us,pin,level" for every change of a driven pin
+static FILE *g_pinTrace = NULL;
+static std::mutex g_pinTraceLock;
+
+void output(uint8_t pin, uint8_t value)
+{
+  if (pin >= SIM_PINS) return;
+  uint8_t level = value ? HIGH : LOW;
+  if (g_level[pin].exchange(level) == level || !g_pinTrace) return;
+  std::lock_guard<std::mutex> guard(g_pinTraceLock);
+  fprintf(g_pinTrace, "%llu,%u,%u\n", (unsigned long long)now(), pin, level);
+}
+
+uint8_t port(uint8_t p)
+{
+  uint8_t first, count;
+  switch (p)
+  {
+    case 1: first = 8; count = 6; break;
+    case 2: first = 14; count = 6; break;
+    case 3: first = 0; count = 8; break;
+    default: return 0;
+  }
+  uint8_t value = 0;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    if (g_level[first + i].load()) value |= _BV(i);
+  }
+  return value;
+}
+
+void attachExternal(uint8_t irq, void (*fn)(void), int mode)
+{
+  if (irq > 1) return;
+  g_externalMode[irq] = mode;
+  g_external[irq] = fn;
+}
+
+void detachExternal(uint8_t irq)
+{
+  if (irq > 1) return;
+  g_external[irq] = NULL;
+}
+
+// --- serial -----------------------------------------------------------------
+
+static int g_serialIn = -1;
+static FILE *g_serialOut = NULL;
+static unsigned long g_baud = 0;
+static uint64_t g_txBusyUntil = 0;
+static uint8_t g_rx[SERIAL_RX_BUFFER_SIZE];
+static uint8_t g_rxHead = 0;
+static uint8_t g_rxCount = 0;
+
+static uint32_t byteTime()
+{
+  // start + 8 data + stop bits
+  return g_baud ? 10000000UL / g_baud : 0;
+}
+
+static uint32_t txQueued(uint64_t t)
+{
+  uint32_t bt = byteTime();
+  if (bt == 0 || g_txBusyUntil <= t) return 0;
+  return (g_txBusyUntil - t + bt - 1) / bt;
+}
+
+static void fillRx()
+{
+  if (g_serialIn < 0 || g_rxCount == SERIAL_RX_BUFFER_SIZE) return;
+  uint8_t buf[SERIAL_RX_BUFFER_SIZE];
+  ssize_t n = ::read(g_serialIn, buf, SERIAL_RX_BUFFER_SIZE - g_rxCount);
+  for (ssize_t i = 0; i < n; i++)
+  {
+    g_rx[(g_rxHead + g_rxCount) % SERIAL_RX_BUFFER_SIZE] = buf[i];
+    g_rxCount++;
+  }
+  if (n > 0) stats().serialRxBytes += n;
+}
+
+void serialBegin(unsigned long baud)
+{
+  g_baud = baud;
+}
+
+int serialAvailable()
+{
+  fillRx();
+  return g_rxCount;
+}
+
+int serialPeek()
+{
+  fillRx();
+  if (g_rxCount == 0) return -1;
+  return g_rx[g_rxHead];
+}
+
+int serialRead()
+{
+  fillRx();
+  if (g_rxCount == 0) return -1;
+  uint8_t c = g_rx[g_rxHead];
+  g_rxHead = (g_rxHead + 1) % SERIAL_RX_BUFFER_SIZE;
+  g_rxCount--;
+  return c;
+}
+
+int serialAvailableForWrite()
+{
+  return SERIAL_TX_BUFFER_SIZE - txQueued(now());
+}
+
+void serialFlush()
+{
+  uint64_t t = now();
+  if (g_txBusyUntil > t)
+  {
+    stats().waitMicros += g_txBusyUntil - t;
+    waitUntil(g_txBusyUntil);
+  }
+  if (g_serialOut) fflush(g_serialOut);
+}
+
+void serialWrite(uint8_t c)
+{
+  uint32_t bt = byteTime();
+  uint64_t t = now();
+  if (bt && txQueued(t) >= SERIAL_TX_BUFFER_SIZE)
+  {
+    // buffer full: block until the UART has shifted out one byte
+    uint64_t free = g_txBusyUntil - (uint64_t)(SERIAL_TX_BUFFER_SIZE - 1) * bt;
+    stats().waitMicros += free - t;
+    waitUntil(free);
+    t = now();
+  }
+  g_txBusyUntil = (g_txBusyUntil > t ? g_txBusyUntil : t) + bt;
+  if (g_serialOut) fputc(c, g_serialOut);
+  stats().serialTxBytes++;
+}
+
+// --- servo outputs ----------------------------------------------------------
+
+static std::atomic<uint16_t> g_servo[SIM_PINS];
+
+void servoPulse(uint8_t pin, uint16_t us)
+{
+  if (pin < SIM_PINS) g_servo[pin].store(us);
+}
+
+uint16_t servoPulse(uint8_t pin)
+{
+  return pin < SIM_PINS ? g_servo[pin].load() : 0;
+}
+
+// --- peripherals ------------------------------------------------------------
+
+static std::vector<I2CDevice *> g_devices;
+static std::recursive_mutex g_busLock;
+
+void attach(Peripheral *p)
+{
+  std::lock_guard<std::mutex> guard(g_peripheralLock);
+  g_peripherals.push_back(p);
+}
+
+void attach(I2CDevice *d)
+{
+  std::lock_guard<std::recursive_mutex> guard(g_busLock);
+  g_devices.push_back(d);
+}
+
+I2CDevice *device(uint8_t address)
+{
+  for (size_t i = 0; i < g_devices.size(); i++)
+  {
+    if (g_devices[i]->address() == address) return g_devices[i];
+  }
+  return NULL;
+}
+
+std::recursive_mutex &busLock()
+{
+  return g_busLock;
+}
+
+uint32_t busTime(uint16_t bytes)
+{
+  static const uint8_t prescaler[4] = { 1, 4, 16, 64 };
+  uint32_t divider = 16 + 2UL * TWBR * prescaler[TWSR & 3];
+  uint32_t scl = F_CPU / divider;
+  // 9 clocks per byte (8 data + ack), plus start and stop
+  return (uint32_t)(((uint64_t)bytes * 9 + 2) * 1000000UL / scl);
+}
+
+// --- interrupt thread -------------------------------------------------------
+
+static std::atomic<bool> g_stop(false);
+static std::thread g_thread;
+
+static void interruptThread()
+{
+  while (!g_stop.load())
+  {
+    uint64_t t = now();
+    tickAll(t);
+    uint64_t next = nextEvent();
+    uint64_t n = now();
+    if (next > n + 300)
+    {
+      uint64_t sleep = next - n - 200;
+      if (sleep > 2000) sleep = 2000;
+      std::this_thread::sleep_for(std::chrono::microseconds(sleep));
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+// --- statistics ---------------------------------------------------------------
+
+static Stats g_stats;
+
+Stats &stats()
+{
+  return g_stats;
+}
+
+struct LoopStats
+{
+  uint64_t count;
+  uint64_t wallMin, wallMax, wallSum;       // host ns per loop()
+  uint64_t workMin, workMax, workSum;       // host ns per loop() not blocked in the sim
+  uint64_t cycles;                          // host TSC ticks
+  uint64_t periodSum;                       // simulated us per loop()
+};
+
+static LoopStats g_loop = { 0, UINT64_MAX, 0, 0, UINT64_MAX, 0, 0, 0, 0 };
+static uint64_t g_loopStartNs, g_loopStartBlocked, g_loopStartSim, g_loopStartTsc;
+static uint64_t g_maxLoops = 0;
+static uint64_t g_maxMicros = 0;
+static volatile sig_atomic_t g_interrupted = 0;
+
+static uint64_t tsc()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static void onSignal(int)
+{
+  g_interrupted = 1;
+}
+
+// --- lifecycle ----------------------------------------------------------------
+
+void begin(int argc, char **argv)
+{
+  g_boot = host_clock::now();
+  g_sketchThread = std::this_thread::get_id();
+  parseOptions(argc, argv);
+
+  g_realtime = !flag("virtual");
+  g_maxLoops = strtoull(option("loops", "0"), NULL, 10);
+  g_maxMicros = (uint64_t)(atof(option("seconds", "0")) * 1000000.0);
+
+  const char *in = option("serial-in");
+  if (in)
+  {
+    g_serialIn = (strcmp(in, "-") == 0) ? dup(0) : open(in, O_RDONLY | O_NONBLOCK);
+    if (g_serialIn < 0) perror(in);
+    else fcntl(g_serialIn, F_SETFL, fcntl(g_serialIn, F_GETFL) | O_NONBLOCK);
+  }
+  const char *out = option("serial-out", "-");
+  g_serialOut = (strcmp(out, "-") == 0) ? stdout : fopen(out, "wb");
+  if (!g_serialOut) perror(out);
+  const char *trace = option("pin-trace");
+  if (trace)
+  {
+    g_pinTrace = fopen(trace, "w");
+    if (!g_pinTrace) perror(trace);
+  }
+
+  // sigaction rather than signal(): sketches are free to define a
+  // global called signal, and the linker would pick theirs
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = onSignal;
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+
+  if (!flag("bare")) board();
+
+  if (g_realtime) g_thread = std::thread(interruptThread);
+}
+
+bool running()
+{
+  if (g_interrupted) return false;
+  if (g_maxLoops && g_loop.count >= g_maxLoops) return false;
+  if (g_maxMicros && now() >= g_maxMicros) return false;
+  return true;
+}
+
+void loopBegin()
+{
+  g_loopStartBlocked = g_blockedNs;
+  g_loopStartSim = now();
+  g_loopStartTsc = tsc();
+  g_loopStartNs = hostNs();
+}
+
+void loopEnd()
+{
+  // a loop() that never looks at the clock still takes time on the
+  // board; without this, virtual time would stand still
+  if (!g_realtime) waitUntil(now() + 4);
+
+  uint64_t wall = hostNs() - g_loopStartNs;
+  uint64_t cycles = tsc() - g_loopStartTsc;
+  uint64_t blocked = g_blockedNs - g_loopStartBlocked;
+  uint64_t work = wall > blocked ? wall - blocked : 0;
+
+  g_loop.count++;
+  g_loop.wallSum += wall;
+  if (wall < g_loop.wallMin) g_loop.wallMin = wall;
+  if (wall > g_loop.wallMax) g_loop.wallMax = wall;
+  g_loop.workSum += work;
+  if (work < g_loop.workMin) g_loop.workMin = work;
+  if (work > g_loop.workMax) g_loop.workMax = work;
+  g_loop.cycles += cycles;
+  g_loop.periodSum += now() - g_loopStartSim;
+  g_stats.loops++;
+
+  if (g_serialOut) fflush(g_serialOut);
+}
+
+static void report()
+{
+  if (g_loop.count == 0)
+  {
+    fprintf(stderr, "sim: no loop() iterations\n");
+    return;
+  }
+  double n = (double)g_loop.count;
+  fprintf(stderr, "sim: %llu loops, %.3f s simulated (%s)\n",
+          (unsigned long long)g_loop.count, now() / 1e6, g_realtime ? "real time" : "virtual time");
+  fprintf(stderr, "  period   %10.1f us mean (simulated)\n", g_loop.periodSum / n);
+  fprintf(stderr, "  wall     %10.1f us min %10.1f us mean %10.1f us max\n",
+          g_loop.wallMin / 1e3, g_loop.wallSum / n / 1e3, g_loop.wallMax / 1e3);
+  fprintf(stderr, "  work     %10.1f us min %10.1f us mean %10.1f us max (not blocked in delay/bus/serial)\n",
+          g_loop.workMin / 1e3, g_loop.workSum / n / 1e3, g_loop.workMax / 1e3);
+  if (g_loop.cycles)
+    fprintf(stderr, "  cycles   %10.0f host TSC per loop\n", g_loop.cycles / n);
+  fprintf(stderr, "  waits    %10.1f us per loop in delay/bus/serial\n", g_stats.waitMicros / n);
+  fprintf(stderr, "  i2c      %10.2f transactions %10.1f bytes per loop\n",
+          g_stats.i2cTransactions / n, g_stats.i2cBytes / n);
+  fprintf(stderr, "  serial   %10.1f tx bytes %10.1f rx bytes per loop\n",
+          g_stats.serialTxBytes / n, g_stats.serialRxBytes / n);
+}
+
+void end()
+{
+  g_stop.store(true);
+  if (g_thread.joinable()) g_thread.join();
+  if (g_serialOut) fflush(g_serialOut);
+  {
+    std::lock_guard<std::mutex> guard(g_pinTraceLock);
+    if (g_pinTrace) fclose(g_pinTrace);
+    g_pinTrace = NULL;
+  }
+  if (!flag("quiet")) report();
+}
+
+} // namespace sim
+
+// END OF FILE
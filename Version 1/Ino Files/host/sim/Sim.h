@@ -0,0 +1,142 @@
+//
+//    FILE: Sim.h
+// PURPOSE: host simulator behind the simulated Arduino core
+//
+// The simulator owns everything the AVR would provide in hardware:
+// the clock, the pin levels, interrupt dispatch, the serial link and
+// the I2C bus. Sketches never include this header; simulated devices
+// and host-only tools (benchmarks, replay) do.
+//
+// Time
+//   By default the clock is real time: delay() sleeps, I2C transfers
+//   and serial output take as long as they would on the wire. With
+//   --virtual the clock only moves when the sketch waits, which makes
+//   runs deterministic and faster than real time; sketches that spin on
+//   a flag set by an ISR need real time.
+//
+// Interrupts
+//   In real time mode a background thread plays the role of the
+//   peripherals: it ticks every attached Peripheral and runs ISRs. An
+//   ISR never runs while the sketch thread holds cli().
+//
+
+#ifndef Sim_h
+#define Sim_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <mutex>
+
+namespace sim
+{
+
+// --- lifecycle, called by the core's main() --------------------------------
+void begin(int argc, char **argv);
+bool running();
+void loopBegin();
+void loopEnd();
+void end();
+
+// extra command line options, "--name value", for tools built on the sim
+const char *option(const char *name, const char *fallback = NULL);
+bool flag(const char *name);
+
+// --- clock ------------------------------------------------------------------
+uint64_t now();                     // microseconds since boot
+void wait(uint32_t us);             // block the calling thread for us
+void waitUntil(uint64_t t);         // block until now() >= t
+bool realtime();
+
+// --- interrupts -------------------------------------------------------------
+void disableInterrupts();
+void enableInterrupts();
+bool interruptsEnabled();
+bool inInterrupt();
+void raise(void (*vector)(void));   // run an ISR now, or when sei() allows
+
+// --- pins -------------------------------------------------------------------
+void drive(uint8_t pin, uint8_t level);   // external level on an input pin
+uint8_t level(uint8_t pin);
+void output(uint8_t pin, uint8_t level);  // the sketch drove a pin
+uint8_t port(uint8_t port);               // 1 = B, 2 = C, 3 = D
+void attachExternal(uint8_t irq, void (*fn)(void), int mode);
+void detachExternal(uint8_t irq);
+
+// --- serial -----------------------------------------------------------------
+void serialBegin(unsigned long baud);
+int serialAvailable();
+int serialPeek();
+int serialRead();
+int serialAvailableForWrite();
+void serialFlush();
+void serialWrite(uint8_t c);
+
+// --- servo outputs ----------------------------------------------------------
+void servoPulse(uint8_t pin, uint16_t us);
+uint16_t servoPulse(uint8_t pin);
+
+// --- peripherals ------------------------------------------------------------
+
+// Something that changes on its own as time passes, like an RC receiver
+// or a sensor's data-ready line. tick() is called with the current time,
+// from the interrupt thread in real time mode or from wait() in virtual
+// mode, and may drive() pins. next() tells the simulator when the
+// peripheral next has something to do, so edges land on time.
+class Peripheral
+{
+public:
+  virtual ~Peripheral() {}
+  virtual void tick(uint64_t t) = 0;
+  virtual uint64_t next() const = 0;
+};
+
+void attach(Peripheral *p);
+
+// attach the Eagle airframe: MPU6050 on 0x68 with INT on pin 2, a
+// four channel RC receiver on pins 8..11 and, when asked for, a FRAM
+// or EEPROM on 0x50 (see Board.cpp)
+void board();
+
+// A device on the I2C bus. write() receives the bytes of one master
+// write transaction and returns 0 on ACK; read() fills one master read
+// transaction and returns the number of bytes supplied.
+class I2CDevice
+{
+public:
+  explicit I2CDevice(uint8_t address) : _address(address) {}
+  virtual ~I2CDevice() {}
+  uint8_t address() const { return _address; }
+  virtual uint8_t write(const uint8_t *data, uint16_t length) = 0;
+  virtual uint16_t read(uint8_t *data, uint16_t length) = 0;
+private:
+  uint8_t _address;
+};
+
+void attach(I2CDevice *d);
+I2CDevice *device(uint8_t address);
+
+// Serialises bus traffic from the sketch against device state updates
+// made by the interrupt thread.
+std::recursive_mutex &busLock();
+
+// time one I2C transaction of n bytes (address byte included) occupies
+// the bus at the SCL rate set in TWBR
+uint32_t busTime(uint16_t bytes);
+
+// --- statistics ---------------------------------------------------------------
+struct Stats
+{
+  uint32_t loops;
+  uint32_t i2cTransactions;
+  uint32_t i2cBytes;
+  uint32_t serialTxBytes;
+  uint32_t serialRxBytes;
+  uint64_t waitMicros;        // time spent blocked in delay, bus or serial
+};
+
+Stats &stats();
+
+} // namespace sim
+
+#endif
+// END OF FILE
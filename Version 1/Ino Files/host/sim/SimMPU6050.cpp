@@ -0,0 +1,383 @@
+//
+//    FILE: SimMPU6050.cpp
+// PURPOSE: register level model of the InvenSense MPU-6050 for the host simulator
+//
+// Register numbers follow the RM-MPU-6000A-00 register map, as used by
+// libraries/MPU6050/MPU6050.h.
+//
+
+#include <math.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "SimMPU6050.h"
+
+namespace sim
+{
+
+enum
+{
+  SMPLRT_DIV   = 0x19,
+  CONFIG       = 0x1A,
+  GYRO_CONFIG  = 0x1B,
+  ACCEL_CONFIG = 0x1C,
+  INT_ENABLE   = 0x38,
+  INT_STATUS   = 0x3A,
+  ACCEL_XOUT_H = 0x3B,
+  USER_CTRL    = 0x6A,
+  PWR_MGMT_1   = 0x6B,
+  BANK_SEL     = 0x6D,
+  MEM_START    = 0x6E,
+  MEM_R_W      = 0x6F,
+  FIFO_COUNTH  = 0x72,
+  FIFO_COUNTL  = 0x73,
+  FIFO_R_W     = 0x74,
+  WHO_AM_I     = 0x75
+};
+
+#define FIFO_SIZE        1024
+#define DMP_PACKET_SIZE  42
+
+Attitude Wobble::at(uint64_t t)
+{
+  float w = 2 * M_PI * _hz;
+  float s = t / 1e6f;
+  Attitude a;
+  a.roll = _amplitude * sinf(w * s);
+  a.pitch = _amplitude * cosf(w * s);
+  a.yaw = 0;
+  a.rollRate = _amplitude * w * cosf(w * s);
+  a.pitchRate = -_amplitude * w * sinf(w * s);
+  a.yawRate = 0;
+  return a;
+}
+
+SimMPU6050::SimMPU6050(uint8_t address, uint8_t intPin)
+  : I2CDevice(address), _intPin(intPin), _seed(12345),
+    _accelNoise(0.01f), _gyroNoise(0.1f), _motion(NULL)
+{
+  reset();
+  memset(_memory, 0, sizeof(_memory));
+}
+
+void SimMPU6050::reset()
+{
+  memset(_regs, 0, sizeof(_regs));
+  _regs[PWR_MGMT_1] = 0x40;   // sleeping after power on / reset
+  _regs[WHO_AM_I] = 0x68;
+  _pointer = 0;
+  _bank = 0;
+  _memAddress = 0;
+  _fifo.clear();
+  _lastSample = 0;
+  _sampling = false;
+  _pendingPulses = 0;
+}
+
+bool SimMPU6050::awake() const
+{
+  return (_regs[PWR_MGMT_1] & 0x40) == 0;
+}
+
+uint32_t SimMPU6050::period() const
+{
+  uint8_t dlpf = _regs[CONFIG] & 0x07;
+  uint32_t gyroRate = (dlpf == 0 || dlpf == 7) ? 8000 : 1000;
+  return 1000000UL * (1 + _regs[SMPLRT_DIV]) / gyroRate;
+}
+
+float SimMPU6050::gaussian()
+{
+  // sum of uniforms, good enough for sensor noise and reproducible
+  float sum = 0;
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    _seed = _seed * 1103515245UL + 12345UL;
+    sum += ((_seed >> 8) & 0xFFFF) / 65535.0f;
+  }
+  return (sum - 2.0f) * 1.732f;
+}
+
+static int16_t clamp16(float v)
+{
+  if (v > 32767) return 32767;
+  if (v < -32768) return -32768;
+  return (int16_t)lroundf(v);
+}
+
+static void put16(uint8_t *p, int16_t v)
+{
+  p[0] = (uint8_t)(v >> 8);
+  p[1] = (uint8_t)v;
+}
+
+static void put32(uint8_t *p, int32_t v)
+{
+  p[0] = (uint8_t)(v >> 24);
+  p[1] = (uint8_t)(v >> 16);
+  p[2] = (uint8_t)(v >> 8);
+  p[3] = (uint8_t)v;
+}
+
+void SimMPU6050::produce(uint64_t t)
+{
+  Attitude a = _motion ? _motion->at(t) : Attitude();
+  float r = a.roll * M_PI / 180;
+  float p = a.pitch * M_PI / 180;
+
+  // the accelerometer reads the up vector in the body frame, in g; roll
+  // is about x and pitch about y, right handed, like the gyro rates
+  float gx = -sinf(p);
+  float gy = sinf(r) * cosf(p);
+  float gz = cosf(r) * cosf(p);
+
+  float accelScale = 16384.0f / (1 << ((_regs[ACCEL_CONFIG] >> 3) & 3));
+  float gyroScale = 131.0f / (1 << ((_regs[GYRO_CONFIG] >> 3) & 3));
+
+  ImuSample s;
+  s.ax = clamp16((gx + _accelNoise * gaussian()) * accelScale);
+  s.ay = clamp16((gy + _accelNoise * gaussian()) * accelScale);
+  s.az = clamp16((gz + _accelNoise * gaussian()) * accelScale);
+  s.temp = clamp16((25.0f - 36.53f) * 340.0f);
+  s.gx = clamp16((a.rollRate + _gyroNoise * gaussian()) * gyroScale);
+  s.gy = clamp16((a.pitchRate + _gyroNoise * gaussian()) * gyroScale);
+  s.gz = clamp16((a.yawRate + _gyroNoise * gaussian()) * gyroScale);
+
+  put16(&_regs[ACCEL_XOUT_H + 0], s.ax);
+  put16(&_regs[ACCEL_XOUT_H + 2], s.ay);
+  put16(&_regs[ACCEL_XOUT_H + 4], s.az);
+  put16(&_regs[ACCEL_XOUT_H + 6], s.temp);
+  put16(&_regs[ACCEL_XOUT_H + 8], s.gx);
+  put16(&_regs[ACCEL_XOUT_H + 10], s.gy);
+  put16(&_regs[ACCEL_XOUT_H + 12], s.gz);
+
+  uint8_t raised = 0x01;    // DATA_RDY
+  if ((_regs[USER_CTRL] & 0xC0) == 0xC0)
+  {
+    pushDMPPacket(a, s);
+    raised |= 0x02;         // DMP_INT
+  }
+  _regs[INT_STATUS] |= raised;
+  if (_regs[INT_ENABLE] & raised) _pendingPulses++;
+}
+
+void SimMPU6050::pushDMPPacket(const Attitude &a, const ImuSample &s)
+{
+  float hr = a.roll * M_PI / 360;
+  float hp = a.pitch * M_PI / 360;
+  float hy = a.yaw * M_PI / 360;
+  float w = cosf(hr) * cosf(hp) * cosf(hy) + sinf(hr) * sinf(hp) * sinf(hy);
+  float x = sinf(hr) * cosf(hp) * cosf(hy) - cosf(hr) * sinf(hp) * sinf(hy);
+  float y = cosf(hr) * sinf(hp) * cosf(hy) + sinf(hr) * cosf(hp) * sinf(hy);
+  float z = cosf(hr) * cosf(hp) * sinf(hy) - sinf(hr) * sinf(hp) * cosf(hy);
+
+  // MotionApps 2.0 layout: Q30 quaternion, gyro, accel (8192 LSB/g)
+  uint8_t packet[DMP_PACKET_SIZE];
+  memset(packet, 0, sizeof(packet));
+  put32(&packet[0], (int32_t)(w * 1073741824.0f));
+  put32(&packet[4], (int32_t)(x * 1073741824.0f));
+  put32(&packet[8], (int32_t)(y * 1073741824.0f));
+  put32(&packet[12], (int32_t)(z * 1073741824.0f));
+  put16(&packet[16], s.gx);
+  put16(&packet[20], s.gy);
+  put16(&packet[24], s.gz);
+  float accelScale = 16384.0f / (1 << ((_regs[ACCEL_CONFIG] >> 3) & 3));
+  put16(&packet[28], clamp16(s.ax / accelScale * 8192.0f));
+  put16(&packet[32], clamp16(s.ay / accelScale * 8192.0f));
+  put16(&packet[36], clamp16(s.az / accelScale * 8192.0f));
+
+  for (uint8_t i = 0; i < DMP_PACKET_SIZE; i++) _fifo.push_back(packet[i]);
+  if (_fifo.size() > FIFO_SIZE)
+  {
+    // the oldest data is lost and FIFO_OFLOW is flagged
+    _fifo.erase(_fifo.begin(), _fifo.begin() + (_fifo.size() - FIFO_SIZE));
+    _regs[INT_STATUS] |= 0x10;
+    if (_regs[INT_ENABLE] & 0x10) _pendingPulses++;
+  }
+}
+
+void SimMPU6050::advance(uint64_t t)
+{
+  if (!awake())
+  {
+    _sampling = false;
+    return;
+  }
+  if (!_sampling)
+  {
+    _sampling = true;
+    _lastSample = t;
+    produce(t);
+    return;
+  }
+  uint32_t p = period();
+  // after a long stall only the last FIFO's worth of samples matters
+  uint64_t behind = (t - _lastSample) / p;
+  if (behind > FIFO_SIZE / DMP_PACKET_SIZE + 1)
+  {
+    _lastSample += (behind - FIFO_SIZE / DMP_PACKET_SIZE - 1) * p;
+  }
+  while (_lastSample + p <= t)
+  {
+    _lastSample += p;
+    produce(_lastSample);
+  }
+}
+
+ImuSample SimMPU6050::sample() const
+{
+  ImuSample s;
+  const uint8_t *r = &_regs[ACCEL_XOUT_H];
+  s.ax = (int16_t)(r[0] << 8 | r[1]);
+  s.ay = (int16_t)(r[2] << 8 | r[3]);
+  s.az = (int16_t)(r[4] << 8 | r[5]);
+  s.temp = (int16_t)(r[6] << 8 | r[7]);
+  s.gx = (int16_t)(r[8] << 8 | r[9]);
+  s.gy = (int16_t)(r[10] << 8 | r[11]);
+  s.gz = (int16_t)(r[12] << 8 | r[13]);
+  return s;
+}
+
+uint8_t SimMPU6050::readRegister(uint8_t reg)
+{
+  switch (reg)
+  {
+    case FIFO_COUNTH:
+      return (uint8_t)(_fifo.size() >> 8);
+    case FIFO_COUNTL:
+      return (uint8_t)_fifo.size();
+    case INT_STATUS:
+    {
+      // cleared by reading
+      uint8_t status = _regs[INT_STATUS];
+      _regs[INT_STATUS] = 0;
+      return status;
+    }
+    default:
+      return _regs[reg & 0x7F];
+  }
+}
+
+void SimMPU6050::writeRegister(uint8_t reg, uint8_t value)
+{
+  switch (reg)
+  {
+    case PWR_MGMT_1:
+      if (value & 0x80)
+      {
+        reset();
+        return;
+      }
+      _regs[PWR_MGMT_1] = value;
+      if (awake() && !_sampling)
+      {
+        _sampling = true;
+        _lastSample = now();
+      }
+      break;
+    case USER_CTRL:
+      if (value & 0x04) _fifo.clear();        // FIFO_RESET
+      // the reset bits clear themselves
+      _regs[USER_CTRL] = value & ~0x0F;
+      break;
+    case BANK_SEL:
+      _regs[BANK_SEL] = value;
+      _bank = value & 0x1F;
+      break;
+    case MEM_START:
+      _regs[MEM_START] = value;
+      _memAddress = value;
+      break;
+    case INT_STATUS:
+    case FIFO_COUNTH:
+    case FIFO_COUNTL:
+    case WHO_AM_I:
+      break;                                  // read only
+    default:
+      _regs[reg & 0x7F] = value;
+      break;
+  }
+}
+
+uint8_t SimMPU6050::write(const uint8_t *data, uint16_t length)
+{
+  advance(now());
+  if (length == 0) return 0;
+  _pointer = data[0];
+  for (uint16_t i = 1; i < length; i++)
+  {
+    if (_pointer == MEM_R_W)
+    {
+      _memory[_bank * 256 + _memAddress++] = data[i];
+    }
+    else if (_pointer == FIFO_R_W)
+    {
+      if (_fifo.size() < FIFO_SIZE) _fifo.push_back(data[i]);
+    }
+    else
+    {
+      writeRegister(_pointer, data[i]);
+      _pointer++;
+    }
+  }
+  return 0;
+}
+
+uint16_t SimMPU6050::read(uint8_t *data, uint16_t length)
+{
+  advance(now());
+  for (uint16_t i = 0; i < length; i++)
+  {
+    if (_pointer == MEM_R_W)
+    {
+      data[i] = _memory[_bank * 256 + _memAddress++];
+    }
+    else if (_pointer == FIFO_R_W)
+    {
+      if (_fifo.empty())
+      {
+        data[i] = 0;
+      }
+      else
+      {
+        data[i] = _fifo.front();
+        _fifo.pop_front();
+      }
+    }
+    else
+    {
+      data[i] = readRegister(_pointer);
+      _pointer++;
+    }
+  }
+  return length;
+}
+
+void SimMPU6050::tick(uint64_t t)
+{
+  uint16_t pulses;
+  {
+    std::lock_guard<std::recursive_mutex> guard(busLock());
+    advance(t);
+    pulses = _pendingPulses;
+    _pendingPulses = 0;
+  }
+  // INT is a 50 us active high pulse by default; the edge is what counts
+  while (pulses--)
+  {
+    drive(_intPin, HIGH);
+    drive(_intPin, LOW);
+  }
+}
+
+uint64_t SimMPU6050::next() const
+{
+  std::lock_guard<std::recursive_mutex> guard(busLock());
+  if (_pendingPulses) return 0;
+  if (!awake() || !_sampling) return UINT64_MAX;
+  return _lastSample + period();
+}
+
+} // namespace sim
+
+// END OF FILE
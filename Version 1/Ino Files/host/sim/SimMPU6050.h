@@ -0,0 +1,110 @@
+//
+//    FILE: SimMPU6050.h
+// PURPOSE: register level model of the InvenSense MPU-6050 for the host simulator
+//
+// Models what the sketches and the I2Cdev MPU6050 library touch:
+// - the register file with auto-increment burst access, sleep and reset
+// - accelerometer, gyro and temperature outputs at the sample rate set
+//   by SMPLRT_DIV / DLPF_CFG, scaled by AFS_SEL / FS_SEL
+// - DMP memory banks (BANK_SEL / MEM_START_ADDR / MEM_R_W), so firmware
+//   upload and verify work
+// - the 1024 byte FIFO; with the DMP enabled a 42 byte MotionApps 2.0
+//   packet is queued per sample
+// - INT_STATUS and a pulse on the INT pin for enabled sources
+//
+// The motion comes from a Motion source; the default is a slow roll and
+// pitch wobble with sensor noise.
+//
+
+#ifndef SimMPU6050_h
+#define SimMPU6050_h
+
+#include <deque>
+#include <stdint.h>
+
+#include "Sim.h"
+
+namespace sim
+{
+
+// one raw sample, in register units at the current full scale settings
+struct ImuSample
+{
+  int16_t ax, ay, az;
+  int16_t temp;
+  int16_t gx, gy, gz;
+};
+
+// attitude in degrees and body rates in degrees per second
+struct Attitude
+{
+  float roll, pitch, yaw;
+  float rollRate, pitchRate, yawRate;
+};
+
+class Motion
+{
+public:
+  virtual ~Motion() {}
+  virtual Attitude at(uint64_t t) = 0;
+};
+
+// roll and pitch oscillating in quadrature
+class Wobble : public Motion
+{
+public:
+  Wobble(float amplitude, float hz) : _amplitude(amplitude), _hz(hz) {}
+  Attitude at(uint64_t t);
+private:
+  float _amplitude;
+  float _hz;
+};
+
+class SimMPU6050 : public I2CDevice, public Peripheral
+{
+public:
+  explicit SimMPU6050(uint8_t address = 0x68, uint8_t intPin = 2);
+
+  void setMotion(Motion *motion) { _motion = motion; }
+  void setNoise(float accel, float gyro) { _accelNoise = accel; _gyroNoise = gyro; }
+
+  uint8_t write(const uint8_t *data, uint16_t length);
+  uint16_t read(uint8_t *data, uint16_t length);
+
+  void tick(uint64_t t);
+  uint64_t next() const;
+
+  // the sample the data registers currently hold
+  ImuSample sample() const;
+
+private:
+  void reset();
+  bool awake() const;
+  uint32_t period() const;
+  void advance(uint64_t t);
+  void produce(uint64_t t);
+  void pushDMPPacket(const Attitude &a, const ImuSample &s);
+  uint8_t readRegister(uint8_t reg);
+  void writeRegister(uint8_t reg, uint8_t value);
+  float gaussian();
+
+  uint8_t _intPin;
+  uint8_t _regs[128];
+  uint8_t _pointer;
+  uint8_t _bank;
+  uint8_t _memAddress;
+  uint8_t _memory[32 * 256];
+  std::deque<uint8_t> _fifo;
+  uint64_t _lastSample;
+  bool _sampling;
+  uint16_t _pendingPulses;
+  uint32_t _seed;
+  float _accelNoise;
+  float _gyroNoise;
+  Motion *_motion;
+};
+
+} // namespace sim
+
+#endif
+// END OF FILE
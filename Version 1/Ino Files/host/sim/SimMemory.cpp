@@ -0,0 +1,84 @@
+//
+//    FILE: SimMemory.cpp
+// PURPOSE: I2C EEPROM (24LC series) and FRAM model for the host simulator
+//
+
+#include <stdio.h>
+
+#include "SimMemory.h"
+
+namespace sim
+{
+
+SimMemory::SimMemory(uint8_t address, uint32_t size, uint8_t pageSize, uint32_t writeCycle)
+  : I2CDevice(address), _pageSize(0), _writeCycle(0), _pointer(0), _busyUntil(0)
+{
+  resize(size, pageSize, writeCycle);
+}
+
+void SimMemory::resize(uint32_t size, uint8_t pageSize, uint32_t writeCycle)
+{
+  // erased EEPROM reads 0xFF
+  _data.assign(size, 0xFF);
+  _pageSize = pageSize;
+  _writeCycle = writeCycle;
+  _pointer = 0;
+}
+
+bool SimMemory::load(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  if (!f) return false;
+  size_t n = fread(&_data[0], 1, _data.size(), f);
+  fclose(f);
+  return n > 0;
+}
+
+bool SimMemory::save(const char *path) const
+{
+  FILE *f = fopen(path, "wb");
+  if (!f)
+  {
+    perror(path);
+    return false;
+  }
+  bool ok = fwrite(&_data[0], 1, _data.size(), f) == _data.size();
+  fclose(f);
+  return ok;
+}
+
+uint8_t SimMemory::write(const uint8_t *data, uint16_t length)
+{
+  // busy in its write cycle: the address byte is not acknowledged
+  if (now() < _busyUntil) return 2;
+  if (length < 2 || _data.empty()) return 0;
+
+  _pointer = ((data[0] << 8) | data[1]) % _data.size();
+  if (length == 2) return 0;
+
+  // an EEPROM page write stays in the page, a FRAM just goes on
+  uint32_t page = _pageSize ? _pointer - _pointer % _pageSize : 0;
+  for (uint16_t i = 2; i < length; i++)
+  {
+    _data[_pointer] = data[i];
+    if (_pageSize) _pointer = page + (_pointer + 1 - page) % _pageSize;
+    else _pointer = (_pointer + 1) % _data.size();
+  }
+  if (_writeCycle) _busyUntil = now() + _writeCycle;
+  return 0;
+}
+
+uint16_t SimMemory::read(uint8_t *data, uint16_t length)
+{
+  if (now() < _busyUntil) return 0;
+  for (uint16_t i = 0; i < length; i++)
+  {
+    data[i] = _data[_pointer];
+    _pointer = (_pointer + 1) % _data.size();
+  }
+  return length;
+}
+
+} // namespace sim
+
+// END OF FILE
@@ -0,0 +1,51 @@
+//
+//    FILE: SimMemory.h
+// PURPOSE: I2C EEPROM (24LC series) and FRAM model for the host simulator
+//
+// Two address bytes, then data; reads and writes auto-increment. As an
+// EEPROM, a write wraps around inside its page and the part does not
+// acknowledge its address until the write cycle is over. As a FRAM
+// (page size 0) writes go straight through.
+//
+// The contents can be loaded from and saved to an image file, so that
+// one sketch can read back what another one wrote.
+//
+
+#ifndef SimMemory_h
+#define SimMemory_h
+
+#include <stdint.h>
+#include <vector>
+
+#include "Sim.h"
+
+namespace sim
+{
+
+class SimMemory : public I2CDevice
+{
+public:
+  // pageSize 0 = FRAM, no write cycle
+  SimMemory(uint8_t address, uint32_t size, uint8_t pageSize = 0, uint32_t writeCycle = 0);
+
+  uint32_t size() const { return _data.size(); }
+  void resize(uint32_t size, uint8_t pageSize, uint32_t writeCycle);
+
+  bool load(const char *path);
+  bool save(const char *path) const;
+
+  uint8_t write(const uint8_t *data, uint16_t length);
+  uint16_t read(uint8_t *data, uint16_t length);
+
+private:
+  std::vector<uint8_t> _data;
+  uint8_t _pageSize;
+  uint32_t _writeCycle;
+  uint32_t _pointer;
+  uint64_t _busyUntil;
+};
+
+} // namespace sim
+
+#endif
+// END OF FILE
@@ -0,0 +1,75 @@
+//
+//    FILE: SimReceiver.cpp
+// PURPOSE: PWM RC receiver model for the host simulator
+//
+
+#include "Arduino.h"
+#include "SimReceiver.h"
+
+namespace sim
+{
+
+SimReceiver::SimReceiver(uint8_t firstPin, uint8_t channels, uint32_t frame)
+  : _firstPin(firstPin), _channels(channels), _frame(frame), _signal(true),
+    _outageFrom(0), _outageTo(0), _glitchEvery(0), _frames(0), _silent(false)
+{
+  if (_channels > SIM_RC_CHANNELS) _channels = SIM_RC_CHANNELS;
+  for (uint8_t i = 0; i < SIM_RC_CHANNELS; i++) _width[i] = 1500;
+  schedule(0);
+}
+
+void SimReceiver::setWidth(uint8_t channel, uint16_t us)
+{
+  if (channel < _channels) _width[channel] = us;
+}
+
+uint16_t SimReceiver::width(uint8_t channel) const
+{
+  return channel < _channels ? _width[channel].load() : 0;
+}
+
+void SimReceiver::schedule(uint64_t start)
+{
+  _frameStart = start;
+  _frames++;
+  _silent = start >= _outageFrom && start < _outageTo;
+  _edge[0] = start;
+  for (uint8_t i = 0; i < _channels; i++) _edge[i + 1] = _edge[i] + _width[i];
+  _nextEdge = 0;
+  _nextTime = _edge[0];
+}
+
+void SimReceiver::tick(uint64_t t)
+{
+  while (_nextTime.load() <= t)
+  {
+    bool on = _signal && !_silent;
+    bool noise = _glitchEvery > 0 && _frames % _glitchEvery == 0;
+    if (on && _nextEdge <= _channels)
+    {
+      // rising edge of channel n is also the falling edge of channel n - 1
+      if (_nextEdge > 0) drive(_firstPin + _nextEdge - 1, LOW);
+      if (_nextEdge < _channels) drive(_firstPin + _nextEdge, HIGH);
+    }
+    else if (on)
+    {
+      // noise: all channels up, then down 20 us later
+      for (uint8_t i = 0; i < _channels; i++) drive(_firstPin + i, _nextEdge == _channels + 1);
+    }
+
+    _nextEdge++;
+    if (_nextEdge <= _channels) _nextTime = _edge[_nextEdge];
+    else if (noise && _nextEdge == _channels + 1) _nextTime = _edge[_channels] + 500;
+    else if (noise && _nextEdge == _channels + 2) _nextTime = _edge[_channels] + 520;
+    else schedule(_frameStart + _frame);
+  }
+}
+
+uint64_t SimReceiver::next() const
+{
+  return _nextTime.load();
+}
+
+} // namespace sim
+
+// END OF FILE
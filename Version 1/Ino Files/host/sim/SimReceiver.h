@@ -0,0 +1,66 @@
+//
+//    FILE: SimReceiver.h
+// PURPOSE: PWM RC receiver model for the host simulator
+//
+// Drives one pin per channel with a servo pulse every frame. Channels
+// are sent one after the other, each rising as the previous one falls,
+// the way most PWM receivers stagger their outputs.
+//
+// Faults for the decoders: an outage (no frames at all for a while) and
+// noise, a 20 us pulse on every channel after some frames.
+//
+
+#ifndef SimReceiver_h
+#define SimReceiver_h
+
+#include <atomic>
+#include <stdint.h>
+
+#include "Sim.h"
+
+namespace sim
+{
+
+#define SIM_RC_CHANNELS 8
+
+class SimReceiver : public Peripheral
+{
+public:
+  SimReceiver(uint8_t firstPin, uint8_t channels, uint32_t frame = 20000);
+
+  void setWidth(uint8_t channel, uint16_t us);
+  uint16_t width(uint8_t channel) const;
+  void setSignal(bool on) { _signal = on; }   // false = receiver lost the transmitter
+  // no frames from time from to time to (us)
+  void setOutage(uint64_t from, uint64_t to) { _outageFrom = from; _outageTo = to; }
+  // noise after one frame in every, 0 = none
+  void setGlitches(uint16_t every) { _glitchEvery = every; }
+
+  void tick(uint64_t t);
+  uint64_t next() const;
+
+private:
+  void schedule(uint64_t start);
+
+  uint8_t _firstPin;
+  uint8_t _channels;
+  uint32_t _frame;
+  std::atomic<uint16_t> _width[SIM_RC_CHANNELS];
+  std::atomic<bool> _signal;
+  uint64_t _outageFrom;
+  uint64_t _outageTo;
+  uint16_t _glitchEvery;
+  uint32_t _frames;
+  bool _silent;                 // this frame falls in the outage
+
+  // edges of the current frame: channel n rises at _edge[n], falls at _edge[n + 1]
+  uint64_t _frameStart;
+  uint64_t _edge[SIM_RC_CHANNELS + 1];
+  uint8_t _nextEdge;
+  std::atomic<uint64_t> _nextTime;
+};
+
+} // namespace sim
+
+#endif
+// END OF FILE
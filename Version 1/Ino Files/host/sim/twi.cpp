@@ -0,0 +1,192 @@
+//
+//    FILE: twi.cpp
+// PURPOSE: host replacement for Wire/utility/twi.c
+//
+// Same entry points and return codes as the AVR driver, but instead of
+// driving the TWI state machine each transaction is handed to the
+// simulated device at that address. The caller is blocked for as long
+// as the transfer would occupy the bus at the rate set in TWBR.
+// twi_readRegisterAsync() returns at once; the transfer completes after
+// its bus time and the callback runs as the TWI interrupt.
+//
+// Slave mode is not simulated.
+//
+
+#include <atomic>
+
+#include "Arduino.h"
+#include "Sim.h"
+
+extern "C" {
+  #include "twi.h"
+}
+
+static bool twi_ready = false;
+
+// the one transfer the TWI hardware can have in flight
+class AsyncRead : public sim::Peripheral
+{
+public:
+  AsyncRead() : busy(false), done(0), address(0), reg(0), length(0), count(0), callback(NULL) {}
+
+  void tick(uint64_t t)
+  {
+    if (!busy.load() || t < done) return;
+    {
+      std::lock_guard<std::recursive_mutex> guard(sim::busLock());
+      sim::I2CDevice *device = sim::device(address);
+      count = 0;
+      if (device && device->write(&reg, 1) == 0) count = device->read(buffer, length);
+    }
+    sim::stats().i2cTransactions += 2;
+    sim::stats().i2cBytes += 2 + 1 + count;
+    busy.store(false);
+    sim::raise(complete);
+  }
+
+  uint64_t next() const
+  {
+    return busy.load() ? done : UINT64_MAX;
+  }
+
+  static void complete()
+  {
+    void (*fn)(uint8_t*, uint8_t) = instance.callback;
+    instance.callback = NULL;
+    if (fn) fn(instance.buffer, instance.count);
+  }
+
+  // a blocking transfer has to wait for the bus like on the AVR
+  void settle()
+  {
+    while (busy.load()) sim::waitUntil(done);
+  }
+
+  static AsyncRead instance;
+
+  std::atomic<bool> busy;
+  uint64_t done;
+  uint8_t address;
+  uint8_t reg;
+  uint8_t length;
+  uint8_t count;
+  uint8_t buffer[TWI_BUFFER_LENGTH];
+  void (*callback)(uint8_t*, uint8_t);
+};
+
+AsyncRead AsyncRead::instance;
+
+void twi_init(void)
+{
+  // 100 kHz on a 16 MHz board, as utility/twi.c computes it
+  TWSR &= ~(_BV(TWPS0) | _BV(TWPS1));
+  TWBR = ((F_CPU / TWI_FREQ) - 16) / 2;
+  if (!twi_ready) sim::attach(&AsyncRead::instance);
+  twi_ready = true;
+}
+
+void twi_setAddress(uint8_t address)
+{
+  TWAR = address << 1;
+}
+
+uint8_t twi_readFrom(uint8_t address, uint8_t* data, uint8_t length, uint8_t sendStop)
+{
+  (void)sendStop;
+  // the AVR driver reads straight into data, any length
+  if (0 == length || !twi_ready) {
+    return 0;
+  }
+  AsyncRead::instance.settle();
+
+  uint8_t count = 0;
+  {
+    std::lock_guard<std::recursive_mutex> guard(sim::busLock());
+    sim::I2CDevice *device = sim::device(address);
+    if (device) count = device->read(data, length);
+  }
+
+  sim::stats().i2cTransactions++;
+  sim::stats().i2cBytes += 1 + count;
+  sim::wait(sim::busTime(1 + (count ? count : 0)));
+  return count;
+}
+
+uint8_t twi_writeTo(uint8_t address, uint8_t* data, uint8_t length, uint8_t wait, uint8_t sendStop)
+{
+  (void)sendStop;
+  // only a write that doesn't wait is copied into the twi buffer
+  if (!wait && TWI_BUFFER_LENGTH < length) {
+    return 1;
+  }
+  if (!twi_ready) {
+    return 4;
+  }
+  AsyncRead::instance.settle();
+
+  uint8_t status;
+  {
+    std::lock_guard<std::recursive_mutex> guard(sim::busLock());
+    sim::I2CDevice *device = sim::device(address);
+    // no device: the address byte is not acknowledged
+    status = device ? device->write(data, length) : 2;
+  }
+
+  sim::stats().i2cTransactions++;
+  sim::stats().i2cBytes += 1 + length;
+  sim::wait(sim::busTime(status == 2 ? 1 : 1 + length));
+  return status;
+}
+
+uint8_t twi_readRegisterAsync(uint8_t address, uint8_t reg, uint8_t length, void (*callback)(uint8_t*, uint8_t))
+{
+  // ensure data will fit into buffer
+  if (TWI_BUFFER_LENGTH < length || 0 == length) {
+    return 1;
+  }
+  AsyncRead &a = AsyncRead::instance;
+  if (!twi_ready || a.busy.load() || a.callback) {
+    return 4;
+  }
+
+  a.address = address;
+  a.reg = reg;
+  a.length = length;
+  a.callback = callback;
+  // address + register, repeated start, address + data
+  a.done = sim::now() + sim::busTime(2) + sim::busTime(1 + length);
+  a.busy.store(true);
+  return 0;
+}
+
+uint8_t twi_transmit(const uint8_t* data, uint8_t length)
+{
+  (void)data;
+  (void)length;
+  return 1;
+}
+
+void twi_attachSlaveRxEvent( void (*function)(uint8_t*, int) )
+{
+  (void)function;
+}
+
+void twi_attachSlaveTxEvent( void (*function)(void) )
+{
+  (void)function;
+}
+
+void twi_reply(uint8_t ack)
+{
+  (void)ack;
+}
+
+void twi_stop(void)
+{
+}
+
+void twi_releaseBus(void)
+{
+}
+
+// END OF FILE
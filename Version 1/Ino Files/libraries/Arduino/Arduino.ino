@@ -1,30 +1,84 @@
-#include <Servo.h>
+#include <SoftwareServo.h>
 #include<Wire.h>
+#include <util/crc16.h>
+#include <RCReceiver.h>
+
+//calcul des angles en entiers (FixedAttitude) au lieu des flottants (Kalman)
+//#define ANGLES_VIRGULE_FIXE
+
+#ifdef ANGLES_VIRGULE_FIXE
+#include <FixedAttitude.h>
+#else
+#include <KalmanBank.h>
+#endif
+
+//mesure du temps passé dans chaque section de la loop, envoyé avec les statistiques
+//(trame_profil) ; sans ce define les PROFILE_ ne compilent en rien
+//#define PROFILER
+enum { profil_angles, profil_estimateur, profil_serie, profil_telemetrie, profil_envoi_trame, profil_moteurs, nombre_profils };
+#define PROFILER_SLOTS nombre_profils
+#include <Profiler.h>
+
+//enregistreur de vol : chaque mesure du MPU et les signaux de la telecommande vont
+//dans une FRAM de 32 Ko (0x50), en anneau ; relue apres le vol avec l'exemple
+//flightRecorderDump de FlightRecorder et decodee par host/replay/fdr_extract
+//#define ENREGISTREUR
+#ifdef ENREGISTREUR
+#include <FRAM.h>
+#include <FlightRecorder.h>
+#include <FlightRecorderFRAM.h>
+FRAM fram ;
+FlightRecorderFRAM memoire_enregistreur(fram, 32768) ;
+FlightRecorder enregistreur(memoire_enregistreur) ;
+#endif
 
 const int MPU=0x68;  // I2C address of the MPU-6050
-bool etatSignal [4];
-unsigned long curentTime,timer [4] ;
-int signal [4] ;
 
-//fonction qui permet de declaré les pins commme interuptions
-void pciSetup(byte pin)
-{
-    *digitalPinToPCMSK(pin) |= bit (digitalPinToPCMSKbit(pin));  // enable pin
-    PCIFR  |= bit (digitalPinToPCICRbit(pin)); // clear any outstanding interrupt
-    PCICR  |= bit (digitalPinToPCICRbit(pin)); // enable interrupt for the group
-}
+//Telecommande sur les pins 8 a 11 (port B) : l'interruption lit le port une fois et date
+//les fronts, les impulsions hors 800..2200 us et les sauts isoles sont rejetes, et une
+//voie sans impulsion depuis 100 ms passe a sa valeur de securite. Horloge Timer1 (0.5 us),
+//que SoftwareServo laisse tourner librement
+RCReceiver recepteur(8, 4);
 
 //definition des vartiables global
-const unsigned char constante_moyenne_glissante = 50 ;
-unsigned char i = 0;
-int valeursX[constante_moyenne_glissante];
-int valeursY[constante_moyenne_glissante];
-float somme[2] ;    //0 pour x et 1 pour y
-float angles[2] ;    //0 pour x et 1 pour y 
-unsigned long loop_timer = 0;
+int angles[2] ;    //0 pour x et 1 pour y, en centiemes de degre
+//Estimation des angles : un filtre par axe fusionne le gyro (integré)
+//et l'angle donné par l'accelerometre (qui corrige la derive)
+//  flottants : filtre de Kalman, qui estime aussi le biais du gyro, les deux axes en un seul appel
+//  entiers   : filtre complementaire, angles en BAM (32768 = 180 degres), sans sqrt/atan2 flottants
+#ifdef ANGLES_VIRGULE_FIXE
+FixedAttitude filtreX(131);   //gyro en +-250 deg/s, reglage par defaut du MPU
+FixedAttitude filtreY(131);
+#else
+KalmanBank<2> kalman ;   //axe 0 pour x, 1 pour y
+const float gyro_lsb_par_degre = 131.0 ;   //gyro en +-250 deg/s, reglage par defaut du MPU
+#endif
+bool estimateur_initialise = false ;
+unsigned long date_derniere_mesure ;
+//Trames binaires échangées avec le Pi :
+//  synchro, identifiant, champs int16 poids faible en premier, crc8 (identifiant + champs)
+//  telemetrie   (Arduino -> Pi) : angles x et y en centiemes de degre, 4 signaux telecomande en us
+//  commandes    (Pi -> Arduino) : commandes_moteur[0..2]
+//  demande de statistiques (Pi -> Arduino) : 1 pour remettre les compteurs a zero apres l'envoi
+//  statistiques (Arduino -> Pi) : une trame par tache, voir envoi_statistiques()
+//  profil       (Arduino -> Pi) : une trame par section mesuree, avec PROFILER, voir envoi_statistiques()
+const byte trame_synchro = 0xA5 ;
+const byte trame_telemetrie = 0x01 ;
+const byte trame_commandes = 0x02 ;
+const byte trame_demande_statistiques = 0x03 ;
+const byte trame_statistiques = 0x04 ;
+const byte trame_profil = 0x05 ;
+const byte nombre_champs_telemetrie = 6 ;
+const byte nombre_champs_commandes = 3 ;
+const byte nombre_champs_statistiques = 7 ;
+const byte nombre_champs_profil = 5 ;
+
 //Variables lecture série
-String mot ="" ;
+byte trame_recue[2 + 2 * nombre_champs_commandes + 1] ;   //la plus longue trame recue
+byte position_trame = 0 ;
+byte longueur_trame = 0 ;
 bool data_available = false ;
+byte statistiques_demandees = 0 ;   //0 rien, 1 envoi, 2 envoi et remise a zero
 
 //Consigne des moteurs et signals telecomandes
 int commandes_moteur[3] = {1000, 80, 80};
@@ -32,41 +86,110 @@ int signals_telecomande[4];
 float batterie_tension[3];
 unsigned char compteur_donne_recu = 1;
 
-//Declare mes moteurs avec la librairie Servo
-Servo ESC;
-Servo Servo1;
-Servo Servo2;
+//Declare mes moteurs : impulsions sur interruption du Timer1, trames de 20 ms
+//(SoftwareServo::setFrameRate(400) pour un ESC qui accepte 400 Hz, les servos
+//restant a 50 Hz avec setRate(50))
+SoftwareServo ESC;
+SoftwareServo Servo1;
+SoftwareServo Servo2;
+
+//Lecture du MPU sans attente : la loop lance la lecture des 14 octets, l'interruption TWI
+//la termine dans un des deux tampons, et la loop traite le dernier tampon complet
+const byte registre_mesures_mpu = 0x3B ;  // ACCEL_XOUT_H, puis TEMP et GYRO
+byte mesures_mpu[2][14] ;
+unsigned long dates_mesures[2] ;   //micros() a la fin de chaque lecture
+volatile byte tampon_pret = 0 ;
+volatile bool nouvelle_mesure = false ;
+volatile bool lecture_en_cours = false ;
+
+//appelée par l'interruption TWI a la fin de la lecture
+void lecture_mpu_terminee(uint8_t * donnees, uint8_t longueur)
+{
+  lecture_en_cours = false ;
+  if(longueur != sizeof(mesures_mpu[0])) return ;   //le MPU n'a pas repondu, on relancera
+  //on remplit le tampon que la loop n'est pas en train de lire
+  byte tampon = 1 - tampon_pret ;
+  for(byte n = 0; n < sizeof(mesures_mpu[0]); n++) mesures_mpu[tampon][n] = donnees[n] ;
+  dates_mesures[tampon] = micros();
+  tampon_pret = tampon ;
+  nouvelle_mesure = true ;
+}
+
+void lance_lecture_mpu()
+{
+  lecture_en_cours = true ;
+  if(Wire.requestFromAsync(MPU, registre_mesures_mpu, sizeof(mesures_mpu[0]), lecture_mpu_terminee) != 0) lecture_en_cours = false ;
+}
+
+//met a jour les angles X et Y a partir des 14 octets lus a partir de ACCEL_XOUT_H
+//et de la date de la lecture (micros()) ; separée de update_angles() pour pouvoir
+//rejouer un enregistrement sur le PC (host/replay)
+void traite_mesure(const byte * mesure, unsigned long date_mesure)
+{
+  int16_t AcX=(int16_t)(mesure[0]<<8|mesure[1]);    // 0x3B (ACCEL_XOUT_H) & 0x3C (ACCEL_XOUT_L)
+  int16_t AcY=(int16_t)(mesure[2]<<8|mesure[3]);    // 0x3D (ACCEL_YOUT_H) & 0x3E (ACCEL_YOUT_L)
+  int16_t AcZ=(int16_t)(mesure[4]<<8|mesure[5]);    // 0x3F (ACCEL_ZOUT_H) & 0x40 (ACCEL_ZOUT_L)
+  int16_t GyX=(int16_t)(mesure[8]<<8|mesure[9]);    // 0x43 (GYRO_XOUT_H) & 0x44 (GYRO_XOUT_L)
+  int16_t GyY=(int16_t)(mesure[10]<<8|mesure[11]);  // 0x45 (GYRO_YOUT_H) & 0x46 (GYRO_YOUT_L)
+  unsigned long dt = date_mesure - date_derniere_mesure ;
+  date_derniere_mesure = date_mesure ;
+  PROFILE_SCOPE(profil_estimateur);
+
+  //angles de l'accelerometre, memes signes qu'avant : X suit -tangage, Y suit -roulis
+#ifdef ANGLES_VIRGULE_FIXE
+  int16_t AcXangle = atan2BAM(AcX, isqrt32((int32_t)AcY*AcY + (int32_t)AcZ*AcZ));
+  int16_t AcYangle = -atan2BAM(AcY, isqrt32((int32_t)AcX*AcX + (int32_t)AcZ*AcZ));
+  if(!estimateur_initialise)
+  {
+    filtreX.setAngle(AcXangle);
+    filtreY.setAngle(AcYangle);
+    estimateur_initialise = true ;
+  }
+  else
+  {
+    filtreX.update(AcXangle, -GyY, min(dt, (unsigned long)FIXED_ATTITUDE_MAX_DT));
+    filtreY.update(AcYangle, -GyX, min(dt, (unsigned long)FIXED_ATTITUDE_MAX_DT));
+  }
+  angles[0] = bamToCentidegrees(filtreX.getAngle());
+  angles[1] = bamToCentidegrees(filtreY.getAngle());
+#else
+  float AcXangle = atan2(AcX, sqrt((float)AcY*AcY + (float)AcZ*AcZ)) * RAD_TO_DEG ;
+  float AcYangle = atan2(AcY, sqrt((float)AcX*AcX + (float)AcZ*AcZ)) * -RAD_TO_DEG ;
+  if(!estimateur_initialise)
+  {
+    kalman.setAngle(0, AcXangle);
+    kalman.setAngle(1, AcYangle);
+    angles[0] = AcXangle * 100 ;
+    angles[1] = AcYangle * 100 ;
+    estimateur_initialise = true ;
+    return ;
+  }
+  const float angles_acc[2] = { AcXangle, AcYangle } ;
+  const float vitesses[2] = { -GyY / gyro_lsb_par_degre, -GyX / gyro_lsb_par_degre } ;
+  kalman.update(angles_acc, vitesses, dt * 1e-6);
+  angles[0] = kalman.getAngle(0) * 100 ;
+  angles[1] = kalman.getAngle(1) * 100 ;
+#endif
+}
 
 //fonction qui met a jour les valuers d'angles X et Y
 void update_angles()
 {
-  float AcX,AcY,AcZ,GyX,GyY,GyZ,AcTotal, Tmp;
-  float AcXangle , AcYangle;
-  Wire.beginTransmission(0x68);                                        //Start communicating with the MPU-6050
-  Wire.write(0x3B);                                                    //Send the requested starting register
-  Wire.endTransmission();                                              //End the transmission
-  Wire.requestFrom(0x68,14);                                           //Request 14 bytes from the MPU-6050
-  while(Wire.available() < 14);                                        //Wait until all the bytes are received
-  AcX=Wire.read()<<8|Wire.read();  // 0x3B (ACCEL_XOUT_H) & 0x3C (ACCEL_XOUT_L)     
-  AcY=Wire.read()<<8|Wire.read();  // 0x3D (ACCEL_YOUT_H) & 0x3E (ACCEL_YOUT_L)
-  AcZ=Wire.read()<<8|Wire.read();  // 0x3F (ACCEL_ZOUT_H) & 0x40 (ACCEL_ZOUT_L)
-  Tmp=Wire.read()<<8|Wire.read();  // 0x41 (TEMP_OUT_H) & 0x42 (TEMP_OUT_L)
-  GyX=Wire.read()<<8|Wire.read();  // 0x43 (GYRO_XOUT_H) & 0x44 (GYRO_XOUT_L)
-  GyY=Wire.read()<<8|Wire.read();  // 0x45 (GYRO_YOUT_H) & 0x46 (GYRO_YOUT_L)
-  GyZ=Wire.read()<<8|Wire.read();  // 0x47 (GYRO_ZOUT_H) & 0x48 (GYRO_ZOUT_L)
-  AcTotal = sqrt(AcX*AcX + AcZ*AcZ + AcY*AcY);
-  AcXangle = asin(AcX/AcTotal) * 57.296 ;
-  AcYangle = asin(AcY/AcTotal) * -57.296 ;
-  somme[0]-=valeursY[i];
-  somme[1]-=valeursX[i];
-  valeursX[i] = AcXangle ;
-  valeursY[i] = AcYangle ; 
-  somme[1]+= valeursX[i];
-  somme[0]+= valeursY[i];
-  angles[0] = somme[1] / constante_moyenne_glissante; // constante_moyenne_glissante
-  angles[1] = somme[0] / constante_moyenne_glissante; // constante_moyenne_glissante
-  i++;
-  if(i == constante_moyenne_glissante ) i = 0 ;
+  PROFILE_SCOPE(profil_angles);
+  if(!nouvelle_mesure)
+  {
+    if(!lecture_en_cours) lance_lecture_mpu();
+    return ;
+  }
+  //la prochaine lecture se fait dans l'autre tampon pendant qu'on calcule
+  const byte * mesure = mesures_mpu[tampon_pret] ;
+  unsigned long date_mesure = dates_mesures[tampon_pret] ;
+  nouvelle_mesure = false ;
+  lance_lecture_mpu();
+#ifdef ENREGISTREUR
+  enregistreur.logImu(mesure, date_mesure);
+#endif
+  traite_mesure(mesure, date_mesure);
 }
 
 void update_batterie()
@@ -74,32 +197,248 @@ void update_batterie()
   //a faire
 }
 
+//crc8 d'une trame, sans l'octet de synchro
+byte crc_trame(const byte * trame, byte longueur)
+{
+  byte crc = 0 ;
+  for(byte n = 1; n < longueur; n++) crc = _crc8_ccitt_update(crc, trame[n]);
+  return crc ;
+}
+
+//nombre d'octets d'une trame recue d'apres son identifiant, 0 si inconnue
+byte longueur_trame_recue(byte identifiant)
+{
+  if(identifiant == trame_commandes) return 2 + 2 * nombre_champs_commandes + 1 ;
+  if(identifiant == trame_demande_statistiques) return 2 + 2 + 1 ;
+  return 0 ;
+}
+
+//lit les octets recus un par un, sans allocation, et applique les trames valides
 void update_serial()
 {
+  PROFILE_SCOPE(profil_serie);
   while(Serial.available()>0)
   {
-    char msg = Serial.read();    
-    if(msg == '\n')
+    byte octet = Serial.read();
+    //on attend le debut d'une trame, puis un identifiant connu
+    if(position_trame == 0 && octet != trame_synchro) continue ;
+    if(position_trame == 1)
+    {
+      longueur_trame = longueur_trame_recue(octet);
+      if(longueur_trame == 0)
+      {
+        position_trame = (octet == trame_synchro) ? 1 : 0 ;
+        continue ;
+      }
+    }
+    trame_recue[position_trame++] = octet ;
+    if(position_trame < 2 || position_trame < longueur_trame) continue ;
+
+    position_trame = 0 ;
+    if(crc_trame(trame_recue, longueur_trame - 1) != trame_recue[longueur_trame - 1]) continue ;
+    if(trame_recue[1] == trame_demande_statistiques)
+    {
+      statistiques_demandees = trame_recue[2] ? 2 : 1 ;
+      continue ;
+    }
+    for(byte n = 0; n < nombre_champs_commandes; n++)
     {
-      int nombre = mot.toInt();    
-      int indice = nombre & 15 ;
-      nombre -= indice ;    
-      nombre = nombre >> 4; 
-      commandes_moteur[indice] = nombre ;
-      digitalWrite(13, !digitalRead(13));
-      mot = "";
-      compteur_donne_recu += 1;
+      commandes_moteur[n] = (int)(trame_recue[2 + 2 * n] | (trame_recue[3 + 2 * n] << 8));
     }
-    else mot.concat(msg) ;  
+    digitalWrite(13, !digitalRead(13));
+    compteur_donne_recu += 1;
   }
-  
 }
 
-void write(char indice, int value)
-{  
-  String string = String(value << 4 + indice);
-  string.concat('\n');
-  Serial.print(string);
+//envoi d'une trame sans allocation, nombre_champs au plus 8
+void envoi_trame(byte identifiant, const int * valeurs, byte nombre_champs)
+{
+  byte trame[2 + 2 * 8 + 1] ;
+  byte longueur = 2 + 2 * nombre_champs + 1 ;
+  trame[0] = trame_synchro ;
+  trame[1] = identifiant ;
+  for(byte n = 0; n < nombre_champs; n++)
+  {
+    trame[2 + 2 * n] = valeurs[n] & 0xFF ;
+    trame[3 + 2 * n] = (valeurs[n] >> 8) & 0xFF ;
+  }
+  trame[longueur - 1] = crc_trame(trame, longueur - 1);
+  PROFILE_BEGIN(profil_envoi_trame);
+  Serial.write(trame, longueur);
+  PROFILE_END(profil_envoi_trame);
+}
+
+//envoi toute la telemetrie dans une seule trame
+void envoi_telemetrie()
+{
+  PROFILE_SCOPE(profil_telemetrie);
+  int valeurs[nombre_champs_telemetrie] ;
+  valeurs[0] = angles[0] ;
+  valeurs[1] = angles[1] ;
+  for(byte n = 0; n < 4; n++) valeurs[2 + n] = signals_telecomande[n] ;
+  envoi_trame(trame_telemetrie, valeurs, nombre_champs_telemetrie);
+}
+
+//On fait tourner les moteurs comme il le faut, avec les dernieres impulsions de la telecommande
+void update_moteurs()
+{
+  PROFILE_SCOPE(profil_moteurs);
+  recepteur.update();
+  for(byte n = 0; n < 4; n++) signals_telecomande[n] = recepteur.width(n) ;
+  ESC.writeMicroseconds(signals_telecomande[2]-30);
+  Servo1.writeMicroseconds(signals_telecomande[0]);
+  Servo2.writeMicroseconds(signals_telecomande[1]);
+#ifdef ENREGISTREUR
+  int16_t canaux[FLIGHT_RECORDER_RC_CHANNELS] ;
+  for(byte n = 0; n < FLIGHT_RECORDER_RC_CHANNELS; n++) canaux[n] = signals_telecomande[n] ;
+  enregistreur.logRc(canaux, micros());
+#endif
+}
+
+#ifdef ENREGISTREUR
+//ecrit dans la FRAM un morceau du dernier bloc plein, s'il y en a un
+void update_enregistreur()
+{
+  enregistreur.update();
+}
+#endif
+
+//Ordonnanceur a frequence fixe cadencé par micros() : chaque tache a sa periode et garde
+//sa phase. Les taches sont rangées par priorité, une seule s'execute par passage.
+//  retard : entre la date prevue et le demarrage (gigue)
+//  depassement : la tache a demarré ou fini apres la date de l'execution suivante,
+//                les executions manquées sont sautées
+struct Tache
+{
+  void (*fonction)();
+  unsigned long periode ;        //us
+  unsigned long prochaine ;      //date de la prochaine execution
+  unsigned long executions ;
+  unsigned long retard_total ;
+  unsigned int retard_max ;
+  unsigned int duree_max ;
+  unsigned int depassements ;
+};
+
+Tache taches[] = {
+  {update_angles,      4000},   //250 Hz attitude
+  {update_serial,     20000},   //50 Hz reception des commandes
+  {update_moteurs,    20000},   //50 Hz sorties servos
+  {envoi_telemetrie, 100000},   //10 Hz telemetrie
+#ifdef ENREGISTREUR
+  {update_enregistreur, 4000},  //jusqu'a 250 ecritures par seconde, ~6 Ko/s
+#endif
+};
+const byte nombre_taches = sizeof(taches) / sizeof(taches[0]) ;
+
+void demarre_taches()
+{
+  unsigned long maintenant = micros();
+  for(byte n = 0; n < nombre_taches; n++) taches[n].prochaine = maintenant ;
+}
+
+void execute_taches()
+{
+  //une seule lecture de l'horloge par passage : une tache moins prioritaire devenue
+  //prete pendant le parcours ne passe pas devant celles qui la precedent
+  unsigned long debut = micros();
+  for(byte n = 0; n < nombre_taches; n++)
+  {
+    Tache & tache = taches[n] ;
+    unsigned long retard = debut - tache.prochaine ;
+    if((long)retard < 0) continue ;
+
+    tache.fonction();
+    unsigned long duree = micros() - debut ;
+
+    tache.executions++ ;
+    tache.retard_total += retard ;
+    if(retard > tache.retard_max) tache.retard_max = min(retard, 65535UL) ;
+    if(duree > tache.duree_max) tache.duree_max = min(duree, 65535UL) ;
+    tache.prochaine += tache.periode ;
+    unsigned long fin = debut + duree ;
+    if((long)(fin - tache.prochaine) >= 0)
+    {
+      tache.depassements++ ;
+      tache.prochaine += ((fin - tache.prochaine) / tache.periode + 1) * tache.periode ;
+    }
+    return ;
+  }
+}
+
+//trame de la tache n : indice, frequence (Hz), executions (16 bits de poids faible),
+//depassements, retard moyen, retard max et duree max (us)
+void envoi_statistiques_tache(byte n, bool remise_a_zero)
+{
+  Tache & tache = taches[n] ;
+  int valeurs[nombre_champs_statistiques] ;
+  valeurs[0] = n ;
+  valeurs[1] = 1000000UL / tache.periode ;
+  valeurs[2] = tache.executions ;
+  valeurs[3] = tache.depassements ;
+  valeurs[4] = tache.executions ? tache.retard_total / tache.executions : 0 ;
+  valeurs[5] = tache.retard_max ;
+  valeurs[6] = tache.duree_max ;
+  envoi_trame(trame_statistiques, valeurs, nombre_champs_statistiques);
+  if(remise_a_zero)
+  {
+    tache.executions = 0 ;
+    tache.retard_total = 0 ;
+    tache.retard_max = 0 ;
+    tache.duree_max = 0 ;
+    tache.depassements = 0 ;
+  }
+}
+
+#ifdef PROFILER
+//trame de la section mesuree n : indice, executions (16 bits de poids faible),
+//duree min, moyenne et max (us)
+void envoi_profil_section(byte n)
+{
+  int valeurs[nombre_champs_profil] ;
+  valeurs[0] = n ;
+  valeurs[1] = Profiler::count(n) ;
+  valeurs[2] = Profiler::minimum(n) ;
+  valeurs[3] = min(Profiler::mean(n), 65535UL) ;
+  valeurs[4] = Profiler::maximum(n) ;
+  envoi_trame(trame_profil, valeurs, nombre_champs_profil);
+}
+const byte nombre_trames_statistiques = nombre_taches + nombre_profils ;
+#else
+const byte nombre_trames_statistiques = nombre_taches ;
+#endif
+
+//Reponse a une demande de statistiques : une trame par tache puis, avec PROFILER, une par
+//section mesuree. Toutes d'un coup, c'est ~170 octets pour un tampon d'emission de 64 :
+//a 9600 bauds Serial.write bloquait ~100 ms et la tache d'attitude ratait ses dates.
+//On envoie donc au plus une trame par passage de la loop, et seulement si elle tient dans
+//le tampon en laissant la place d'une trame de telemetrie.
+const byte place_trame_statistiques = (2 + 2 * nombre_champs_statistiques + 1) + (2 + 2 * nombre_champs_telemetrie + 1) ;
+byte trame_statistiques_suivante = nombre_trames_statistiques ;   //nombre_trames_statistiques : rien a envoyer
+bool remise_a_zero_statistiques = false ;
+
+void envoi_statistiques()
+{
+  if(statistiques_demandees)
+  {
+    //une nouvelle demande repart de la premiere trame
+    remise_a_zero_statistiques = statistiques_demandees == 2 ;
+    trame_statistiques_suivante = 0 ;
+    statistiques_demandees = 0 ;
+  }
+  if(trame_statistiques_suivante >= nombre_trames_statistiques) return ;
+  if(Serial.availableForWrite() < place_trame_statistiques) return ;
+
+  byte n = trame_statistiques_suivante++ ;
+  if(n < nombre_taches)
+  {
+    envoi_statistiques_tache(n, remise_a_zero_statistiques);
+    return ;
+  }
+#ifdef PROFILER
+  envoi_profil_section(n - nombre_taches);
+  if(remise_a_zero_statistiques && trame_statistiques_suivante == nombre_trames_statistiques) Profiler::reset();
+#endif
 }
 
 void setup(){
@@ -109,6 +448,13 @@ void setup(){
   Wire.write(0x6B);  // PWR_MGMT_1 register
   Wire.write(0);     // set to zero (wakes up the MPU-6050)
   Wire.endTransmission(true);
+#ifdef ENREGISTREUR
+  //fram.begin() refait Wire.begin(), on passe a 400 kHz apres : un morceau de
+  //bloc prend 0.6 ms de bus au lieu de 2.4 ms
+  fram.begin(0x50);
+  TWBR = 12 ;
+  enregistreur.begin();
+#endif
   Serial.begin(9600);
 
   //On attend de recevoir une consigne de depart avant de faire quoi que ce soit
@@ -123,60 +469,27 @@ void setup(){
   Servo1.attach(6);
   Servo2.attach(7);
     
-  //On utilise la fonction déclaré precedement pour initaliser les interuptions sur les pin suivants
-  pciSetup(10);
-  pciSetup(8);
-  pciSetup(9);
-  pciSetup(11);
+  //Telecommande : valeurs de securite gouvernes au neutre, gaz coupes
+  recepteur.setFailsafe(0, 1500);
+  recepteur.setFailsafe(1, 1500);
+  recepteur.setFailsafe(2, 1000);
+  recepteur.setFailsafe(3, 1500);
+  recepteur.begin(RC_RECEIVER_TIMER1);
 
-  loop_timer = micros();
+  demarre_taches();
 }
 
 
 void loop(){
-  //On met a jour les données
-  update_angles();
   //update_batterie();
-
-  //On lit les données , on envoi les notres
-  update_serial();  
-  write(0, angles[0]);
-  write(1, angles[1]);
-  write(2, signals_telecomande[0]);
-  write(3, signals_telecomande[1]);
-  write(4, signals_telecomande[2]);
-  write(5, signals_telecomande[3]);
-    
-  
-  //On fait tourner les moteurs comme il le faut
-  ESC.writeMicroseconds(signals_telecomande[2]-30);
-  Servo1.writeMicroseconds(signals_telecomande[0]);
-  Servo2.writeMicroseconds(signals_telecomande[1]);
-  /*Serial.print(signals_telecomande[2]);
-  Serial.print("_____");
-  Serial.print(signals_telecomande[0]);
-  Serial.print("_____");
-  Serial.println(signals_telecomande[1]);*/
-  delay(20);
-
+  execute_taches();
+  envoi_statistiques();
 }
 
 
 
-//fonction qui met a jour les signaux d'entrée de la télécomande apr détéction d'interuption sur les pins du port B
-ISR (PCINT0_vect) // handle pin change interrupt for D8 to D13 here
- {    curentTime = micros();
-
- for(int n=0 ; n <4; n++){
-     if(digitalRead(n+8)==1){
-      if(etatSignal[n]==0){
-        etatSignal[n] = 1 ;
-        timer[n] = curentTime ;
-      }
-     }
-     else if(etatSignal[n]==1){
-      etatSignal[n] = 0 ;
-      signals_telecomande[n] = micros()-timer[n] ;
-     }
-  } 
- }
+//front sur une des pins 8 a 13 : une seule lecture du port pour les 4 voies
+ISR (PCINT0_vect)
+{
+  recepteur.handleInterrupt(PINB);
+}
@@ -1,27 +1,23 @@
-#include <Servo.h>
+#include <SoftwareServo.h>
 #include<Wire.h>
+#include <RCReceiver.h>
+#include <ServoMixer.h>
+#include <RunningAverage.h>
 
 const int MPU=0x68;  // I2C address of the MPU-6050
-bool etatSignal [4];
-unsigned long curentTime,timer [4] ;
-int signal [4] ;
 const float amplitude = 35 ;
 const float amplitude2 = 45 ;
 
-//fonction qui permet de declaré les pins commme interuptions
-void pciSetup(byte pin)
-{
-    *digitalPinToPCMSK(pin) |= bit (digitalPinToPCMSKbit(pin));  // enable pin
-    PCIFR  |= bit (digitalPinToPCICRbit(pin)); // clear any outstanding interrupt
-    PCICR  |= bit (digitalPinToPCICRbit(pin)); // enable interrupt for the group
-}
+//Telecommande sur les pins 8 a 11 (port B), impulsions filtrees et valeur de securite
+//si une voie se tait plus de 100 ms ; horloge Timer1 (0.5 us), partage avec SoftwareServo
+RCReceiver recepteur(8, 4);
 
 //definition des vartiables global
 const unsigned char constante_moyenne_glissante = 50 ;
-unsigned char i = 0;
-int valeursX[constante_moyenne_glissante];
-int valeursY[constante_moyenne_glissante];
-float somme[2] ;    //0 pour x et 1 pour y
+//moyennes glissantes des angles en degres entiers, somme entiere
+//(une puissance de 2, 32 ou 64, permet le decalage dans getRoundedAverage)
+RunningAverageT<int, constante_moyenne_glissante> moyenneX;
+RunningAverageT<int, constante_moyenne_glissante> moyenneY;
 float angles[2] ;    //0 pour x et 1 pour y 
 unsigned long loop_timer = 0;
 
@@ -31,10 +27,17 @@ int signals_telecomande[4];
 float batterie_tension[3];
 unsigned char compteur_donne_recu = 1;
 
-//Declare mes moteurs avec la librairie Servo
-Servo ESC;
-Servo Servo1;
-Servo Servo2;
+//Declare mes moteurs : impulsions sur interruption du Timer1, trames de 20 ms
+//(SoftwareServo::setFrameRate(400) pour un ESC qui accepte 400 Hz, les servos
+//restant a 50 Hz avec setRate(50))
+SoftwareServo ESC;
+SoftwareServo Servo1;
+SoftwareServo Servo2;
+
+//Elevons : tangage (voie 0, inverse, +-amplitude degres) et roulis (voie 1, +-amplitude2)
+//melanges directement en microsecondes, 80 degres de debattement autour de 80 degres
+//(544 + 1856 * angle / 180 us comme Servo.write)
+ServoMixer mixeur;
 
 //fonction qui met a jour les valuers d'angles X et Y
 void update_angles()
@@ -56,16 +59,10 @@ void update_angles()
   AcTotal = sqrt(AcX*AcX + AcZ*AcZ + AcY*AcY);
   AcXangle = asin(AcX/AcTotal) * 57.296 ;
   AcYangle = asin(AcY/AcTotal) * -57.296 ;
-  somme[0]-=valeursY[i];
-  somme[1]-=valeursX[i];
-  valeursX[i] = AcXangle ;
-  valeursY[i] = AcYangle ; 
-  somme[1]+= valeursX[i];
-  somme[0]+= valeursY[i];
-  angles[0] = somme[1] / constante_moyenne_glissante; // constante_moyenne_glissante
-  angles[1] = somme[0] / constante_moyenne_glissante; // constante_moyenne_glissante
-  i++;
-  if(i == constante_moyenne_glissante ) i = 0 ;
+  moyenneX.addValue(AcXangle);
+  moyenneY.addValue(AcYangle);
+  angles[0] = moyenneX.getAverage();
+  angles[1] = moyenneY.getAverage();
 }
 
 void update_batterie()
@@ -94,12 +91,16 @@ void setup(){
   ESC.attach(5);
   Servo1.attach(6);
   Servo2.attach(7);
+  for(byte n = 0; n < 2; n++) mixeur.setOutput(n, 544, 1369, 2194);
+  mixeur.setMix(0, -amplitude / 80, amplitude2 / 80);
+  mixeur.setMix(1, -amplitude / 80, -amplitude2 / 80);
     
-  //On utilise la fonction déclaré precedement pour initaliser les interuptions sur les pin suivants
-  pciSetup(10);
-  pciSetup(8);
-  pciSetup(9);
-  pciSetup(11);
+  //Telecommande : valeurs de securite gouvernes au neutre, gaz coupes
+  recepteur.setFailsafe(0, 1500);
+  recepteur.setFailsafe(1, 1500);
+  recepteur.setFailsafe(2, 1000);
+  recepteur.setFailsafe(3, 1500);
+  recepteur.begin(RC_RECEIVER_TIMER1);
 
   loop_timer = micros();
 }
@@ -110,39 +111,24 @@ void loop(){
   //update_angles();
   //update_batterie();
 
+  //Dernieres impulsions de la telecommande
+  recepteur.update();
+  for(byte n = 0; n < 4; n++) signals_telecomande[n] = recepteur.width(n) ;
+
   //Calcul position servo par raport au gyro
   consigne_moteur[0] = signals_telecomande[2];
   if (consigne_moteur[0] < 1030) consigne_moteur[0] = 1000 ; 
-  consigne_moteur[1] = map(signals_telecomande[0]-1000, 0, 1000, amplitude, -amplitude);  
-  consigne_moteur[2] = map(signals_telecomande[1]-1000, 0, 1000, -amplitude2, amplitude2);  
-
-  float erreur_x = consigne_moteur[2];// - angles[1] ;   //Pour l'axe haut bas 
-  float erreur_y = consigne_moteur[1];// - angles[0] ;   //Pour le tangage
-  
-    
+  mixeur.mix(signals_telecomande[0], signals_telecomande[1]);
   
   //On fait tourner les moteurs comme il le faut
   ESC.writeMicroseconds(signals_telecomande[2]-30);
-  Servo1.write(erreur_y + erreur_x+80);
-  Servo2.write(erreur_y - erreur_x+80);
+  mixeur.write(Servo1, Servo2);
 }
 
 
 
-//fonction qui met a jour les signaux d'entrée de la télécomande apr détéction d'interuption sur les pins du port B
-ISR (PCINT0_vect) // handle pin change interrupt for D8 to D13 here
- {    curentTime = micros();
-
- for(int n=0 ; n <4; n++){
-     if(digitalRead(n+8)==1){
-      if(etatSignal[n]==0){
-        etatSignal[n] = 1 ;
-        timer[n] = curentTime ;
-      }
-     }
-     else if(etatSignal[n]==1){
-      etatSignal[n] = 0 ;
-      signals_telecomande[n] = micros()-timer[n] ;
-     }
-  } 
- }
+//front sur une des pins 8 a 13 : une seule lecture du port pour les 4 voies
+ISR (PCINT0_vect)
+{
+  recepteur.handleInterrupt(PINB);
+}
@@ -1,12 +1,15 @@
 //
 //    FILE: FRAM.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.0
+// VERSION: 0.2.1
 // PURPOSE: Class for FRAM memory
 //     URL:
 //
 // HISTORY:
 // 0.1.0 initial version
+// 0.2.0 2026-10-18 write and read streams, typed records (append);
+//                  write() / read() use them, Wire buffer sized chunks
+// 0.2.1 2026-10-18 write() returns the endWrite() status
 //
 
 #include "FRAM.h"
@@ -18,9 +21,10 @@
 // PUBLIC
 //
 FRAM::FRAM()
+  : _position(0), _pending(0), _status(FRAM_OK)
 {}
 
-int FRAM::begin(int address = 0X50)
+int FRAM::begin(const int address)
 {
   if (address < 0x50 || address > 0x57)
   {
@@ -62,22 +66,11 @@ void FRAM::write32(uint16_t memaddr, uint32_t value)
   writeBlock(memaddr, (uint8_t *)&val, 4);
 }
 
-void FRAM::write(uint16_t memaddr, uint8_t * obj, uint16_t size)
+int FRAM::write(uint16_t memaddr, const uint8_t * obj, uint16_t size)
 {
-  const int blocksize = 24;
-  uint8_t * p = obj;
-  while (size >= blocksize)
-  {
-    writeBlock(memaddr, p, blocksize);
-    memaddr += blocksize;
-    p += blocksize;
-    size -= blocksize;
-  }
-  // remaining
-  if (size > 0)
-  {
-    writeBlock(memaddr, p, size);
-  }
+  beginWrite(memaddr);
+  writeNext(obj, size);
+  return endWrite();
 }
 
 uint8_t FRAM::read8(uint16_t memaddr)
@@ -103,18 +96,71 @@ uint32_t FRAM::read32(uint16_t memaddr)
 
 void FRAM::read(uint16_t memaddr, uint8_t * obj, uint16_t size)
 {
-  const int blocksize = 24;
-  uint8_t * p = obj;
-  while (size >= blocksize)
+  beginRead(memaddr);
+  readNext(obj, size);
+}
+
+void FRAM::beginWrite(uint16_t memaddr)
+{
+  _position = memaddr;
+  _pending = 0;
+  _status = FRAM_OK;
+}
+
+void FRAM::writeNext(const uint8_t * obj, uint16_t size)
+{
+  while (size > 0)
   {
-    readBlock(memaddr, p, blocksize);
-    memaddr += blocksize;
-    p += blocksize;
-    size -= blocksize;
+    if (_pending == 0)
+    {
+      Wire.beginTransmission(_address);
+      Wire.write(_position >> 8);
+      Wire.write(_position & 0xFF);
+    }
+    uint8_t n = FRAM_WRITE_CHUNK - _pending;
+    if (n > size) n = size;
+    Wire.write(obj, n);
+    obj += n;
+    size -= n;
+    _position += n;
+    _pending += n;
+    if (_pending == FRAM_WRITE_CHUNK) closeWrite();
   }
-  if (size > 0)
+}
+
+int FRAM::endWrite()
+{
+  if (_pending > 0) closeWrite();
+  return _status;
+}
+
+void FRAM::beginRead(uint16_t memaddr)
+{
+  Wire.beginTransmission(_address);
+  Wire.write(memaddr >> 8);
+  Wire.write(memaddr & 0xFF);
+  Wire.endTransmission();
+  _position = memaddr;
+}
+
+// current address reads: no address phase, the FRAM carries on
+void FRAM::readNext(uint8_t * obj, uint16_t size)
+{
+  while (size > 0)
   {
-    readBlock(memaddr, p, size);
+    uint8_t n = size > FRAM_READ_CHUNK ? FRAM_READ_CHUNK : size;
+#ifdef WIRE_HAS_BUFFER_READ
+    Wire.requestFrom((uint8_t)_address, obj, n);
+#else
+    Wire.requestFrom((uint8_t)_address, n);
+    for (uint8_t i = 0; i < n; i++)
+    {
+      obj[i] = Wire.read();
+    }
+#endif
+    obj += n;
+    size -= n;
+    _position += n;
   }
 }
 
@@ -149,17 +195,12 @@ uint16_t FRAM::getProductID()
 //
 // PRIVATE
 //
-void FRAM::writeBlock(uint16_t memaddr, uint8_t * obj, uint16_t size)
+void FRAM::writeBlock(uint16_t memaddr, const uint8_t * obj, uint16_t size)
 {
-  // TODO constrain size < 30 ??
   Wire.beginTransmission(_address);
   Wire.write(memaddr >> 8);
   Wire.write(memaddr & 0xFF);
-  uint8_t * p = obj;
-  for (uint8_t i = 0; i < size; i++)
-  {
-    Wire.write(*p++);
-  }
+  Wire.write(obj, size);
   Wire.endTransmission();
 }
 
@@ -177,4 +218,11 @@ void FRAM::readBlock(uint16_t memaddr, uint8_t * obj, uint16_t size)
   }
 }
 
+void FRAM::closeWrite()
+{
+  int rv = Wire.endTransmission();
+  if (rv != 0 && _status == FRAM_OK) _status = rv;
+  _pending = 0;
+}
+
 // END OF FILE
\ No newline at end of file
@@ -1,7 +1,7 @@
 //
 //    FILE: FRAM.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.0
+// VERSION: 0.2.1
 // PURPOSE: Class for FRAM memory
 //     URL:
 //
@@ -15,28 +15,65 @@
 #include "Arduino.h"
 #include "Wire.h"
 
-#define FRAM_LIB_VERSION (F("0.1.0"))
+#define FRAM_LIB_VERSION (F("0.2.1"))
 
 #define FRAM_OK               0
 #define FRAM_ERROR_ADDR       -10
 
+// data bytes per write transaction: Wire's buffer less the address
+#define FRAM_WRITE_CHUNK      (BUFFER_LENGTH - 2)
+// bytes per read transaction, straight into the caller's buffer if
+// Wire can do that
+#ifdef WIRE_HAS_BUFFER_READ
+#define FRAM_READ_CHUNK       255
+#else
+#define FRAM_READ_CHUNK       BUFFER_LENGTH
+#endif
+
 class FRAM
 {
 public:
   FRAM();
 
-  int   begin(const int address);  // defaults to 0x50
+  int   begin(const int address = 0x50);
 
   void  write8(uint16_t memaddr, uint8_t value);
   void  write16(uint16_t memaddr, uint16_t value);
   void  write32(uint16_t memaddr, uint32_t value);
-  void  write(uint16_t memaddr, uint8_t * obj, uint16_t size);
+  // FRAM_OK or the Wire status of the first failed transaction
+  int   write(uint16_t memaddr, const uint8_t * obj, uint16_t size);
 
   uint8_t  read8(uint16_t memaddr);
   uint16_t read16(uint16_t memaddr);
   uint32_t read32(uint16_t memaddr);
   void     read(uint16_t memaddr, uint8_t * obj, uint16_t size);
 
+  // Streams. A FRAM has no write cycle and its address counter runs on
+  // from one transaction to the next, so the address is only sent when
+  // a stream starts (and, for writes, when Wire's buffer is full and the
+  // next transaction opens where the last one ended).
+  // The write transaction stays open between writeNext() calls: no other
+  // Wire transfer until endWrite(), which returns FRAM_OK or the first
+  // Wire error. Reads may be interleaved with other devices, not with
+  // other accesses to this FRAM.
+  void     beginWrite(uint16_t memaddr);
+  void     writeNext(const uint8_t * obj, uint16_t size);
+  int      endWrite();
+  void     beginRead(uint16_t memaddr);
+  void     readNext(uint8_t * obj, uint16_t size);
+  // address the stream has reached
+  uint16_t position() { return _position; };
+
+  // typed records, e.g. log entries, one after the other in a stream
+  template <class T> void append(const T & record)
+  {
+    writeNext((const uint8_t *)&record, sizeof(T));
+  };
+  template <class T> void readNext(T & record)
+  {
+    readNext((uint8_t *)&record, sizeof(T));
+  };
+
   uint16_t getManufacturerID();
   uint16_t getProductID();
   uint16_t getSize() { return _size; };
@@ -45,8 +82,13 @@ private:
   int8_t    _address;
   uint16_t  _size;   // unknown
 
-  void writeBlock(uint16_t memaddr, uint8_t * obj, uint16_t size);
+  uint16_t  _position;
+  uint8_t   _pending;  // bytes in the open write transaction
+  int       _status;
+
+  void writeBlock(uint16_t memaddr, const uint8_t * obj, uint16_t size);
   void readBlock(uint16_t memaddr, uint8_t * obj, uint16_t size);
+  void closeWrite();
 };
 
 #endif
@@ -0,0 +1,193 @@
+//
+//    FILE: FRAMStreaming.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: FRAM throughput, byte by byte, bulk and streamed
+//    DATE: 2026-10-18
+//     URL:
+//
+// Released to the public domain
+//
+// At 100 and 400 kHz, for 1 KB:
+//   write8 / read8    one transaction per byte
+//   write / read      bulk, Wire buffer sized transactions
+//   append / next     16 byte records logged one by one in one write
+//                     stream, read back in one read stream
+//   per record        the same records with write() / read() each
+// Prints the time, KB/s and the bytes that did not read back.
+//
+// On the host: build/FRAMStreaming --virtual --fram 32
+// At 400 kHz, BUFFER_LENGTH 32 (KB/s, 0.1.0 -> 0.2.0):
+//   write        38.3 -> 39.1    30 instead of 24 bytes per address phase
+//   read         36.6 -> 43.0    one address phase, 255 byte transactions
+//   per record   36.2 / 34.0     append 39.1, next 40.3
+//   write8        10.3, read8 8.0
+// 1 KB is 23 ms on a 400 kHz bus, 43.4 KB/s at best; a larger
+// BUFFER_LENGTH brings writes closer to it.
+//
+
+#include "FRAM.h"
+
+FRAM fram;
+
+#define TEST_SIZE   1024
+#define TEST_START  4096
+
+struct Sample
+{
+  uint32_t time;
+  int16_t  accel[3];
+  int16_t  gyro[3];
+};
+
+uint8_t data[TEST_SIZE];
+
+void report(const char * name, uint32_t duration, uint16_t errors)
+{
+  Serial.print(name);
+  Serial.print("\t");
+  Serial.print(duration);
+  Serial.print("\t");
+  Serial.print(TEST_SIZE * 1e6 / 1024 / duration, 1);
+  Serial.print("\t");
+  Serial.println(errors);
+}
+
+uint16_t check()
+{
+  uint16_t errors = 0;
+  for (uint16_t i = 0; i < TEST_SIZE; i++)
+  {
+    if (data[i] != (uint8_t)(i * 7)) errors++;
+  }
+  return errors;
+}
+
+void fill()
+{
+  for (uint16_t i = 0; i < TEST_SIZE; i++) data[i] = i * 7;
+}
+
+void clear()
+{
+  memset(data, 0, TEST_SIZE);
+  fram.write(TEST_START, data, TEST_SIZE);
+}
+
+void testBytes()
+{
+  fill();
+  uint32_t start = micros();
+  for (uint16_t i = 0; i < TEST_SIZE; i++) fram.write8(TEST_START + i, data[i]);
+  uint32_t writeTime = micros() - start;
+
+  memset(data, 0, TEST_SIZE);
+  start = micros();
+  for (uint16_t i = 0; i < TEST_SIZE; i++) data[i] = fram.read8(TEST_START + i);
+  uint32_t readTime = micros() - start;
+
+  uint16_t errors = check();
+  report("write8", writeTime, errors);
+  report("read8", readTime, errors);
+}
+
+void testBulk()
+{
+  clear();
+  fill();
+  uint32_t start = micros();
+  fram.write(TEST_START, data, TEST_SIZE);
+  uint32_t writeTime = micros() - start;
+
+  memset(data, 0, TEST_SIZE);
+  start = micros();
+  fram.read(TEST_START, data, TEST_SIZE);
+  uint32_t readTime = micros() - start;
+
+  uint16_t errors = check();
+  report("write", writeTime, errors);
+  report("read", readTime, errors);
+}
+
+void testRecords(bool stream)
+{
+  clear();
+  fill();
+  const uint16_t records = TEST_SIZE / sizeof(Sample);
+  Sample * sample = (Sample *)data;
+
+  uint32_t start = micros();
+  if (stream)
+  {
+    fram.beginWrite(TEST_START);
+    for (uint16_t i = 0; i < records; i++) fram.append(sample[i]);
+    fram.endWrite();
+  }
+  else
+  {
+    for (uint16_t i = 0; i < records; i++)
+    {
+      fram.write(TEST_START + i * sizeof(Sample), (uint8_t *)&sample[i], sizeof(Sample));
+    }
+  }
+  uint32_t writeTime = micros() - start;
+
+  memset(data, 0, TEST_SIZE);
+  start = micros();
+  if (stream)
+  {
+    fram.beginRead(TEST_START);
+    for (uint16_t i = 0; i < records; i++) fram.readNext(sample[i]);
+  }
+  else
+  {
+    for (uint16_t i = 0; i < records; i++)
+    {
+      fram.read(TEST_START + i * sizeof(Sample), (uint8_t *)&sample[i], sizeof(Sample));
+    }
+  }
+  uint32_t readTime = micros() - start;
+
+  uint16_t errors = check();
+  report(stream ? "append" : "write/rec", writeTime, errors);
+  report(stream ? "next" : "read/rec", readTime, errors);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("FRAM_LIB_VERSION: ");
+  Serial.println(FRAM_LIB_VERSION);
+  Serial.print("FRAM_WRITE_CHUNK: ");
+  Serial.println(FRAM_WRITE_CHUNK);
+  Serial.print("FRAM_READ_CHUNK: ");
+  Serial.println(FRAM_READ_CHUNK);
+
+  int rv = fram.begin(0x50);
+  if (rv != FRAM_OK)
+  {
+    Serial.println(rv);
+    return;
+  }
+
+  for (uint8_t s = 0; s < 2; s++)
+  {
+#ifdef TWBR
+    TWBR = s == 0 ? 72 : 12;    // 100 kHz, 400 kHz
+#endif
+    Serial.println(s == 0 ? "\n100 kHz" : "\n400 kHz");
+    Serial.println("test\tus\tKB/s\terrors");
+    testBytes();
+    testBulk();
+    testRecords(false);
+    testRecords(true);
+  }
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
@@ -1,11 +1,13 @@
 //
 //    FILE: FastMap.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.8
+// VERSION: 0.1.10
 // PURPOSE: class with fast map function - library for Arduino
 //     URL: http://forum.arduino.cc/index.php?topic=276194
 //
 // HISTORY:
+// 0.1.10 2026-10-18 FastMapInt::MAX_ERROR, the error bound with FACTOR rounded
+// 0.1.9  2026-10-18 added FastMapInt, integer map with compile time coefficients
 // 0.1.8  2017-07-27 revert double to float (issue 33)
 // 0.1.7  2017-04-28 cleaned up, get examples working again
 // 0.1.06 2015-03-08 replaced float by float (support ARM)
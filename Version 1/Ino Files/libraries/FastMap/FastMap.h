@@ -1,7 +1,7 @@
 //
 //    FILE: FastMap.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.8
+// VERSION: 0.1.10
 // PURPOSE: class with fast map function - library for Arduino
 //     URL: http://forum.arduino.cc/index.php?topic=276194
 //
@@ -18,7 +18,7 @@
 #include <Arduino.h>
 #endif
 
-#define FASTMAP_LIB_VERSION (F("0.1.8"))
+#define FASTMAP_LIB_VERSION (F("0.1.10"))
 
 class FastMap
 {
@@ -40,6 +40,82 @@ private:
     float _backfactor, _backbase;
 };
 
+
+// compile time arithmetic of FastMapInt
+namespace FastMapIntMath
+{
+    // out / in with s fraction bits, rounded
+    constexpr int64_t factor(const int32_t in, const int32_t out, const uint8_t s)
+    {
+        return ((int64_t)out * ((int64_t)1 << s) + (out < 0 ? -1 : 1) * (int64_t)(in < 0 ? -in : in) / 2) / in;
+    }
+
+    // the most fraction bits, up to s, that keep |factor| <= limit
+    constexpr uint8_t shift(const int32_t in, const int32_t out, const int32_t limit, const uint8_t s)
+    {
+        return s == 0 || (factor(in, out, s) <= limit && factor(in, out, s) >= -limit) ? s : shift(in, out, limit, s - 1);
+    }
+
+    // how far |in| steps of factor f drift from out, in output units
+    constexpr float drift(const int32_t in, const int32_t out, const int64_t f, const uint8_t s)
+    {
+        return (float)(f * in - (int64_t)out * ((int64_t)1 << s) < 0 ? (int64_t)out * ((int64_t)1 << s) - f * in
+                                                                     : f * in - (int64_t)out * ((int64_t)1 << s)) / ((int64_t)1 << s);
+    }
+}
+
+// Integer map with the coefficients folded at compile time:
+//
+//   FastMapInt<1000, 2000, 544, 2400>::map(us)
+//
+// is outMin + ((value - inMin) * FACTOR + HALF) >> SHIFT, FACTOR the
+// slope in fixed point with as many fraction bits as fit. The product is
+// a 16 x 16 bit multiply, the cheap one on AVR, when twice the input
+// range fits in 16 bits and a 16 bit FACTOR still leaves the error under
+// a quarter; otherwise 32 x 32. The result is rounded to the nearest
+// integer, where map() truncates. FACTOR is rounded as well, so the
+// error is not quite 0.5: MAX_ERROR is the bound for inputs in
+// [inMin, inMax], 0.518 for the example above. Values may lie up to one
+// input range outside, the excess over 0.5 growing with the distance
+// from inMin. Everything is constexpr: a constant input folds to a
+// constant, e.g. in a static_assert.
+template <int32_t IN_MIN, int32_t IN_MAX, int32_t OUT_MIN, int32_t OUT_MAX>
+class FastMapInt
+{
+public:
+    static_assert(IN_MIN != IN_MAX, "FastMapInt needs an input range");
+
+    static constexpr int32_t map(const int32_t value)
+    {
+        return OUT_MIN + (int32_t)((product(value - IN_MIN) + HALF) >> SHIFT);
+    }
+
+    static constexpr int32_t constrainedMap(const int32_t value)
+    {
+        return (IN_MIN < IN_MAX ? value <= IN_MIN : value >= IN_MIN) ? OUT_MIN :
+               (IN_MIN < IN_MAX ? value >= IN_MAX : value <= IN_MAX) ? OUT_MAX : map(value);
+    }
+
+    static constexpr int32_t IN_RANGE  = IN_MAX - IN_MIN;
+    static constexpr int32_t OUT_RANGE = OUT_MAX - OUT_MIN;
+    static constexpr int32_t SPAN      = 2 * (IN_RANGE < 0 ? -IN_RANGE : IN_RANGE);
+    static constexpr bool    SHORT     = SPAN <= 32767 &&
+                                         ((int32_t)1 << FastMapIntMath::shift(IN_RANGE, OUT_RANGE, 32767, 30)) >= SPAN;
+    // largest |FACTOR| for which the product cannot overflow
+    static constexpr int32_t LIMIT     = SHORT ? 32767 : 0x3FFFFFFF / SPAN;
+    static constexpr uint8_t SHIFT     = FastMapIntMath::shift(IN_RANGE, OUT_RANGE, LIMIT, 30);
+    static constexpr int32_t FACTOR    = (int32_t)FastMapIntMath::factor(IN_RANGE, OUT_RANGE, SHIFT);
+    static constexpr int32_t HALF      = SHIFT ? (int32_t)1 << (SHIFT - 1) : 0;
+    // worst distance from the exact value over [inMin, inMax]
+    static constexpr float   MAX_ERROR = 0.5 + FastMapIntMath::drift(IN_RANGE, OUT_RANGE, FACTOR, SHIFT);
+
+private:
+    static constexpr int32_t product(const int32_t d)
+    {
+        return SHORT ? (int32_t)(int16_t)d * (int16_t)FACTOR : d * FACTOR;
+    }
+};
+
 #endif
 
 // END OF FILE
\ No newline at end of file
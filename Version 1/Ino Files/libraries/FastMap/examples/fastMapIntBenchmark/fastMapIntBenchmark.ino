@@ -0,0 +1,113 @@
+//
+//    FILE: fastMapIntBenchmark.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.1
+// PURPOSE: FastMapInt against FastMap and map()
+//    DATE: 2026-10-18
+//     URL:
+//
+// Released to the public domain
+//
+// For a few mappings used around the flight sketches: us per call of
+// map(), FastMap::map() (float) and FastMapInt::map() over the whole
+// input range, and the worst error of each against the exact value.
+// FastMapInt rounds, map() truncates, so map() is off by up to 1.
+// FastMapInt's FACTOR is rounded too, which can put it a little over
+// 0.5; the bound column is its MAX_ERROR, which it must stay within.
+//
+// On the host: build/fastMapIntBenchmark --bare --loops 1
+// times the host in real time, for the ratios only; with --virtual the
+// calls take no time at all. There map() costs about 7 ns, FastMap
+// about 3 and FastMapInt about 1.
+//
+
+#include "FastMap.h"
+
+#ifdef __AVR__
+#define PASSES 1
+#else
+#define PASSES 1000 // the host needs more to get past micros() resolution
+#endif
+
+// a constant input is folded at compile time
+static_assert(FastMapInt<1000, 2000, -500, 500>::map(1750) == 250, "FastMapInt");
+
+volatile int32_t sink;
+volatile int32_t first;     // keeps the compiler from folding the loops
+
+template <int32_t IN_MIN, int32_t IN_MAX, int32_t OUT_MIN, int32_t OUT_MAX>
+void bench(const char * name)
+{
+  typedef FastMapInt<IN_MIN, IN_MAX, OUT_MIN, OUT_MAX> Fast;
+  FastMap mapper;
+  mapper.init(IN_MIN, IN_MAX, OUT_MIN, OUT_MAX);
+  int32_t low = min(IN_MIN, IN_MAX);
+  int32_t high = max(IN_MIN, IN_MAX);
+  float calls = (float)(high - low + 1) * PASSES;
+
+  uint32_t start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (int32_t v = first + low; v <= high; v++) sink = map(v, IN_MIN, IN_MAX, OUT_MIN, OUT_MAX);
+  uint32_t mapTime = micros() - start;
+
+  start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (int32_t v = first + low; v <= high; v++) sink = mapper.map(v);
+  uint32_t floatTime = micros() - start;
+
+  start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (int32_t v = first + low; v <= high; v++) sink = Fast::map(v);
+  uint32_t intTime = micros() - start;
+
+  // worst error against the exact value, FastMap rounded like FastMapInt
+  float mapError = 0, floatError = 0, intError = 0;
+  for (int32_t v = low; v <= high; v++)
+  {
+    float exact = OUT_MIN + (float)(v - IN_MIN) * (OUT_MAX - OUT_MIN) / (IN_MAX - IN_MIN);
+    mapError = max(mapError, fabs(map(v, IN_MIN, IN_MAX, OUT_MIN, OUT_MAX) - exact));
+    floatError = max(floatError, fabs(lround(mapper.map(v)) - exact));
+    intError = max(intError, fabs(Fast::map(v) - exact));
+  }
+
+  Serial.print(name);
+  Serial.print("\t");
+  Serial.print(mapTime / calls, 3);
+  Serial.print("\t");
+  Serial.print(floatTime / calls, 3);
+  Serial.print("\t");
+  Serial.print(intTime / calls, 3);
+  Serial.print("\t");
+  Serial.print(mapError, 2);
+  Serial.print("\t");
+  Serial.print(floatError, 2);
+  Serial.print("\t");
+  Serial.print(intError, 3);
+  Serial.print("\t");
+  Serial.print(Fast::MAX_ERROR, 3);
+  Serial.print(intError <= Fast::MAX_ERROR ? "\t" : "!\t");
+  Serial.print(Fast::SHORT ? "16x16 >> " : "32x32 >> ");
+  Serial.println(Fast::SHIFT);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("FASTMAP_LIB_VERSION: ");
+  Serial.println(FASTMAP_LIB_VERSION);
+
+  Serial.println("\n\t\tus per call\t\tworst error\n\t\tmap\tfloat\tint\tmap\tfloat\tint\tbound\tFastMapInt");
+  bench<1000, 2000, 544, 2400>("rc -> servo");
+  bench<1000, 2000, 2000, 1000>("rc reversed");
+  bench<1000, 2000, -450, 450>("rc -> angle");
+  bench<0, 1023, 0, 255>("adc -> 8 bit");
+  bench<0, 1023, 20000, 3000>("adc -> 20000");
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
@@ -0,0 +1,126 @@
+//
+//    FILE: FixedAttitude.cpp
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: integer attitude math for AVR: isqrt, atan2 and a complementary filter
+//
+// HISTORY:
+// 0.1.0 - 2026-10-17 initial version
+//
+// Released to the public domain
+//
+
+#include "FixedAttitude.h"
+
+// atan(i / 64) in BAM for i = 0..64, 0 .. 45 degrees
+static const uint16_t atanTable[65] PROGMEM =
+{
+      0,   163,   326,   489,   651,   813,   975,  1136,
+   1297,  1457,  1617,  1775,  1933,  2090,  2246,  2401,
+   2555,  2708,  2860,  3010,  3159,  3307,  3453,  3599,
+   3742,  3884,  4025,  4164,  4302,  4438,  4572,  4705,
+   4836,  4966,  5094,  5220,  5344,  5467,  5589,  5708,
+   5826,  5943,  6058,  6171,  6282,  6392,  6500,  6607,
+   6712,  6815,  6917,  7018,  7117,  7214,  7310,  7405,
+   7498,  7589,  7679,  7768,  7856,  7942,  8026,  8110,
+   8192
+};
+
+uint16_t isqrt32(uint32_t v)
+{
+  // bit by bit, two bits of v per bit of the root
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > v) bit >>= 2;
+  while (bit != 0)
+  {
+    if (v >= root + bit)
+    {
+      v -= root + bit;
+      root = (root >> 1) + bit;
+    }
+    else
+    {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint16_t)root;
+}
+
+// atan(num / den) for 0 <= num <= den, den > 0
+static uint16_t atanOctant(uint32_t num, uint32_t den)
+{
+  // bring den into 16 bits so the ratio is a 32 / 16 bit division
+  while (den > 0xFFFF)
+  {
+    num >>= 1;
+    den >>= 1;
+  }
+  uint16_t ratio = (uint16_t)((num << 14) / den);    // 0 .. 16384
+  uint8_t idx = ratio >> 8;
+  uint8_t frac = ratio & 0xFF;
+  uint16_t a = pgm_read_word(&atanTable[idx]);
+  if (frac == 0) return a;
+  uint16_t b = pgm_read_word(&atanTable[idx + 1]);
+  // steps are at most 163, so this fits 16 bits
+  return a + (((uint16_t)(b - a) * frac + 128) >> 8);
+}
+
+int16_t atan2BAM(int32_t y, int32_t x)
+{
+  uint32_t ax = (x < 0) ? -x : x;
+  uint32_t ay = (y < 0) ? -y : y;
+  if (ax == 0 && ay == 0) return 0;
+
+  uint16_t a;
+  if (ay <= ax) a = atanOctant(ay, ax);
+  else a = BAM_90 - atanOctant(ax, ay);
+
+  if (x < 0) a = 2 * BAM_90 - a;       // 32768 wraps to -180, fine
+  return (y < 0) ? -(int16_t)a : (int16_t)a;
+}
+
+int16_t bamToCentidegrees(int16_t angle)
+{
+  return (int16_t)(((int32_t)angle * 18000L + 16384) >> 15);
+}
+
+int16_t centidegreesToBAM(int16_t centidegrees)
+{
+  // 32768 / 18000 = 1.8204, as 29826 / 16384
+  return (int16_t)(((int32_t)centidegrees * 29826L + 8192) >> 14);
+}
+
+
+FixedAttitude::FixedAttitude(const uint8_t gyroLsbPerDps, const uint8_t gainShift)
+{
+  // 2^22 * 256 * (32768 / 180) / 1e6 = 195468.7, per LSB/dps
+  _rateGain = (195469UL + gyroLsbPerDps / 2) / gyroLsbPerDps;
+  _gainShift = gainShift;
+  _state = 0;
+}
+
+void FixedAttitude::setAngle(const int16_t angle)
+{
+  _state = (int32_t)angle << 8;
+}
+
+int16_t FixedAttitude::update(const int16_t accelAngle, const int16_t gyro, uint16_t dt)
+{
+  if (dt > FIXED_ATTITUDE_MAX_DT) dt = FIXED_ATTITUDE_MAX_DT;
+
+  // gyro * dt fits 31 bits up to 40 ms at full scale, the shifts keep
+  // the product with the gain in 31 bits too
+  int32_t rate = (((int32_t)gyro * dt) >> 13) * _rateGain;
+  _state += rate >> 9;
+
+  int16_t error = (int16_t)((uint16_t)accelAngle - (uint16_t)getAngle());
+  _state += ((int32_t)error << 8) >> _gainShift;
+
+  // keep 16 bits of angle, wrapping like BAM
+  _state = (int32_t)((uint32_t)_state << 8) >> 8;
+  return getAngle();
+}
+
+// END OF FILE
@@ -0,0 +1,72 @@
+//
+//    FILE: FixedAttitude.h
+//  AUTHOR: Keyrim
+// PURPOSE: integer attitude math for AVR: isqrt, atan2 and a complementary filter
+// VERSION: 0.1.0
+// HISTORY: See FixedAttitude.cpp
+//
+// Released to the public domain
+//
+// Angles are binary angles (BAM): an int16_t where 32768 is 180 degrees,
+// so they wrap around like angles do and differences need no fixup.
+// Nothing here uses float; see the examples for the accuracy against
+// the float versions.
+//
+
+#ifndef FixedAttitude_h
+#define FixedAttitude_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <inttypes.h>
+
+#define FIXED_ATTITUDE_LIB_VERSION "0.1.0"
+
+// 45 and 90 degrees
+#define BAM_45    8192
+#define BAM_90    16384
+
+// longest dt update() takes into account, at full scale gyro
+#define FIXED_ATTITUDE_MAX_DT 40000
+
+// integer square root, floor(sqrt(v))
+uint16_t isqrt32(uint32_t v);
+
+// angle of the vector (x, y), like atan2(y, x); error below 0.01 degree
+int16_t atan2BAM(int32_t y, int32_t x);
+
+// BAM to and from hundredths of a degree
+int16_t bamToCentidegrees(int16_t angle);
+int16_t centidegreesToBAM(int16_t centidegrees);
+
+
+// One axis complementary filter: integrates the gyro rate and pulls the
+// result towards the accelerometer angle by 1 / 2^gainShift per update.
+// With updates every T the accelerometer time constant is 2^gainShift * T.
+class FixedAttitude
+{
+public:
+  // gyroLsbPerDps: MPU-6050 sensitivity, 131 (250 dps) .. 16.4 (2000 dps)
+  // rounded down; larger values only cost precision
+  explicit FixedAttitude(const uint8_t gyroLsbPerDps = 131, const uint8_t gainShift = 6);
+
+  void    setAngle(const int16_t angle);
+  int16_t getAngle() const { return (int16_t)(_state >> 8); };
+  void    setGainShift(const uint8_t gainShift) { _gainShift = gainShift; };
+
+  // accelAngle in BAM, gyro in raw LSB, dt in microseconds;
+  // returns the new angle
+  int16_t update(const int16_t accelAngle, const int16_t gyro, uint16_t dt);
+
+private:
+  int32_t  _state;       // angle in BAM << 8
+  uint16_t _rateGain;    // (BAM << 8) per LSB per us, scaled by 2^22
+  uint8_t  _gainShift;
+};
+
+#endif
+// END OF FILE
@@ -0,0 +1,93 @@
+//
+//    FILE: fixedAttitudePerformance.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: time one attitude update, float atan2 + Kalman against FixedAttitude
+//
+// Released to the public domain
+//
+// One update is what update_angles() in Arduino.ino does per sample for
+// one axis: an accelerometer angle (square root and atan2) and one filter
+// step. Times are per update, in us and in cycles at F_CPU.
+//
+// The numbers that matter come from the board: the AVR does float in
+// software. Built on the host (make -C host build/fixedAttitudePerformance)
+// both paths run on an FPU and come out about even.
+//
+
+#include "FixedAttitude.h"
+#include "Kalman.h"
+
+const uint16_t RUNS = 10000;
+
+// raw samples, a slow tilt with a little of everything on every axis
+int16_t ax[16], ay[16], az[16], gy[16];
+
+volatile float floatSink;
+volatile int16_t fixedSink;
+
+uint32_t start;
+uint32_t stop;
+
+void printTime(const char *label, uint32_t us)
+{
+  Serial.print(label);
+  Serial.print((float)us / RUNS, 2);
+  Serial.print(" us\t");
+  Serial.print((float)us / RUNS * (F_CPU / 1000000L), 0);
+  Serial.println(" cycles");
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("FIXED_ATTITUDE_LIB_VERSION: ");
+  Serial.println(FIXED_ATTITUDE_LIB_VERSION);
+  Serial.println();
+
+  for (int i = 0; i < 16; i++)
+  {
+    float a = (i - 8) * 0.1;
+    ax[i] = -sin(a) * 16384;
+    ay[i] = 0.05 * 16384;
+    az[i] = cos(a) * 16384;
+    gy[i] = 131 * (i - 8);
+  }
+
+  Kalman kalman;
+  kalman.setAngle(0);
+  start = micros();
+  for (uint16_t n = 0; n < RUNS; n++)
+  {
+    uint8_t i = n & 15;
+    float angle = atan2(-ax[i], sqrt((float)ay[i] * ay[i] + (float)az[i] * az[i])) * RAD_TO_DEG;
+    floatSink = kalman.getAngle(angle, gy[i] / 131.0, 0.004);
+  }
+  stop = micros();
+  uint32_t floatTime = stop - start;
+
+  FixedAttitude fixed(131);
+  fixed.setAngle(0);
+  start = micros();
+  for (uint16_t n = 0; n < RUNS; n++)
+  {
+    uint8_t i = n & 15;
+    int16_t angle = atan2BAM(-ax[i], isqrt32((int32_t)ay[i] * ay[i] + (int32_t)az[i] * az[i]));
+    fixedSink = fixed.update(angle, gy[i], 4000);
+  }
+  stop = micros();
+  uint32_t fixedTime = stop - start;
+
+  printTime("float atan2 + Kalman\t", floatTime);
+  printTime("FixedAttitude\t\t", fixedTime);
+  Serial.print("ratio\t\t\t");
+  Serial.println((float)floatTime / fixedTime, 2);
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
@@ -0,0 +1,144 @@
+//
+//    FILE: fixedAttitudeTest.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: accuracy of FixedAttitude against the float math it replaces
+//
+// Released to the public domain
+//
+// 1. isqrt32 against sqrt
+// 2. atan2BAM against atan2, all around the circle and at MPU-6050 scale
+// 3. the whole pipeline, integer complementary filter against float
+//    atan2 + Kalman, on a simulated wobble with sensor noise
+//
+// Runs on the board too, but the float reference is the point: build it
+// on the host (make -C host build/fixedAttitudeTest).
+//
+
+#include "FixedAttitude.h"
+#include "Kalman.h"
+
+uint32_t seed = 1;
+
+// uniform in -1 .. 1
+float noise()
+{
+  seed = seed * 1103515245UL + 12345;
+  return ((int32_t)(seed >> 8) & 0xFFFF) / 32768.0 - 1;
+}
+
+void testSqrt()
+{
+  uint32_t errors = 0;
+  uint32_t v = 0;
+  for (uint32_t i = 0; i < 100000; i++)
+  {
+    v = v * 7 + 12345 + i;          // spread over the 32 bit range
+    uint32_t r = isqrt32(v);
+    if (r * r > v || (r < 65535 && (r + 1) * (r + 1) <= v)) errors++;
+  }
+  if (isqrt32(0xFFFFFFFF) != 65535) errors++;
+  Serial.print("isqrt32 errors:\t\t");
+  Serial.println(errors);
+}
+
+void testAtan2()
+{
+  float maxError = 0;
+  for (int i = 0; i < 3600; i++)
+  {
+    float a = i * PI / 1800;
+    for (int32_t r = 100; r <= 46000; r *= 3)
+    {
+      int32_t x = r * cos(a);
+      int32_t y = r * sin(a);
+      float ref = atan2((float)y, (float)x) * RAD_TO_DEG;
+      float fix = atan2BAM(y, x) * 180.0 / 32768;
+      float e = fabs(fix - ref);
+      if (e > 180) e = 360 - e;
+      if (e > maxError) maxError = e;
+    }
+  }
+  Serial.print("atan2BAM max error:\t");
+  Serial.print(maxError, 4);
+  Serial.println(" deg");
+}
+
+void testPipeline()
+{
+  const float amplitude = 30;       // deg
+  const float hz = 0.5;
+  const uint16_t dt = 4000;         // 250 Hz
+  const float dts = dt * 1e-6;
+
+  FixedAttitude fixed(131);
+  Kalman kalman;
+  float maxDiff = 0;
+  float sumDiff2 = 0;
+  float sumFixed2 = 0;
+  float sumFloat2 = 0;
+  uint32_t count = 0;
+
+  for (uint32_t n = 0; n < 250UL * 20; n++)
+  {
+    float t = n * dts;
+    float pitch = amplitude * sin(2 * PI * hz * t);
+    float rate = amplitude * 2 * PI * hz * cos(2 * PI * hz * t);
+    // raw MPU-6050 readings, 16384 LSB/g and 131 LSB/dps, with noise
+    int16_t ax = (-sin(pitch * DEG_TO_RAD) + 0.01 * noise()) * 16384;
+    int16_t ay = (0.01 * noise()) * 16384;
+    int16_t az = (cos(pitch * DEG_TO_RAD) + 0.01 * noise()) * 16384;
+    int16_t gy = (rate + 0.2 * noise()) * 131;
+
+    int16_t fixedAccel = atan2BAM(-ax, isqrt32((int32_t)ay * ay + (int32_t)az * az));
+    float floatAccel = atan2(-ax, sqrt((float)ay * ay + (float)az * az)) * RAD_TO_DEG;
+    float fixedAngle;
+    float floatAngle;
+    if (n == 0)
+    {
+      fixed.setAngle(fixedAccel);
+      kalman.setAngle(floatAccel);
+      continue;
+    }
+    fixedAngle = fixed.update(fixedAccel, gy, dt) * 180.0 / 32768;
+    floatAngle = kalman.getAngle(floatAccel, gy / 131.0, dts);
+
+    if (n < 250) continue;          // both settle in the first second
+    float d = fabs(fixedAngle - floatAngle);
+    if (d > maxDiff) maxDiff = d;
+    sumDiff2 += d * d;
+    sumFixed2 += (fixedAngle - pitch) * (fixedAngle - pitch);
+    sumFloat2 += (floatAngle - pitch) * (floatAngle - pitch);
+    count++;
+  }
+  Serial.print("pipeline vs float:\tmax ");
+  Serial.print(maxDiff, 3);
+  Serial.print(" deg\trms ");
+  Serial.print(sqrt(sumDiff2 / count), 3);
+  Serial.println(" deg");
+  Serial.print("error vs truth:\t\tfixed ");
+  Serial.print(sqrt(sumFixed2 / count), 3);
+  Serial.print(" deg\tfloat ");
+  Serial.print(sqrt(sumFloat2 / count), 3);
+  Serial.println(" deg rms");
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("FIXED_ATTITUDE_LIB_VERSION: ");
+  Serial.println(FIXED_ATTITUDE_LIB_VERSION);
+  Serial.println();
+
+  testSqrt();
+  testAtan2();
+  testPipeline();
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
@@ -0,0 +1,219 @@
+//
+//    FILE: FlightRecorder.cpp
+//  AUTHOR: Keyrim
+// VERSION: 0.1.2
+// PURPOSE: ring buffer flight data recorder on I2C EEPROM or FRAM
+//
+// HISTORY:
+// 0.1.0 - 2026-10-18 initial version
+// 0.1.1 - 2026-10-18 FlightRecorderFRAM returns the FRAM write status
+// 0.1.2 - 2026-10-18 dump() address buffer fits any 32 bit address
+//
+// Released to the public domain
+//
+
+#include "FlightRecorder.h"
+
+#include <string.h>
+#include <util/crc16.h>
+
+FlightRecorder::FlightRecorder(FlightRecorderStorage & storage)
+  : _storage(storage), _blocks(0), _next(0), _sequence(0),
+    _fill(0), _fillLength(0), _blockTime(0),
+    _flushing(false), _flushed(0), _flushAddress(0),
+    _frames(0), _dropped(0), _errors(0)
+{
+}
+
+bool FlightRecorder::begin()
+{
+  uint32_t blocks = _storage.size() / FLIGHT_RECORDER_BLOCK_SIZE;
+  _blocks = blocks > 0xFFFF ? 0xFFFF : blocks;
+  _fillLength = 0;
+  _flushing = false;
+  if (_blocks < 2)
+  {
+    _blocks = 0;
+    return false;
+  }
+
+  // blocks are written in sequence order from 0 up and around; the
+  // newest is the last one followed by the next sequence number
+  uint16_t newest = 0;
+  uint16_t sequence;
+  if (!readSequence(0, sequence))
+  {
+    _blocks = 0;
+    return false;
+  }
+  for (uint16_t block = 1; block < _blocks; block++)
+  {
+    uint16_t s;
+    if (!readSequence(block, s))
+    {
+      _blocks = 0;
+      return false;
+    }
+    if (s != (uint16_t)(sequence + 1)) break;
+    sequence = s;
+    newest = block;
+  }
+  _next = newest + 1 == _blocks ? 0 : newest + 1;
+  _sequence = sequence + 1;
+
+  return append(FLIGHT_RECORDER_START, NULL, 0, micros());
+}
+
+bool FlightRecorder::logImu(const uint8_t * registers, const uint32_t time)
+{
+  // drop TEMP_OUT_H/L between the accelerometer and the gyro
+  uint8_t payload[FLIGHT_RECORDER_IMU_SIZE];
+  memcpy(payload, registers, 6);
+  memcpy(payload + 6, registers + 8, 6);
+  return append(FLIGHT_RECORDER_IMU, payload, FLIGHT_RECORDER_IMU_SIZE, time);
+}
+
+bool FlightRecorder::logRc(const int16_t * channels, const uint32_t time)
+{
+  uint8_t payload[FLIGHT_RECORDER_RC_SIZE];
+  for (uint8_t i = 0; i < FLIGHT_RECORDER_RC_CHANNELS; i++)
+  {
+    payload[2 * i] = channels[i] & 0xFF;
+    payload[2 * i + 1] = channels[i] >> 8;
+  }
+  return append(FLIGHT_RECORDER_RC, payload, FLIGHT_RECORDER_RC_SIZE, time);
+}
+
+void FlightRecorder::update()
+{
+  if (!_flushing || !_storage.ready()) return;
+
+  uint32_t address = _flushAddress + _flushed;
+  uint8_t length = FLIGHT_RECORDER_BLOCK_SIZE - _flushed;
+  if (length > _storage.maxWrite()) length = _storage.maxWrite();
+  uint8_t page = _storage.pageSize();
+  if (page > 0 && length > page - address % page) length = page - address % page;
+
+  if (_storage.write(address, _buffer[1 - _fill] + _flushed, length) != 0)
+  {
+    _errors++;
+    return;
+  }
+  _flushed += length;
+  if (_flushed == FLIGHT_RECORDER_BLOCK_SIZE) _flushing = false;
+}
+
+void FlightRecorder::flush()
+{
+  // the buffer on its way first, then the one being filled
+  for (uint8_t pass = 0; pass < 2; pass++)
+  {
+    while (_flushing)
+    {
+      uint32_t errors = _errors;
+      update();
+      if (_errors != errors) return;   // the memory is gone
+    }
+    if (_fillLength > 0) seal();
+  }
+}
+
+void FlightRecorder::dump(Print & out)
+{
+  uint8_t line[32];
+  uint32_t size = (uint32_t)_storage.size();
+  for (uint32_t address = 0; address < size; address += sizeof(line))
+  {
+    uint16_t length = size - address < sizeof(line) ? size - address : sizeof(line);
+    if (_storage.read(address, line, length) != length) length = 0;
+    char hex[9];    // up to 8 digits, size() is 32 bit
+    sprintf(hex, "%06lX", (unsigned long)address);
+    out.print(hex);
+    out.print(' ');
+    for (uint16_t i = 0; i < length; i++)
+    {
+      if (line[i] < 0x10) out.print('0');
+      out.print(line[i], HEX);
+    }
+    out.println();
+  }
+}
+
+//////////////////////////////////////////////////////////////////
+//
+// PRIVATE
+//
+
+bool FlightRecorder::append(const uint8_t type, const uint8_t * payload, const uint8_t length, const uint32_t time)
+{
+  if (_blocks == 0) return false;
+
+  // the frame goes in the next block if it does not fit before the crc
+  // or its time is too far from the block's
+  if (_fillLength > 0
+      && (_fillLength + FLIGHT_RECORDER_FRAME_HEADER + length > FLIGHT_RECORDER_BLOCK_SIZE - 1
+          || time - _blockTime > 0xFFFF))
+  {
+    // the other buffer is still being written: the memory is too slow
+    // for this rate, drop the frame rather than wait
+    if (_flushing)
+    {
+      _dropped++;
+      return false;
+    }
+    seal();
+  }
+
+  uint8_t * block = _buffer[_fill];
+  if (_fillLength == 0)
+  {
+    _blockTime = time;
+    block[0] = _sequence & 0xFF;
+    block[1] = _sequence >> 8;
+    block[2] = time & 0xFF;
+    block[3] = (time >> 8) & 0xFF;
+    block[4] = (time >> 16) & 0xFF;
+    block[5] = time >> 24;
+    _fillLength = FLIGHT_RECORDER_HEADER_SIZE;
+  }
+
+  uint16_t offset = time - _blockTime;
+  uint8_t * frame = block + _fillLength;
+  frame[0] = type;
+  frame[1] = offset & 0xFF;
+  frame[2] = offset >> 8;
+  if (length > 0) memcpy(frame + FLIGHT_RECORDER_FRAME_HEADER, payload, length);
+  _fillLength += FLIGHT_RECORDER_FRAME_HEADER + length;
+  _frames++;
+  return true;
+}
+
+// hands the buffer being filled to update() and starts the other one
+void FlightRecorder::seal()
+{
+  uint8_t * block = _buffer[_fill];
+  memset(block + _fillLength, FLIGHT_RECORDER_END, FLIGHT_RECORDER_BLOCK_SIZE - _fillLength);
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < FLIGHT_RECORDER_BLOCK_SIZE - 1; i++) crc = _crc8_ccitt_update(crc, block[i]);
+  block[FLIGHT_RECORDER_BLOCK_SIZE - 1] = crc;
+
+  _flushAddress = (uint32_t)_next * FLIGHT_RECORDER_BLOCK_SIZE;
+  _flushed = 0;
+  _flushing = true;
+  _next = _next + 1 == _blocks ? 0 : _next + 1;
+  _sequence++;
+
+  _fill = 1 - _fill;
+  _fillLength = 0;
+}
+
+bool FlightRecorder::readSequence(const uint16_t block, uint16_t & sequence)
+{
+  uint8_t data[2];
+  while (!_storage.ready());
+  if (_storage.read((uint32_t)block * FLIGHT_RECORDER_BLOCK_SIZE, data, 2) != 2) return false;
+  sequence = data[0] | (data[1] << 8);
+  return true;
+}
+
+// END OF FILE
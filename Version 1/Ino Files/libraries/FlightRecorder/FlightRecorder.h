@@ -0,0 +1,133 @@
+//
+//    FILE: FlightRecorder.h
+//  AUTHOR: Keyrim
+// PURPOSE: ring buffer flight data recorder on I2C EEPROM or FRAM
+// VERSION: 0.1.2
+// HISTORY: See FlightRecorder.cpp
+//
+// Released to the public domain
+//
+// Frames (MPU-6050 samples, RC inputs) are packed in RAM into blocks of
+// FLIGHT_RECORDER_BLOCK_SIZE bytes. A full block is written by update(),
+// one page aligned write per call and only when the memory can take it
+// without waiting, so the loop never sits out an EEPROM write cycle.
+// Blocks go around the memory in a ring; begin() carries on after the
+// newest block, so the memory always holds the last flights.
+//
+// Block layout, little endian:
+//   0  uint16  sequence, +1 per block, finds the newest block
+//   2  uint32  micros() of the first frame
+//   6  frames  type, uint16 us after the block time, payload
+//      ...     type 0 ends the frames
+//   last       crc8 (ccitt) of the bytes before it
+//
+// The memory is read back with dump() (see examples/flightRecorderDump)
+// and decoded by host/replay/fdr_extract.
+//
+
+#ifndef FlightRecorder_h
+#define FlightRecorder_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <inttypes.h>
+
+#define FLIGHT_RECORDER_LIB_VERSION "0.1.2"
+
+// power of 2, a multiple of the EEPROM page or a divisor of it
+#ifndef FLIGHT_RECORDER_BLOCK_SIZE
+#define FLIGHT_RECORDER_BLOCK_SIZE    64
+#endif
+
+#define FLIGHT_RECORDER_HEADER_SIZE   6
+#define FLIGHT_RECORDER_FRAME_HEADER  3
+
+// frame types and their payload
+#define FLIGHT_RECORDER_END           0     // no more frames in the block
+#define FLIGHT_RECORDER_START         1     // begin() was called, a new flight
+#define FLIGHT_RECORDER_IMU           2     // MPU-6050 ACCEL_XOUT_H..ACCEL_ZOUT_L, GYRO_XOUT_H..GYRO_ZOUT_L
+#define FLIGHT_RECORDER_RC            3     // int16 per RC channel, us
+
+#define FLIGHT_RECORDER_IMU_SIZE      12
+#ifndef FLIGHT_RECORDER_RC_CHANNELS
+#define FLIGHT_RECORDER_RC_CHANNELS   4
+#endif
+#define FLIGHT_RECORDER_RC_SIZE       (2 * FLIGHT_RECORDER_RC_CHANNELS)
+
+
+// The memory behind the recorder, see FlightRecorderEeprom.h and
+// FlightRecorderFRAM.h
+class FlightRecorderStorage
+{
+public:
+  virtual uint32_t size() = 0;
+  // a write must not cross a multiple of pageSize(), 0 = no pages
+  virtual uint8_t  pageSize() = 0;
+  // largest write done in one bus transaction
+  virtual uint8_t  maxWrite() = 0;
+  // a write now would not wait for the memory
+  virtual bool     ready() = 0;
+  // 0 = OK
+  virtual int      write(const uint32_t address, const uint8_t * data, const uint8_t length) = 0;
+  // bytes read
+  virtual uint16_t read(const uint32_t address, uint8_t * data, const uint16_t length) = 0;
+};
+
+
+class FlightRecorder
+{
+public:
+  explicit FlightRecorder(FlightRecorderStorage & storage);
+
+  // finds the newest block and starts a flight after it;
+  // false if the memory does not answer or holds less than 2 blocks
+  bool begin();
+
+  // the 14 bytes read from ACCEL_XOUT_H (temperature is not kept),
+  // time is micros() of the sample; false if the frame was dropped
+  bool logImu(const uint8_t * registers, const uint32_t time);
+  bool logRc(const int16_t * channels, const uint32_t time);
+
+  // one write of a full block when the memory is ready, call it often
+  void update();
+  // writes everything, the current block too; blocks for the writes
+  void flush();
+
+  uint16_t blocks()  const { return _blocks; };
+  uint32_t frames()  const { return _frames; };
+  uint32_t dropped() const { return _dropped; };
+  uint32_t errors()  const { return _errors; };
+
+  // whole memory as hex lines, "address bytes", for fdr_extract
+  void dump(Print & out);
+
+private:
+  FlightRecorderStorage & _storage;
+  uint16_t _blocks;
+  uint16_t _next;             // block the next sealed buffer goes to
+  uint16_t _sequence;         // of the block being filled
+
+  uint8_t  _buffer[2][FLIGHT_RECORDER_BLOCK_SIZE];
+  uint8_t  _fill;             // buffer being filled
+  uint8_t  _fillLength;       // 0 = not started
+  uint32_t _blockTime;
+
+  bool     _flushing;         // the other buffer is on its way to the memory
+  uint8_t  _flushed;          // bytes of it written
+  uint32_t _flushAddress;
+
+  uint32_t _frames;
+  uint32_t _dropped;
+  uint32_t _errors;
+
+  bool append(const uint8_t type, const uint8_t * payload, const uint8_t length, const uint32_t time);
+  void seal();
+  bool readSequence(const uint16_t block, uint16_t & sequence);
+};
+
+#endif
+// END OF FILE
@@ -0,0 +1,62 @@
+//
+//    FILE: FlightRecorderEeprom.h
+//  AUTHOR: Keyrim
+// PURPOSE: FlightRecorder storage on an I2C_eeprom (24LC256 et al.)
+// VERSION: 0.1.0
+// HISTORY: See FlightRecorder.cpp
+//
+// Released to the public domain
+//
+// The EEPROM does not answer for about 5 ms after each write; ready()
+// tells the recorder when that time is over so that I2C_eeprom never
+// has to wait for it. That is the limit: with 32 byte pages and the 30
+// byte writes of I2C_eeprom a 64 byte block takes 4 write cycles, and
+// at 400 kHz a 24LC256 keeps up with about 130 IMU samples a second.
+// Log every other sample, or use a FRAM for 250 Hz.
+//
+
+#ifndef FlightRecorderEeprom_h
+#define FlightRecorderEeprom_h
+
+#include "FlightRecorder.h"
+#include "I2C_eeprom.h"
+
+// write cycle of the 24LC series, us
+#define FLIGHT_RECORDER_EEPROM_WRITE_CYCLE  5000
+
+class FlightRecorderEeprom : public FlightRecorderStorage
+{
+public:
+  // size in bytes; pageSize no larger than the one I2C_eeprom uses,
+  // which is 32 for parts above 2 KB, or it splits the writes again
+  FlightRecorderEeprom(I2C_eeprom & eeprom, const uint32_t size, const uint8_t pageSize)
+    : _eeprom(eeprom), _size(size), _pageSize(pageSize), _lastWrite(0), _written(false) {};
+
+  uint32_t size()     { return _size; };
+  uint8_t  pageSize() { return _pageSize; };
+  uint8_t  maxWrite() { return I2C_TWIBUFFERSIZE; };
+  bool     ready()    { return !_written || micros() - _lastWrite > FLIGHT_RECORDER_EEPROM_WRITE_CYCLE; };
+
+  int write(const uint32_t address, const uint8_t * data, const uint8_t length)
+  {
+    int rv = _eeprom.writeBlock(address, data, length);
+    _lastWrite = micros();
+    _written = true;
+    return rv;
+  };
+
+  uint16_t read(const uint32_t address, uint8_t * data, const uint16_t length)
+  {
+    return _eeprom.readBlock(address, data, length);
+  };
+
+private:
+  I2C_eeprom & _eeprom;
+  uint32_t _size;
+  uint8_t  _pageSize;
+  uint32_t _lastWrite;
+  bool     _written;
+};
+
+#endif
+// END OF FILE
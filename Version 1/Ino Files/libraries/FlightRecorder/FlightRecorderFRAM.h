@@ -0,0 +1,54 @@
+//
+//    FILE: FlightRecorderFRAM.h
+//  AUTHOR: Keyrim
+// PURPOSE: FlightRecorder storage on a FRAM (MB85RC256V et al.)
+// VERSION: 0.1.1
+// HISTORY: See FlightRecorder.cpp
+//
+// Released to the public domain
+//
+// A FRAM writes at bus speed and has no pages, the recorder is only
+// limited by the I2C clock: at 400 kHz a 64 byte block is about 2 ms
+// of bus time, split in writes of FLIGHT_RECORDER_FRAM_WRITE bytes.
+//
+
+#ifndef FlightRecorderFRAM_h
+#define FlightRecorderFRAM_h
+
+#include "FlightRecorder.h"
+#include "FRAM.h"
+
+// FRAM::write() sends a Wire buffer per transaction
+#define FLIGHT_RECORDER_FRAM_WRITE  FRAM_WRITE_CHUNK
+
+class FlightRecorderFRAM : public FlightRecorderStorage
+{
+public:
+  // size in bytes; parts without a device ID report a size of 0
+  FlightRecorderFRAM(FRAM & fram, const uint32_t size)
+    : _fram(fram), _size(size) {};
+
+  uint32_t size()     { return _size; };
+  uint8_t  pageSize() { return 0; };
+  uint8_t  maxWrite() { return FLIGHT_RECORDER_FRAM_WRITE; };
+  bool     ready()    { return true; };
+
+  // a missing or NACKing FRAM counts as a write error
+  int write(const uint32_t address, const uint8_t * data, const uint8_t length)
+  {
+    return _fram.write(address, data, length);
+  };
+
+  uint16_t read(const uint32_t address, uint8_t * data, const uint16_t length)
+  {
+    _fram.read(address, data, length);
+    return length;
+  };
+
+private:
+  FRAM & _fram;
+  uint32_t _size;
+};
+
+#endif
+// END OF FILE
@@ -0,0 +1,61 @@
+//
+//    FILE: flightRecorderDump.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: print the flight recorder memory for host/replay/fdr_extract
+//    DATE: 2026-10-18
+//     URL: https://github.com/Keyrim/Eagle
+//
+// Released to the public domain
+//
+// Upload after the flight, with the memory the flight sketch used, and
+// save what it prints (32 KB is about 6 s at 115200 baud):
+//   fdr_extract --dump dump.txt --csv flight.csv --imu flight.imu
+// Nothing is written to the memory, the next flight goes on after the
+// last one.
+//
+
+// memory of the flight sketch: a FRAM by default, or a 24LC256
+//#define RECORDER_EEPROM
+
+#include <Wire.h>
+#include <FlightRecorder.h>
+
+#ifdef RECORDER_EEPROM
+#include <I2C_eeprom.h>
+#include <FlightRecorderEeprom.h>
+I2C_eeprom eeprom(0x50, 32768);
+FlightRecorderEeprom storage(eeprom, 32768, 32);
+#else
+#include <FRAM.h>
+#include <FlightRecorderFRAM.h>
+FRAM fram;
+FlightRecorderFRAM storage(fram, 32768);
+#endif
+
+FlightRecorder recorder(storage);
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("Version: ");
+  Serial.println(FLIGHT_RECORDER_LIB_VERSION);
+
+#ifdef RECORDER_EEPROM
+  eeprom.begin();
+#else
+  fram.begin(0x50);
+#endif
+  Serial.print("Block size: ");
+  Serial.println(FLIGHT_RECORDER_BLOCK_SIZE);
+
+  recorder.dump(Serial);
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
@@ -0,0 +1,186 @@
+//
+//    FILE: hist_performance.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.1
+//    DATE: 2026-10-17
+//
+// PUPROSE: time find(), add(), addBatch(), CDF() and VAL() against the
+//          linear scans of 0.1.6, with even and uneven bounds
+//          0.1.1 - check VAL() with buckets below zero (sub())
+//
+// Times are per call in us. The linear versions are rebuilt here from
+// bucket() and the bounds, and every answer is checked against them.
+//
+
+#include "histogram.h"
+
+#ifdef __AVR__
+#define BUCKETS 64
+#else
+#define BUCKETS 500
+#endif
+#define RUNS 2000
+
+float even[BUCKETS];
+float uneven[BUCKETS];
+float vals[32];
+
+uint32_t seed = 1;
+uint32_t mismatches = 0;
+
+// 0 .. 1000
+float randomValue()
+{
+  seed = seed * 1103515245UL + 12345;
+  return ((seed >> 8) & 0xFFFF) * (1000.0 / 65536);
+}
+
+int16_t linearFind(const float *bounds, const float val)
+{
+  for (int16_t i = 0; i < BUCKETS; i++)
+  {
+    if (bounds[i] >= val) return i;
+  }
+  return BUCKETS;
+}
+
+float linearCDF(Histogram &hist, const float *bounds, const float val)
+{
+  int16_t idx = linearFind(bounds, val);
+  int32_t sum = 0;
+  for (int16_t i = 0; i <= idx; i++) sum += hist.bucket(i);
+  return (1.0 * sum) / hist.count();
+}
+
+float linearVAL(Histogram &hist, const float *bounds, const float prob)
+{
+  float probability = prob * hist.count();
+  int32_t sum = 0;
+  for (int16_t i = 0; i < BUCKETS + 1; i++)
+  {
+    sum += hist.bucket(i);
+    if (sum >= probability && i < BUCKETS) return bounds[i];
+  }
+  return INFINITY;
+}
+
+void printTime(const char *label, uint32_t us, uint32_t calls)
+{
+  Serial.print(label);
+  Serial.print((float)us / calls, 3);
+  Serial.println(" us");
+}
+
+void run(const char *name, float *bounds)
+{
+  Histogram hist(BUCKETS, bounds);
+  volatile float sink;
+  uint32_t start;
+
+  Serial.println(name);
+
+  seed = 1;
+  start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) sink = linearFind(bounds, randomValue());
+  printTime("  find() linear\t\t", micros() - start, RUNS);
+
+  seed = 1;
+  start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) sink = hist.find(randomValue());
+  printTime("  find()\t\t", micros() - start, RUNS);
+
+  seed = 1;
+  start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) hist.add(randomValue());
+  printTime("  add()\t\t\t", micros() - start, RUNS);
+
+  start = micros();
+  for (uint16_t i = 0; i < RUNS / 32; i++)
+  {
+    for (uint8_t j = 0; j < 32; j++) vals[j] = randomValue();
+    hist.addBatch(vals, 32);
+  }
+  printTime("  addBatch() per value\t", micros() - start, RUNS / 32 * 32);
+
+  seed = 1;
+  start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) sink = linearCDF(hist, bounds, randomValue());
+  printTime("  CDF() linear\t\t", micros() - start, RUNS);
+
+  seed = 1;
+  start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) sink = hist.CDF(randomValue());
+  printTime("  CDF()\t\t\t", micros() - start, RUNS);
+
+  start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) sink = linearVAL(hist, bounds, i * (1.0 / RUNS));
+  printTime("  VAL() linear\t\t", micros() - start, RUNS);
+
+  start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) sink = hist.VAL(i * (1.0 / RUNS));
+  printTime("  VAL()\t\t\t", micros() - start, RUNS);
+
+  // same answers as the linear versions, including values on the bounds
+  seed = 7;
+  for (uint16_t i = 0; i < RUNS; i++)
+  {
+    float v = (i & 1) ? randomValue() : bounds[i % BUCKETS];
+    if (hist.find(v) != linearFind(bounds, v)) mismatches++;
+    if (hist.CDF(v) != linearCDF(hist, bounds, v)) mismatches++;
+    float p = i * (1.0 / RUNS);
+    if (hist.VAL(p) != linearVAL(hist, bounds, p)) mismatches++;
+  }
+}
+
+// sub() more low values than add() puts, so the low buckets go below
+// zero, then add() them back; VAL() must match the linear scan throughout
+void subTest(float *bounds)
+{
+  Histogram hist(BUCKETS, bounds);
+  seed = 3;
+  for (uint16_t i = 0; i < RUNS; i++) hist.add(randomValue());
+  for (uint16_t i = 0; i < RUNS / 4; i++) hist.sub(randomValue() / 4);
+
+  for (uint8_t pass = 0; pass < 2; pass++)
+  {
+    for (uint16_t i = 0; i <= RUNS / 4; i++)
+    {
+      float p = i * (4.0 / RUNS);
+      if (hist.VAL(p) != linearVAL(hist, bounds, p)) mismatches++;
+    }
+    for (uint16_t i = 0; i < RUNS / 4; i++) hist.add(randomValue() / 4);
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("Histogram version: ");
+  Serial.println(HISTOGRAM_LIB_VERSION);
+  Serial.print("# buckets: ");
+  Serial.println(BUCKETS + 1);
+  Serial.println();
+
+  for (int16_t i = 0; i < BUCKETS; i++)
+  {
+    float x = (float)i / (BUCKETS - 1);
+    even[i] = 1000 * x;
+    uneven[i] = 1000 * x * x;    // narrow buckets near 0
+  }
+
+  run("even bounds", even);
+  run("uneven bounds", uneven);
+  subTest(even);
+  subTest(uneven);
+
+  Serial.print("mismatches: ");
+  Serial.println(mismatches);
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
@@ -1,7 +1,7 @@
 //
 //    FILE: Histogram.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.6
+// VERSION: 0.2.1
 // PURPOSE: Histogram library for Arduino
 //    DATE: 2012-11-10
 //
@@ -15,6 +15,9 @@
 // 0.1.4 - 2015-03-06 stricter interface
 // 0.1.5 - 2017-07-16 refactor, support for > 256 buckets; prevent alloc errors
 // 0.1.6 - 2017-07-27 revert double to float (issue #33)
+// 0.2.0 - 2026-10-17 binary search find(), fast path for even bounds,
+//                    Fenwick tree for CDF() and VAL(), addBatch()
+// 0.2.1 - 2026-10-18 VAL() sums linearly while sub() has a bucket below zero
 //
 // Released to the public domain
 //
@@ -26,21 +29,41 @@ Histogram::Histogram(const int16_t len, float *bounds)
   _bounds = bounds;
   _len = len + 1;
   _data = (int32_t *) malloc((_len) * sizeof(int32_t));
+  // the tree is optional, without it CDF() and VAL() sum linearly
+  _tree = (int32_t *) malloc((_len) * sizeof(int32_t));
   if (_data) clear();
   else _len = 0;
   _cnt = 0;
+  _negative = 0;
 }
 
 Histogram::~Histogram()
 {
   if (_data) free(_data);
+  if (_tree) free(_tree);
 }
 
 // resets all counters
+// and rechecks the bounds, call it after changing them
 void Histogram::clear()
 {
   for (int16_t i = 0; i < _len; i++) _data[i] = 0;
+  if (_tree) for (int16_t i = 0; i < _len; i++) _tree[i] = 0;
   _cnt = 0;
+  _negative = 0;
+
+  // evenly spaced bounds let find() compute the bucket; a bound
+  // off by less than a bucket only costs find() an extra step
+  _invStep = 0;
+  int16_t last = _len - 2;
+  if (last < 1) return;
+  float step = (_bounds[last] - _bounds[0]) / last;
+  if (step <= 0) return;
+  for (int16_t i = 1; i < last; i++)
+  {
+    if (fabs(_bounds[i] - (_bounds[0] + i * step)) >= step) return;
+  }
+  _invStep = 1.0 / step;
 }
 
 // adds a new value to the histogram - increasing
@@ -48,7 +71,7 @@ void Histogram::add(const float f)
 {
   if (_len > 0)
   {
-    _data[find(f)]++;
+    inc(find(f), 1);
     _cnt++;
   }
 }
@@ -58,11 +81,22 @@ void Histogram::sub(const float f)
 {
   if (_len > 0)
   {
-    _data[find(f)]--;
+    inc(find(f), -1);
     _cnt++;
   }
 }
 
+// adds n values to the histogram
+void Histogram::addBatch(const float *vals, const uint16_t n)
+{
+  if (_len <= 0) return;
+  for (uint16_t i = 0; i < n; i++)
+  {
+    inc(find(vals[i]), 1);
+  }
+  _cnt += n;
+}
+
 // returns the count of a bucket
 int32_t Histogram::bucket(const int16_t idx)
 {
@@ -97,12 +131,7 @@ float Histogram::CDF(const float val)
   if (_cnt == 0 || _len == 0) return NAN;
 
   int16_t idx = find(val);
-  int32_t sum = 0;
-  for (int16_t i = 0; i <= idx; i++)
-  {
-    sum += _data[i];
-  }
-  return (1.0 * sum) / _cnt;
+  return (1.0 * sum(idx)) / _cnt;
 }
 
 // EXPERIMENTAL
@@ -116,28 +145,90 @@ float Histogram::VAL(const float prob)
   if (p > 1.0) p = 1.0;
 
   float probability = p * _cnt;
-  int32_t sum = 0;
-  for (int16_t i = 0; i < _len; i++)
+  // the descent below needs every bucket >= 0, sub() can break that
+  if (_tree == NULL || _negative > 0)
+  {
+    int32_t sum = 0;
+    for (int16_t i = 0; i < _len; i++)
+    {
+      sum += _data[i];
+      if (sum >= probability && (i <(_len-1)) ) return _bounds[i];
+    }
+    return INFINITY;
+  }
+
+  // first bucket whose cumulative count reaches need: walk down the
+  // tree, skipping every block that stays below it
+  int32_t need = (int32_t) ceil(probability);
+  int16_t pos = 0;
+  int16_t mask = 1;
+  while ((mask << 1) <= _len) mask <<= 1;
+  for (; mask > 0; mask >>= 1)
   {
-    sum += _data[i];
-    if (sum >= probability && (i <(_len-1)) ) return _bounds[i];
+    int16_t next = pos + mask;
+    if (next <= _len && _tree[next - 1] < need)
+    {
+      pos = next;
+      need -= _tree[next - 1];
+    }
   }
+  if (pos < (_len-1)) return _bounds[pos];
   return INFINITY;
 }
 
 // returns the bucket number for value val
+// the first bucket whose bound is >= val, the last one if none is
 int16_t Histogram::find(const float val)
 {
   if (_len <= 0) return -1;
 
-  for (int16_t i = 0; i < (_len-1); i++)
+  int16_t lo = 0;
+  int16_t hi = _len - 1;
+  if (_invStep > 0 && val > _bounds[0] && val <= _bounds[hi - 1])
+  {
+    // evenly spaced: compute the bucket, then step to the exact one
+    int16_t i = (int16_t)((val - _bounds[0]) * _invStep);
+    if (i > hi - 1) i = hi - 1;
+    while (i > 0 && _bounds[i - 1] >= val) i--;
+    while (i < hi && _bounds[i] < val) i++;
+    return i;
+  }
+  while (lo < hi)
+  {
+    int16_t mid = (lo + hi) / 2;
+    if (_bounds[mid] >= val) hi = mid;
+    else lo = mid + 1;
+  }
+  return lo;
+}
+
+// changes the count of a bucket
+void Histogram::inc(const int16_t idx, const int32_t delta)
+{
+  if (_data[idx] < 0) _negative--;
+  _data[idx] += delta;
+  if (_data[idx] < 0) _negative++;
+  if (_tree == NULL) return;
+  for (int16_t i = idx + 1; i <= _len; i += i & -i)
+  {
+    _tree[i - 1] += delta;
+  }
+}
+
+// returns the count of buckets 0..idx
+int32_t Histogram::sum(const int16_t idx)
+{
+  int32_t s = 0;
+  if (_tree == NULL)
+  {
+    for (int16_t i = 0; i <= idx; i++) s += _data[i];
+    return s;
+  }
+  for (int16_t i = idx + 1; i > 0; i -= i & -i)
   {
-    if (_bounds[i] >= val) return i;
+    s += _tree[i - 1];
   }
-  return _len-1;  // len?
-  // int16_t i = 0;
-  // while ((i < (_len-1)) && (_bounds[i] < val)) i++;
-  // return i;
+  return s;
 }
 
 // END OF FILE
\ No newline at end of file
@@ -3,7 +3,7 @@
 //
 //    FILE: Histogram.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.5
+// VERSION: 0.2.1
 // PURPOSE: Histogram library for Arduino
 //    DATE: 2012-11-10
 //
@@ -20,7 +20,7 @@
 #include "WProgram.h"
 #endif
 
-#define HISTOGRAM_LIB_VERSION "0.1.6"
+#define HISTOGRAM_LIB_VERSION "0.2.1"
 
 class Histogram
 {
@@ -31,6 +31,7 @@ public:
   void  clear();
   void  add(const float val);
   void  sub(const float val);
+  void  addBatch(const float *vals, const uint16_t n);
 
   // number of buckets
   inline int16_t size() { return _len; };
@@ -42,15 +43,21 @@ public:
 
   float   frequency(const int16_t idx);
   float   PMF(const float val);
-  float   CDF(const float val);
-  float   VAL(const float prob);
-  int16_t find(const float f);
+  float   CDF(const float val);     // O(log n)
+  float   VAL(const float prob);    // O(log n), O(n) while a bucket is below zero
+  int16_t find(const float f);      // O(log n), O(1) for evenly spaced bounds
 
 protected:
+  void    inc(const int16_t idx, const int32_t delta);
+  int32_t sum(const int16_t idx);   // count of buckets 0..idx
+
   float *   _bounds;
   int32_t * _data;
+  int32_t * _tree;      // Fenwick tree over _data, NULL -> linear sums
   int16_t   _len;
   uint32_t  _cnt;
+  float     _invStep;   // 1 / bucket width if bounds are evenly spaced, else 0
+  int16_t   _negative;  // buckets below zero (sub()), VAL() can't use the tree then
 };
 
 #endif
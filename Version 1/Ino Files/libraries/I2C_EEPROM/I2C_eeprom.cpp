@@ -1,7 +1,7 @@
 //
 //    FILE: I2C_eeprom.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 1.2.5
+// VERSION: 1.3.2
 // PURPOSE: I2C_eeprom library for Arduino with EEPROM 24LC256 et al.
 //
 // HISTORY:
@@ -26,6 +26,13 @@
 // 1.2.03 - 2015-05-15 bugfix in _pageBlock & example (thanks ifreislich )
 // 1.2.4 - 2017-04-19 remove timeout - https://github.com/RobTillaart/Arduino/issues/63
 // 1.2.5 - 2017-04-20 refactor the removed timeout (Thanks to Koepel)
+// 1.3.0 - 2026-10-18 write-back page cache, flush() and flushAsync(), isReady()
+//                     I2C_TWIBUFFERSIZE follows BUFFER_LENGTH
+//                     fix I2C_eeprom(deviceAddress) leaving the members unset
+// 1.3.1 - 2026-10-18 cache pages provided by the sketch, enableCache(pages, count)
+//                     and disableCache(); no cache RAM in instances without one
+// 1.3.2 - 2026-10-18 disableCache() and enableCache() return the flush status and
+//                     keep the cache on if it fails; begin() leaves the cache alone
 //
 // Released to the public domain
 //
@@ -40,10 +47,18 @@
     #define WIRE_READ  Wire.receive
 #endif
 
+#define I2C_WRITEDELAY  5000
+
 
 I2C_eeprom::I2C_eeprom(const uint8_t deviceAddress)
 {
-    I2C_eeprom(deviceAddress, I2C_EEPROM_PAGESIZE);
+    _deviceAddress = deviceAddress;
+    this->_isAddressSizeTwoWords = true;
+    this->_pageSize = I2C_EEPROM_PAGESIZE;
+#ifdef I2C_EEPROM_CACHE
+    _cache = NULL;
+    _cachePages = 0;
+#endif
 }
 
 I2C_eeprom::I2C_eeprom(const uint8_t deviceAddress, const unsigned int deviceSize)
@@ -67,6 +82,10 @@ I2C_eeprom::I2C_eeprom(const uint8_t deviceAddress, const unsigned int deviceSiz
         this->_isAddressSizeTwoWords = true;
         this->_pageSize = 32;
     }
+#ifdef I2C_EEPROM_CACHE
+    _cache = NULL;
+    _cachePages = 0;
+#endif
 }
 
 void I2C_eeprom::begin()
@@ -87,12 +106,18 @@ void I2C_eeprom::begin()
 
 int I2C_eeprom::writeByte(const uint16_t memoryAddress, const uint8_t data)
 {
+#ifdef I2C_EEPROM_CACHE
+    if (_cachePages) return _cacheBlock(memoryAddress, &data, 1, true);
+#endif
     int rv = _WriteBlock(memoryAddress, &data, 1);
     return rv;
 }
 
 int I2C_eeprom::setBlock(const uint16_t memoryAddress, const uint8_t data, const uint16_t length)
 {
+#ifdef I2C_EEPROM_CACHE
+    if (_cachePages) return _cacheBlock(memoryAddress, &data, length, false);
+#endif
     uint8_t buffer[I2C_TWIBUFFERSIZE];
     for (uint8_t i = 0; i < I2C_TWIBUFFERSIZE; i++) buffer[i] = data;
 
@@ -102,6 +127,9 @@ int I2C_eeprom::setBlock(const uint16_t memoryAddress, const uint8_t data, const
 
 int I2C_eeprom::writeBlock(const uint16_t memoryAddress, const uint8_t* buffer, const uint16_t length)
 {
+#ifdef I2C_EEPROM_CACHE
+    if (_cachePages) return _cacheBlock(memoryAddress, buffer, length, true);
+#endif
     int rv = _pageBlock(memoryAddress, buffer, length, true);
     return rv;
 }
@@ -110,6 +138,9 @@ uint8_t I2C_eeprom::readByte(const uint16_t memoryAddress)
 {
     uint8_t rdata;
     _ReadBlock(memoryAddress, &rdata, 1);
+#ifdef I2C_EEPROM_CACHE
+    if (_cachePages) _cacheOverlay(memoryAddress, &rdata, 1);
+#endif
     return rdata;
 }
 
@@ -118,6 +149,7 @@ uint16_t I2C_eeprom::readBlock(const uint16_t memoryAddress, uint8_t* buffer, co
     uint16_t addr = memoryAddress;
     uint16_t len = length;
     uint16_t rv = 0;
+    uint8_t* start = buffer;
     while (len > 0)
     {
         uint8_t cnt = min(len, I2C_TWIBUFFERSIZE);
@@ -126,9 +158,80 @@ uint16_t I2C_eeprom::readBlock(const uint16_t memoryAddress, uint8_t* buffer, co
         buffer += cnt;
         len -= cnt;
     }
+#ifdef I2C_EEPROM_CACHE
+    if (_cachePages) _cacheOverlay(memoryAddress, start, length);
+#else
+    (void)start;
+#endif
     return rv;
 }
 
+bool I2C_eeprom::isReady()
+{
+    if ((micros() - _lastWrite) > I2C_WRITEDELAY) return true;
+    Wire.beginTransmission(_deviceAddress);
+    return Wire.endTransmission() == 0;
+}
+
+#ifdef I2C_EEPROM_CACHE
+int I2C_eeprom::enableCache(I2C_eepromCachePage* pages, const uint8_t count)
+{
+    int rv = disableCache();
+    if (rv != 0) return rv;
+    _cache = pages;
+    _cachePages = min(count, I2C_EEPROM_CACHE_MAX_PAGES);
+    for (uint8_t i = 0; i < _cachePages; i++)
+    {
+        for (uint8_t j = 0; j < I2C_EEPROM_PAGESIZE / 8; j++) _cache[i].dirty[j] = 0;
+        _cacheOrder[i] = i;
+    }
+    return 0;
+}
+
+int I2C_eeprom::disableCache()
+{
+    // dirty bytes that did not make it stay in the cache
+    int rv = flush();
+    if (rv == 0) _cachePages = 0;
+    return rv;
+}
+
+int I2C_eeprom::flush()
+{
+    // oldest first, the order the pages were written in
+    for (uint8_t i = _cachePages; i > 0; i--)
+    {
+        int rv = _flushSlot(_cacheOrder[i - 1], true);
+        if (rv != 0) return rv;
+    }
+    return 0;
+}
+
+int I2C_eeprom::flushAsync()
+{
+    // the page being written to waits until it is full, more bytes may
+    // still join it in the same write cycle
+    for (uint8_t i = _cachePages; i > 0; i--)
+    {
+        uint8_t slot = _cacheOrder[i - 1];
+        if (!_isDirty(slot)) continue;
+        if (i == 1 && !_isFull(slot)) return 0;
+        return _flushSlot(slot, false);
+    }
+    return 0;
+}
+
+uint8_t I2C_eeprom::dirtyPages()
+{
+    uint8_t n = 0;
+    for (uint8_t slot = 0; slot < _cachePages; slot++)
+    {
+        if (_isDirty(slot)) n++;
+    }
+    return n;
+}
+#endif
+
 #ifdef I2C_EEPROM_EXTENDED
 // returns 64, 32, 16, 8, 4, 2, 1, 0
 // 0 is smaller than 1K
@@ -138,9 +241,21 @@ int I2C_eeprom::determineSize()
     uint8_t orgValues[8];
     uint16_t addr;
 
+#ifdef I2C_EEPROM_CACHE
+    // the cache does not fold like the EEPROM does
+    uint8_t cachePages = _cachePages;
+    if (disableCache() != 0) return -1;
+#endif
+
     // try to read a byte to see if connected
     rv += _ReadBlock(0x00, orgValues, 1);
-    if (rv == 0) return -1;
+    if (rv == 0)
+    {
+#ifdef I2C_EEPROM_CACHE
+        _cachePages = cachePages;
+#endif
+        return -1;
+    }
 
     // remember old values, non destructive
     for (uint8_t i=0; i<8; i++)
@@ -169,6 +284,9 @@ int I2C_eeprom::determineSize()
         uint16_t addr = (512 << i) + 1;
         writeByte(addr, orgValues[i]);
     }
+#ifdef I2C_EEPROM_CACHE
+    _cachePages = cachePages;
+#endif
     return 0x01 << (rv-1);
 }
 #endif
@@ -253,8 +371,6 @@ uint8_t I2C_eeprom::_ReadBlock(const uint16_t memoryAddress, uint8_t* buffer, co
 
 void I2C_eeprom::waitEEReady()
 {
-#define I2C_WRITEDELAY  5000
-
     // Wait until EEPROM gives ACK again.
     // this is a bit faster than the hardcoded 5 milliSeconds
     while ((micros() - _lastWrite) <= I2C_WRITEDELAY)
@@ -265,4 +381,155 @@ void I2C_eeprom::waitEEReady()
     }
 }
 
+#ifdef I2C_EEPROM_CACHE
+// copies into the cache, page by page
+// returns 0 = OK otherwise error (from making room)
+int I2C_eeprom::_cacheBlock(const uint16_t memoryAddress, const uint8_t* buffer, const uint16_t length, const bool incrBuffer)
+{
+    uint16_t addr = memoryAddress;
+    uint16_t i = 0;
+    while (i < length)
+    {
+        uint16_t page = addr - addr % this->_pageSize;
+        uint8_t slot;
+        int rv = _cacheSlot(page, slot);
+        if (rv != 0) return rv;
+
+        uint8_t* data = _cache[slot].data;
+        uint8_t* dirty = _cache[slot].dirty;
+        for (uint8_t offset = addr - page; i < length && offset < this->_pageSize; offset++)
+        {
+            data[offset] = incrBuffer ? buffer[i] : buffer[0];
+            dirty[offset >> 3] |= 1 << (offset & 7);
+            i++;
+            addr++;
+        }
+        _cacheUse(slot);
+    }
+    return 0;
+}
+
+// the slot holding page, or a free one, or the least recently written
+// one once it is flushed
+int I2C_eeprom::_cacheSlot(const uint16_t page, uint8_t & slot)
+{
+    int freeSlot = -1;
+    for (uint8_t i = 0; i < _cachePages; i++)
+    {
+        uint8_t s = _cacheOrder[i];
+        if (!_isDirty(s))
+        {
+            if (freeSlot < 0) freeSlot = s;
+        }
+        else if (_cache[s].page == page)
+        {
+            slot = s;
+            return 0;
+        }
+    }
+    if (freeSlot < 0)
+    {
+        freeSlot = _cacheOrder[_cachePages - 1];
+        int rv = _flushSlot(freeSlot, true);
+        if (rv != 0) return rv;
+    }
+    slot = freeSlot;
+    _cache[slot].page = page;
+    return 0;
+}
+
+// moves slot to the front of _cacheOrder
+void I2C_eeprom::_cacheUse(const uint8_t slot)
+{
+    uint8_t i = 0;
+    while (_cacheOrder[i] != slot) i++;
+    for (; i > 0; i--) _cacheOrder[i] = _cacheOrder[i - 1];
+    _cacheOrder[0] = slot;
+}
+
+// dirty cached bytes over what was read from the EEPROM
+void I2C_eeprom::_cacheOverlay(const uint16_t memoryAddress, uint8_t* buffer, const uint16_t length)
+{
+    for (uint8_t slot = 0; slot < _cachePages; slot++)
+    {
+        if (!_isDirty(slot)) continue;
+        uint16_t page = _cache[slot].page;
+        if (page + this->_pageSize <= memoryAddress || page >= memoryAddress + length) continue;
+        for (uint8_t offset = 0; offset < this->_pageSize; offset++)
+        {
+            uint16_t addr = page + offset;
+            if (addr < memoryAddress || addr >= memoryAddress + length) continue;
+            if (_cache[slot].dirty[offset >> 3] & (1 << (offset & 7)))
+            {
+                buffer[addr - memoryAddress] = _cache[slot].data[offset];
+            }
+        }
+    }
+}
+
+bool I2C_eeprom::_isFull(const uint8_t slot)
+{
+    for (uint8_t offset = 0; offset < this->_pageSize; offset++)
+    {
+        if (!(_cache[slot].dirty[offset >> 3] & (1 << (offset & 7)))) return false;
+    }
+    return true;
+}
+
+bool I2C_eeprom::_isDirty(const uint8_t slot)
+{
+    for (uint8_t j = 0; j < I2C_EEPROM_PAGESIZE / 8; j++)
+    {
+        if (_cache[slot].dirty[j]) return true;
+    }
+    return false;
+}
+
+// writes the dirty bytes of a slot, from the first to the last as one
+// block per TWI buffer; clean bytes in between are read first, a read
+// being much shorter than a write cycle. Without wait, one write at
+// most and none while the EEPROM is busy.
+// returns 0 = OK otherwise error
+int I2C_eeprom::_flushSlot(const uint8_t slot, const bool wait)
+{
+    uint8_t* data = _cache[slot].data;
+    uint8_t* dirty = _cache[slot].dirty;
+    while (_isDirty(slot))
+    {
+        if (!wait && !isReady()) return 0;
+
+        uint8_t first = 0;
+        while (!(dirty[first >> 3] & (1 << (first & 7)))) first++;
+        uint8_t last = first;
+        bool holes = false;
+        for (uint8_t i = first + 1; i < this->_pageSize && i - first < I2C_TWIBUFFERSIZE; i++)
+        {
+            if (dirty[i >> 3] & (1 << (i & 7)))
+            {
+                if (i > last + 1) holes = true;
+                last = i;
+            }
+        }
+        uint8_t cnt = last - first + 1;
+
+        if (holes)
+        {
+            uint8_t buffer[I2C_TWIBUFFERSIZE];
+            if (_ReadBlock(_cache[slot].page + first, buffer, cnt) != cnt) return 4;
+            for (uint8_t i = first; i <= last; i++)
+            {
+                if (!(dirty[i >> 3] & (1 << (i & 7)))) data[i] = buffer[i - first];
+            }
+        }
+
+        int rv = _WriteBlock(_cache[slot].page + first, data + first, cnt);
+        if (rv != 0) return rv;
+        for (uint8_t i = first; i <= last; i++) dirty[i >> 3] &= ~(1 << (i & 7));
+
+        if (!wait) return 0;
+    }
+    return 0;
+}
+#endif
+
 // END OF FILE
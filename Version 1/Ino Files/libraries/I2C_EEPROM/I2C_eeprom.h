@@ -4,7 +4,7 @@
 //    FILE: I2C_eeprom.h
 //  AUTHOR: Rob Tillaart
 // PURPOSE: I2C_eeprom library for Arduino with EEPROM 24LC256 et al.
-// VERSION: 1.2.5
+// VERSION: 1.3.2
 // HISTORY: See I2C_eeprom.cpp
 //     URL: http://arduino.cc/playground/Main/LibraryForI2CEEPROM
 //
@@ -21,7 +21,7 @@
 #include "Wiring.h"
 #endif
 
-#define I2C_EEPROM_VERSION "1.2.5"
+#define I2C_EEPROM_VERSION "1.3.2"
 
 // The DEFAULT page size. This is overriden if you use the second constructor.
 // I2C_EEPROM_PAGESIZE must be multiple of 2 e.g. 16, 32 or 64
@@ -30,7 +30,30 @@
 
 // TWI buffer needs max 2 bytes for eeprom address
 // 1 byte for eeprom register address is available in txbuffer
+// A page written in more than one transaction takes more than one write
+// cycle: build with -DBUFFER_LENGTH=34 (66) for whole 32 (64) byte pages
+#ifdef BUFFER_LENGTH
+#define I2C_TWIBUFFERSIZE  (BUFFER_LENGTH - 2)
+#else
 #define I2C_TWIBUFFERSIZE  30
+#endif
+
+// Write-back cache in pages the sketch provides, see enableCache();
+// an instance without one only holds a pointer and the page order.
+// Comment the next line to leave the cache out.
+#define I2C_EEPROM_CACHE
+#define I2C_EEPROM_CACHE_MAX_PAGES  4
+
+#ifdef I2C_EEPROM_CACHE
+// one cached page, I2C_EEPROM_PAGESIZE bytes; only dirty bytes are
+// cached: the page is free when its mask is clear
+struct I2C_eepromCachePage
+{
+    uint16_t page;
+    uint8_t  dirty[I2C_EEPROM_PAGESIZE / 8];
+    uint8_t  data[I2C_EEPROM_PAGESIZE];
+};
+#endif
 
 // comment next line to keep lib small (idea a read only lib?)
 #define I2C_EEPROM_EXTENDED
@@ -65,6 +88,50 @@ public:
     int determineSize();
 #endif
 
+    /**
+     * False while the EEPROM is in its write cycle. Polls the device
+     * only when the last write is less than the write delay ago.
+     */
+    bool isReady();
+
+#ifdef I2C_EEPROM_CACHE
+    /**
+     * With the cache on, writeByte, writeBlock and setBlock only update
+     * the given pages (up to I2C_EEPROM_CACHE_MAX_PAGES; 2 lets one page
+     * fill while the other is being written); the dirty bytes of a page
+     * go to the EEPROM together, in as few page writes as the TWI buffer
+     * allows, on flush() / flushAsync() or when the page has to make room
+     * for another one. Reads see the cached bytes.
+     *
+     *   I2C_eepromCachePage pages[2];
+     *   ee.enableCache(pages, 2);
+     *
+     * The pages must outlive the cache. A cache already on is flushed
+     * first, as is the cache turned off; if that flush fails the old
+     * cache stays on with its dirty bytes. May be called before begin().
+     * returns 0 = OK otherwise error (from the flush)
+     */
+    int enableCache(I2C_eepromCachePage* pages, const uint8_t count);
+    int disableCache();
+    bool cacheEnabled() { return _cachePages > 0; };
+
+    /**
+     * Writes all dirty pages, waiting for every write cycle.
+     * returns 0 = OK otherwise error
+     */
+    int flush();
+
+    /**
+     * Writes one chunk of the oldest dirty page if the EEPROM is ready,
+     * and returns at once either way. The page last written to is left
+     * until it is full: call flush() to write everything.
+     * returns 0 = OK otherwise error
+     */
+    int flushAsync();
+
+    uint8_t dirtyPages();
+#endif
+
 private:
     uint8_t _deviceAddress;
     uint32_t _lastWrite;     // for waitEEReady
@@ -85,6 +152,21 @@ private:
     uint8_t _ReadBlock(const uint16_t memoryAddress, uint8_t* buffer, const uint8_t length);
 
     void waitEEReady();
+
+#ifdef I2C_EEPROM_CACHE
+    I2C_eepromCachePage* _cache;
+    uint8_t  _cachePages;        // 0 = cache off
+    // slots, most recently written first
+    uint8_t  _cacheOrder[I2C_EEPROM_CACHE_MAX_PAGES];
+
+    int  _cacheBlock(const uint16_t memoryAddress, const uint8_t* buffer, const uint16_t length, const bool incrBuffer);
+    int  _cacheSlot(const uint16_t page, uint8_t & slot);
+    void _cacheUse(const uint8_t slot);
+    void _cacheOverlay(const uint16_t memoryAddress, uint8_t* buffer, const uint16_t length);
+    bool _isDirty(const uint8_t slot);
+    bool _isFull(const uint8_t slot);
+    int  _flushSlot(const uint8_t slot, const bool wait);
+#endif
 };
 
 #endif
@@ -0,0 +1,183 @@
+//
+//    FILE: I2C_eeprom_cache.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.1
+// PURPOSE: byte writes per second with and without the I2C_eeprom page cache
+//    DATE: 2026-10-18
+//     URL:
+//
+// Released to the public domain
+//
+// Each pattern writes single bytes with writeByte(), reads them back and
+// prints the writes per second, the cache flushed at the end:
+//   sequential  addresses one after the other
+//   random      anywhere in the EEPROM
+//   local       anywhere in 64 bytes, e.g. settings being edited
+// Then a stream of 16 byte blocks from a 1 kHz loop that calls
+// flushAsync() once per pass: how much of the loop the writes take and
+// the longest call. Last, a cache on an address nobody answers: its
+// dirty byte can't be flushed, so disableCache() fails and leaves it on.
+//
+// On the host: build/I2C_eeprom_cache --virtual --eeprom 32
+//
+
+#include <Wire.h>
+#include <I2C_eeprom.h>
+
+#define MEMORY_SIZE 0x8000     // 24LC256
+
+I2C_eeprom ee(0x50, MEMORY_SIZE);
+I2C_eepromCachePage pages[2];  // one page fills while the other is written
+
+uint32_t seed = 1;
+
+uint16_t randomAddress(uint16_t range)
+{
+  seed = seed * 1103515245UL + 12345;
+  return (seed >> 8) % range;
+}
+
+uint16_t patternAddress(uint8_t pattern, uint16_t i)
+{
+  if (pattern == 0) return 1024 + i;
+  if (pattern == 1) return randomAddress(MEMORY_SIZE);
+  return 4096 + randomAddress(64);
+}
+
+const char * patternName[] = { "sequential", "random", "local" };
+
+void test(uint8_t pattern, bool cache, uint16_t writes)
+{
+  if (cache) ee.enableCache(pages, 2);
+  else ee.disableCache();
+  seed = 1;
+  uint32_t start = micros();
+  for (uint16_t i = 0; i < writes; i++)
+  {
+    ee.writeByte(patternAddress(pattern, i), i & 0xFF);
+  }
+  ee.flush();
+  uint32_t duration = micros() - start;
+
+  // read back without the cache; the last write to an address wins
+  ee.disableCache();
+  seed = 1;
+  uint16_t errors = 0;
+  for (uint16_t i = 0; i < writes; i++)
+  {
+    uint16_t address = patternAddress(pattern, i);
+    uint16_t last = i;
+    uint32_t s = seed;
+    for (uint16_t j = i + 1; j < writes; j++)
+    {
+      if (patternAddress(pattern, j) == address) last = j;
+    }
+    seed = s;
+    if (ee.readByte(address) != (last & 0xFF)) errors++;
+  }
+
+  Serial.print(patternName[pattern]);
+  Serial.print(cache ? "\tcache\t" : "\tdirect\t");
+  Serial.print(writes);
+  Serial.print("\t");
+  Serial.print(duration);
+  Serial.print("\t");
+  Serial.print(writes * 1e6 / duration, 0);
+  Serial.print("\t");
+  Serial.println(errors);
+}
+
+void stream()
+{
+  ee.enableCache(pages, 2);
+  uint8_t block[16];
+  uint16_t address = 8192;
+  uint32_t longest = 0;
+  uint32_t busy = 0;
+  uint16_t passes = 0;
+  uint32_t pass = micros();
+  uint32_t start = pass;
+  while (address < 8192 + 2048)
+  {
+    while ((int32_t)(micros() - pass) < 0);
+    pass += 1000;
+
+    // a block every 10 ms, 1600 bytes/s
+    if (++passes % 10 == 0)
+    {
+      for (uint8_t i = 0; i < sizeof(block); i++) block[i] = address + i;
+      ee.writeBlock(address, block, sizeof(block));
+      address += sizeof(block);
+    }
+
+    uint32_t t = micros();
+    ee.flushAsync();
+    t = micros() - t;
+    busy += t;
+    if (t > longest) longest = t;
+  }
+  ee.flush();
+  uint32_t duration = micros() - start;
+
+  ee.disableCache();
+  uint16_t errors = 0;
+  for (uint16_t a = 8192; a < 8192 + 2048; a++)
+  {
+    if (ee.readByte(a) != (a & 0xFF)) errors++;
+  }
+  Serial.print("stream 2048 bytes in ");
+  Serial.print(duration);
+  Serial.print(" us, flushAsync ");
+  Serial.print(busy * 100.0 / duration, 1);
+  Serial.print("% of the loop, longest call ");
+  Serial.print(longest);
+  Serial.print(" us, errors ");
+  Serial.println(errors);
+}
+void nack()
+{
+  I2C_eeprom none(0x57, MEMORY_SIZE);
+  I2C_eepromCachePage page;
+  none.enableCache(&page, 1);   // before begin(), which leaves it on
+  none.begin();
+  none.writeByte(0, 0x42);
+  int rv = none.disableCache();
+  Serial.print("no EEPROM on 0x57: disableCache() ");
+  Serial.print(rv);
+  Serial.print(", cache ");
+  Serial.print(none.cacheEnabled() ? "on" : "off");
+  Serial.print(", dirty pages ");
+  Serial.println(none.dirtyPages());
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("I2C_EEPROM_VERSION: ");
+  Serial.println(I2C_EEPROM_VERSION);
+  Serial.print("I2C_TWIBUFFERSIZE: ");
+  Serial.println(I2C_TWIBUFFERSIZE);
+
+  ee.begin();
+#ifdef TWBR
+  TWBR = 12;    // 400 kHz
+#endif
+
+  Serial.println("\npattern\tmode\twrites\tus\twrites/s\terrors");
+  for (uint8_t pattern = 0; pattern < 3; pattern++)
+  {
+    test(pattern, false, 100);
+    test(pattern, true, pattern == 1 ? 100 : 1000);
+  }
+  Serial.println();
+  stream();
+  nack();
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
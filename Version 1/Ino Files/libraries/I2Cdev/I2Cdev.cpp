@@ -3,6 +3,9 @@
 // 6/9/2012 by Jeff Rowberg <jeff@rowberg.net>
 //
 // Changelog:
+//      2026-10-17 - add register shadow for bit-field writes (shadowBegin/shadowFlush/shadowEnd, writeStrobe)
+//                 - add queued register reads serviced by the TWI interrupt (queueRead)
+//                 - read blocks in one transaction with a Wire that reads into the caller's buffer
 //      2013-05-06 - add Francesco Ferrara's Fastwire v0.24 implementation with small modifications
 //      2013-05-05 - fix issue with writing bit values to words (Sasquatch/Farzanegan)
 //      2012-06-09 - fix major issue with reading > 32 bytes at a time with Arduino Wire
@@ -92,6 +95,196 @@ THE SOFTWARE.
 I2Cdev::I2Cdev() {
 }
 
+#if I2CDEV_SHADOW_DEVICES > 0
+
+// Register shadow. For a shadowed device writeBit()/writeBits() change a
+// local copy of the register and mark it dirty instead of doing a
+// read-modify-write on the bus; the register is read once, the first
+// time. Any other transfer to the device first writes the dirty
+// registers out, so they reach the device before it. They go out lowest
+// register first, adjacent ones in one burst, not in the order the
+// bit-field writes were made. The copies live in storage the caller
+// passes to shadowBegin().
+
+#define SHADOW_USED     0x01
+#define SHADOW_DIRTY    0x02
+
+// longest run of registers flushed in one burst write
+#define SHADOW_BURST    16
+
+struct I2CdevShadowDevice {
+    uint8_t devAddr;        // 0 = free slot
+    uint8_t count;
+    I2CdevShadow *regs;
+};
+
+static I2CdevShadowDevice shadowDevice[I2CDEV_SHADOW_DEVICES];
+static bool shadowBypass = false;                       // shadow's own transfer on the bus
+
+static I2CdevShadowDevice *shadowed(uint8_t devAddr) {
+    if (devAddr == 0) return 0;
+    for (uint8_t i = 0; i < I2CDEV_SHADOW_DEVICES; i++) {
+        if (shadowDevice[i].devAddr == devAddr) return &shadowDevice[i];
+    }
+    return 0;
+}
+
+static I2CdevShadow *shadowFind(I2CdevShadowDevice *d, uint8_t regAddr) {
+    for (uint8_t i = 0; i < d->count; i++) {
+        I2CdevShadow *e = &d->regs[i];
+        if ((e->flags & SHADOW_USED) && e->regAddr == regAddr) return e;
+    }
+    return 0;
+}
+
+// a free entry, else a clean one to reuse, else NULL
+static I2CdevShadow *shadowAlloc(I2CdevShadowDevice *d, uint8_t regAddr) {
+    I2CdevShadow *e = 0;
+    for (uint8_t i = 0; i < d->count; i++) {
+        if (!(d->regs[i].flags & SHADOW_USED)) {
+            e = &d->regs[i];
+            break;
+        }
+        if (!e && !(d->regs[i].flags & SHADOW_DIRTY)) e = &d->regs[i];
+    }
+    if (e) {
+        e->regAddr = regAddr;
+        e->flags = SHADOW_USED;
+    }
+    return e;
+}
+
+// the shadow of a register for a read-modify-write, NULL if the device
+// is not shadowed, the register can't be read or no slot is free
+static I2CdevShadow *shadowFetch(uint8_t devAddr, uint8_t regAddr) {
+    I2CdevShadowDevice *d = shadowed(devAddr);
+    if (!d) return 0;
+    I2CdevShadow *e = shadowFind(d, regAddr);
+    if (e) return e;
+    // pending writes to other registers can wait
+    uint8_t b;
+    shadowBypass = true;
+    int8_t count = I2Cdev::readByte(devAddr, regAddr, &b);
+    shadowBypass = false;
+    if (count != 1) return 0;
+    e = shadowAlloc(d, regAddr);
+    if (!e) {
+        // all dirty: write them out, then they can be reused
+        I2Cdev::shadowFlush(devAddr);
+        e = shadowAlloc(d, regAddr);
+        if (!e) return 0;
+    }
+    e->value = b;
+    return e;
+}
+
+// before any other transfer to a shadowed device
+static void shadowSync(uint8_t devAddr) {
+    if (!shadowBypass && shadowed(devAddr)) I2Cdev::shadowFlush(devAddr);
+}
+
+// after a transfer with a shadowed device: keep a single byte read or
+// written, forget a range written
+static void shadowStore(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data) {
+    if (shadowBypass) return;
+    I2CdevShadowDevice *d = shadowed(devAddr);
+    if (!d) return;
+    if (length == 1) {
+        I2CdevShadow *e = shadowFind(d, regAddr);
+        if (!e) e = shadowAlloc(d, regAddr);
+        if (e) e->value = data[0];
+        return;
+    }
+    for (uint8_t i = 0; i < d->count; i++) {
+        I2CdevShadow *e = &d->regs[i];
+        if ((uint8_t)(e->regAddr - regAddr) < length) e->flags = 0;
+    }
+}
+
+#endif
+
+/** Start shadowing the registers of a device.
+ * From now on bit-field writes to it only change the shadow; they reach
+ * the device with its next transfer, shadowFlush() or shadowEnd(). The
+ * device must auto-increment the register address on burst writes.
+ * Registers the device changes by itself (status bits, self-clearing
+ * bits other than through writeStrobe(), a device reset) make the
+ * shadow stale: use it around configuration sequences.
+ * @param devAddr I2C slave device address
+ * @param regs Storage for the shadowed registers, used until shadowEnd()
+ *        (a local array in the function that calls shadowEnd() will do)
+ * @param count Number of entries in regs
+ * @return true if shadowed (or already), false if count is 0 or all
+ *         I2CDEV_SHADOW_DEVICES slots are taken
+ */
+bool I2Cdev::shadowBegin(uint8_t devAddr, I2CdevShadow *regs, uint8_t count) {
+    #if I2CDEV_SHADOW_DEVICES > 0
+        if (shadowed(devAddr)) return true;
+        if (devAddr == 0 || count == 0) return false;
+        for (uint8_t i = 0; i < I2CDEV_SHADOW_DEVICES; i++) {
+            I2CdevShadowDevice *d = &shadowDevice[i];
+            if (d->devAddr == 0) {
+                for (uint8_t j = 0; j < count; j++) regs[j].flags = 0;
+                d->devAddr = devAddr;
+                d->count = count;
+                d->regs = regs;
+                return true;
+            }
+        }
+    #endif
+    return false;
+}
+
+/** Write the dirty shadow registers of a device.
+ * Lowest register first; adjacent dirty registers go out in one burst
+ * write.
+ * @param devAddr I2C slave device address
+ * @return Status of operation (true = success)
+ */
+bool I2Cdev::shadowFlush(uint8_t devAddr) {
+    bool ok = true;
+    #if I2CDEV_SHADOW_DEVICES > 0
+        I2CdevShadowDevice *d = shadowed(devAddr);
+        if (!d) return ok;
+        shadowBypass = true;
+        for (;;) {
+            // the lowest dirty register and the dirty registers right after it
+            I2CdevShadow *first = 0;
+            for (uint8_t i = 0; i < d->count; i++) {
+                I2CdevShadow *e = &d->regs[i];
+                if ((e->flags & SHADOW_DIRTY) && (!first || e->regAddr < first->regAddr)) first = e;
+            }
+            if (!first) break;
+
+            uint8_t data[SHADOW_BURST];
+            uint8_t length = 0;
+            for (I2CdevShadow *e = first; e && (e->flags & SHADOW_DIRTY); ) {
+                data[length++] = e->value;
+                e->flags &= ~SHADOW_DIRTY;
+                if (length == SHADOW_BURST || first->regAddr + length > 0xFF) break;
+                e = shadowFind(d, first->regAddr + length);
+            }
+            if (!writeBytes(devAddr, first->regAddr, length, data)) ok = false;
+        }
+        shadowBypass = false;
+    #endif
+    return ok;
+}
+
+/** Stop shadowing a device: flush, then forget its registers.
+ * The storage given to shadowBegin() is free again afterwards.
+ * @param devAddr I2C slave device address
+ * @return Status of the flush (true = success)
+ */
+bool I2Cdev::shadowEnd(uint8_t devAddr) {
+    bool ok = shadowFlush(devAddr);
+    #if I2CDEV_SHADOW_DEVICES > 0
+        I2CdevShadowDevice *d = shadowed(devAddr);
+        if (d) d->devAddr = 0;
+    #endif
+    return ok;
+}
+
 /** Read a single bit from an 8-bit device register.
  * @param devAddr I2C slave device address
  * @param regAddr Register regAddr to read from
@@ -201,9 +394,14 @@ int8_t I2Cdev::readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data, uint16
  * @param length Number of bytes to read
  * @param data Buffer to store read data in
  * @param timeout Optional read timeout in milliseconds (0 to disable, leave off to use default class value in I2Cdev::readTimeout)
- * @return Number of bytes read (-1 indicates failure)
+ * @return Number of bytes read (-1 indicates failure); a complete read of
+ *         more than 127 bytes returns 127, the largest count that fits
  */
 int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, uint16_t timeout) {
+    #if I2CDEV_SHADOW_DEVICES > 0
+        shadowSync(devAddr);
+    #endif
+
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.print("I2C (0x");
         Serial.print(devAddr, HEX);
@@ -214,7 +412,7 @@ int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8
         Serial.print("...");
     #endif
 
-    int8_t count = 0;
+    int16_t count = 0;      // up to 255 bytes, saturated on return
     uint32_t t1 = millis();
 
     #if (I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE)
@@ -266,6 +464,22 @@ int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8
         
                 Wire.endTransmission();
             }
+        #elif (ARDUINO > 100) && defined(WIRE_HAS_BUFFER_READ)
+            // Wire that reads straight into the caller's buffer: one
+            // transaction for the whole block, any length, no
+            // BUFFER_LENGTH chunks. The read blocks in requestFrom(), so
+            // the timeout can't stop it halfway; it is checked below,
+            // once the read is done
+            Wire.beginTransmission(devAddr);
+            Wire.write(regAddr);
+            Wire.endTransmission();
+            count = Wire.requestFrom(devAddr, data, length);
+            #ifdef I2CDEV_SERIAL_DEBUG
+                for (uint8_t i = 0; i < count; i++) {
+                    Serial.print(data[i], HEX);
+                    if (i + 1 < length) Serial.print(" ");
+                }
+            #endif
         #elif (ARDUINO > 100)
             // Arduino v1.0.1+, Wire library
             // Adds official support for repeated start condition, yay!
@@ -312,7 +526,11 @@ int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8
         Serial.println(" read).");
     #endif
 
-    return count;
+    #if I2CDEV_SHADOW_DEVICES > 0
+        if (count == 1) shadowStore(devAddr, regAddr, 1, data);
+    #endif
+
+    return count > 127 ? 127 : count;
 }
 
 /** Read multiple words from a 16-bit device register.
@@ -324,6 +542,10 @@ int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8
  * @return Number of words read (-1 indicates failure)
  */
 int8_t I2Cdev::readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data, uint16_t timeout) {
+    #if I2CDEV_SHADOW_DEVICES > 0
+        shadowSync(devAddr);
+    #endif
+
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.print("I2C (0x");
         Serial.print(devAddr, HEX);
@@ -475,6 +697,14 @@ int8_t I2Cdev::readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint1
  * @return Status of operation (true = success)
  */
 bool I2Cdev::writeBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data) {
+    #if I2CDEV_SHADOW_DEVICES > 0
+        I2CdevShadow *e = shadowFetch(devAddr, regAddr);
+        if (e) {
+            e->value = (data != 0) ? (e->value | (1 << bitNum)) : (e->value & ~(1 << bitNum));
+            e->flags |= SHADOW_DIRTY;
+            return true;
+        }
+    #endif
     uint8_t b;
     readByte(devAddr, regAddr, &b);
     b = (data != 0) ? (b | (1 << bitNum)) : (b & ~(1 << bitNum));
@@ -511,6 +741,15 @@ bool I2Cdev::writeBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8
     // 10101111 original value (sample)
     // 10100011 original & ~mask
     // 10101011 masked | value
+    #if I2CDEV_SHADOW_DEVICES > 0
+        I2CdevShadow *e = shadowFetch(devAddr, regAddr);
+        if (e) {
+            uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
+            e->value = (e->value & ~mask) | ((data << (bitStart - length + 1)) & mask);
+            e->flags |= SHADOW_DIRTY;
+            return true;
+        }
+    #endif
     uint8_t b;
     if (readByte(devAddr, regAddr, &b) != 0) {
         uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
@@ -563,6 +802,29 @@ bool I2Cdev::writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data) {
     return writeBytes(devAddr, regAddr, 1, &data);
 }
 
+/** Set a self-clearing bit (a reset or trigger) in an 8-bit device register.
+ * Unlike writeBit() this goes to the device at once, with any pending
+ * shadow writes, and the shadow keeps the bit clear afterwards. A bit
+ * that resets the whole device leaves the shadow stale all the same.
+ * @param devAddr I2C slave device address
+ * @param regAddr Register regAddr to write to
+ * @param bitNum Bit position to set (0-7)
+ * @return Status of operation (true = success)
+ */
+bool I2Cdev::writeStrobe(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum) {
+    #if I2CDEV_SHADOW_DEVICES > 0
+        I2CdevShadow *e = shadowFetch(devAddr, regAddr);
+        if (e) {
+            e->value |= (1 << bitNum);
+            e->flags |= SHADOW_DIRTY;
+            bool ok = shadowFlush(devAddr);
+            e->value &= ~(1 << bitNum);
+            return ok;
+        }
+    #endif
+    return writeBit(devAddr, regAddr, bitNum, true);
+}
+
 /** Write single word to a 16-bit device register.
  * @param devAddr I2C slave device address
  * @param regAddr Register address to write to
@@ -590,6 +852,9 @@ bool I2Cdev::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_
         Serial.print(regAddr, HEX);
         Serial.print("...");
     #endif
+    #if I2CDEV_SHADOW_DEVICES > 0
+        shadowSync(devAddr);
+    #endif
     uint8_t status = 0;
     #if ((I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE && ARDUINO < 100) || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_NBWIRE)
         Wire.beginTransmission(devAddr);
@@ -625,6 +890,9 @@ bool I2Cdev::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.println(". Done.");
     #endif
+    #if I2CDEV_SHADOW_DEVICES > 0
+        if (status == 0) shadowStore(devAddr, regAddr, length, data);
+    #endif
     return status == 0;
 }
 
@@ -636,6 +904,11 @@ bool I2Cdev::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_
  * @return Status of operation (true = success)
  */
 bool I2Cdev::writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t* data) {
+    #if I2CDEV_SHADOW_DEVICES > 0
+        shadowSync(devAddr);
+        shadowStore(devAddr, regAddr, length * 2, 0);
+    #endif
+
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.print("I2C (0x");
         Serial.print(devAddr, HEX);
@@ -687,6 +960,118 @@ bool I2Cdev::writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16
     return status == 0;
 }
 
+#ifdef I2CDEV_HAS_QUEUE
+
+struct I2CdevRead {
+    uint8_t devAddr;
+    uint8_t regAddr;
+    uint8_t length;
+    uint8_t *data;
+    volatile int8_t *status;
+    I2CdevCallback callback;
+};
+
+static I2CdevRead queue[I2CDEV_QUEUE_LENGTH];
+static volatile uint8_t queueHead = 0;      // oldest read, the one on the bus when running
+static volatile uint8_t queueCount = 0;
+static volatile bool queueRunning = false;
+
+static void queueDone(uint8_t *buffer, uint8_t count);
+
+/** Put the oldest queued read on the bus.
+ * Called with interrupts off, or from the TWI interrupt. A read the twi
+ * buffer cannot hold fails at once; if the bus is taken by someone
+ * else's async read the queue waits for the next queueRead() or
+ * queuePending() call.
+ */
+static void queueStart() {
+    while (queueCount) {
+        I2CdevRead &r = queue[queueHead];
+        uint8_t result = Wire.requestFromAsync(r.devAddr, r.regAddr, r.length, queueDone);
+        if (result == 0) {
+            queueRunning = true;
+            return;
+        }
+        if (result == 4) return;
+
+        I2CdevRead done = r;
+        queueHead = (queueHead + 1) % I2CDEV_QUEUE_LENGTH;
+        queueCount--;
+        if (done.status) *done.status = -1;
+        if (done.callback) done.callback(done.devAddr, done.regAddr, done.data, -1);
+    }
+}
+
+/** Wire callback for the read at the head of the queue (TWI interrupt).
+ * The data is copied out, the next read is started so the bus never
+ * idles between queued reads, and only then is the read reported.
+ */
+static void queueDone(uint8_t *buffer, uint8_t count) {
+    I2CdevRead done = queue[queueHead];
+    for (uint8_t i = 0; i < count; i++) done.data[i] = buffer[i];
+    queueHead = (queueHead + 1) % I2CDEV_QUEUE_LENGTH;
+    queueCount--;
+    queueRunning = false;
+    queueStart();
+
+    int8_t result = count ? count : -1;
+    if (done.status) *done.status = result;
+    if (done.callback) done.callback(done.devAddr, done.regAddr, done.data, result);
+}
+
+/** Queue a read of multiple bytes from an 8-bit device register.
+ * Returns at once. Queued reads run one after the other in the TWI
+ * interrupt, across devices, in the order they were queued. Do not use
+ * data until *status is no longer I2CDEV_PENDING, or callback has run.
+ * @param devAddr I2C slave device address
+ * @param regAddr First register regAddr to read from
+ * @param length Number of bytes to read (at most TWI_BUFFER_LENGTH)
+ * @param data Buffer to store read data in
+ * @param status Set to I2CDEV_PENDING now, to the number of bytes read or -1 when done (may be NULL)
+ * @param callback Optional function called from the TWI interrupt when done
+ * @return true if queued, false if the queue is full
+ */
+bool I2Cdev::queueRead(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, volatile int8_t *status, I2CdevCallback callback) {
+    if (length == 0) return false;
+    #if I2CDEV_SHADOW_DEVICES > 0
+        shadowSync(devAddr);
+    #endif
+
+    uint8_t oldSREG = SREG;
+    cli();
+    if (queueCount >= I2CDEV_QUEUE_LENGTH) {
+        SREG = oldSREG;
+        return false;
+    }
+    I2CdevRead &r = queue[(queueHead + queueCount) % I2CDEV_QUEUE_LENGTH];
+    r.devAddr = devAddr;
+    r.regAddr = regAddr;
+    r.length = length;
+    r.data = data;
+    r.status = status;
+    r.callback = callback;
+    if (status) *status = I2CDEV_PENDING;
+    queueCount++;
+    if (!queueRunning) queueStart();
+    SREG = oldSREG;
+    return true;
+}
+
+/** Number of queued reads not completed yet.
+ * Also restarts the queue if it had to wait for the bus.
+ * @return Reads still queued, 0 when all are done
+ */
+uint8_t I2Cdev::queuePending() {
+    uint8_t oldSREG = SREG;
+    cli();
+    if (queueCount && !queueRunning) queueStart();
+    uint8_t count = queueCount;
+    SREG = oldSREG;
+    return count;
+}
+
+#endif
+
 /** Default timeout value for read operations.
  * Set this to 0 to disable timeout detection.
  */
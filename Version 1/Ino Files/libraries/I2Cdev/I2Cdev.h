@@ -3,6 +3,9 @@
 // 6/9/2012 by Jeff Rowberg <jeff@rowberg.net>
 //
 // Changelog:
+//      2026-10-18 - shadowed registers live in storage passed to shadowBegin()
+//      2026-10-17 - add register shadow for bit-field writes (shadowBegin/shadowFlush/shadowEnd, writeStrobe)
+//      2026-10-17 - add queued register reads serviced by the TWI interrupt (queueRead)
 //      2013-05-06 - add Francesco Ferrara's Fastwire v0.24 implementation with small modifications
 //      2013-05-05 - fix issue with writing bit values to words (Sasquatch/Farzanegan)
 //      2012-06-09 - fix major issue with reading > 32 bytes at a time with Arduino Wire
@@ -87,6 +90,40 @@ THE SOFTWARE.
 // 1000ms default read timeout (modify with "I2Cdev::readTimeout = [ms];")
 #define I2CDEV_DEFAULT_READ_TIMEOUT     1000
 
+// -----------------------------------------------------------------------------
+// Queued reads, run back to back by the TWI interrupt (Wire with requestFromAsync)
+// -----------------------------------------------------------------------------
+#if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE && defined(WIRE_HAS_ASYNC_READ)
+    #define I2CDEV_HAS_QUEUE
+#endif
+
+// number of reads that can wait in the queue (modify with -DI2CDEV_QUEUE_LENGTH=n)
+#ifndef I2CDEV_QUEUE_LENGTH
+    #define I2CDEV_QUEUE_LENGTH         8
+#endif
+
+// -----------------------------------------------------------------------------
+// Register shadow for bit-field writes (set I2CDEV_SHADOW_DEVICES to 0 to leave it out)
+// -----------------------------------------------------------------------------
+// devices shadowed at the same time; their registers are kept in storage
+// the caller passes to shadowBegin(), so nothing is reserved for them here
+#ifndef I2CDEV_SHADOW_DEVICES
+    #define I2CDEV_SHADOW_DEVICES       2
+#endif
+
+// one shadowed register, see I2Cdev::shadowBegin()
+struct I2CdevShadow {
+    uint8_t regAddr;
+    uint8_t value;
+    uint8_t flags;
+};
+
+// status of a queued read until it completes
+#define I2CDEV_PENDING                  -2
+
+// called from the TWI interrupt when a queued read completes, count is -1 on failure
+typedef void (*I2CdevCallback)(uint8_t devAddr, uint8_t regAddr, uint8_t *data, int8_t count);
+
 class I2Cdev {
     public:
         I2Cdev();
@@ -108,6 +145,16 @@ class I2Cdev {
         static bool writeWord(uint8_t devAddr, uint8_t regAddr, uint16_t data);
         static bool writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
         static bool writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data);
+        static bool writeStrobe(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum);
+
+        static bool shadowBegin(uint8_t devAddr, I2CdevShadow *regs, uint8_t count);
+        static bool shadowFlush(uint8_t devAddr);
+        static bool shadowEnd(uint8_t devAddr);
+
+        #ifdef I2CDEV_HAS_QUEUE
+            static bool queueRead(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, volatile int8_t *status, I2CdevCallback callback=0);
+            static uint8_t queuePending();
+        #endif
 
         static uint16_t readTimeout;
 };
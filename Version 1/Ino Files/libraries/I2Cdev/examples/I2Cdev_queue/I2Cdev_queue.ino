@@ -0,0 +1,96 @@
+// I2Cdev queued reads
+// Reads the sensors of one control cycle, then runs the control math,
+// two ways: with blocking readBytes() calls, and with queueRead(), which
+// hands all reads to the TWI interrupt so the math runs while they are
+// on the bus. Time per cycle is printed for both.
+//
+// One cycle reads the MPU-6050 accelerometer, temperature and gyro as
+// three reads and the MS5611 ADC, whose next conversion is started at
+// the end of the cycle. The math is stood in for by delayMicroseconds(),
+// which is CPU time on the AVR and simulated time on the host. Without
+// an MS5611 its reads fail (-1) and the cycle goes on.
+//
+// On the host run it with --virtual (make -C host run-I2Cdev_queue
+// ARGS=--virtual); in real time the simulator's interrupt thread wakes
+// up too late for the numbers to mean anything.
+//
+// This example code is in the public domain.
+
+#include "I2Cdev.h"
+#include "Wire.h"
+
+#define MPU_ADDRESS     0x68
+#define MS5611_ADDRESS  0x77
+#define CYCLES          100
+#define CONTROL_US      800     // control math per cycle
+
+uint8_t accel[6], temperature[2], gyro[6], pressure[3];
+volatile int8_t accelStatus, temperatureStatus, gyroStatus, pressureStatus;
+int16_t pressureFailed = 0;
+
+void startConversion() {
+    // D1, OSR 4096; its ADC read is due by the next cycle
+    Wire.beginTransmission(MS5611_ADDRESS);
+    Wire.write(0x48);
+    Wire.endTransmission();
+}
+
+void controlMath() {
+    delayMicroseconds(CONTROL_US);
+}
+
+uint32_t blockingCycle() {
+    uint32_t start = micros();
+    I2Cdev::readBytes(MPU_ADDRESS, 0x3B, 6, accel);
+    I2Cdev::readBytes(MPU_ADDRESS, 0x41, 2, temperature);
+    I2Cdev::readBytes(MPU_ADDRESS, 0x43, 6, gyro);
+    if (I2Cdev::readBytes(MS5611_ADDRESS, 0x00, 3, pressure) != 3) pressureFailed++;
+    controlMath();
+    startConversion();
+    return micros() - start;
+}
+
+uint32_t queuedCycle() {
+    uint32_t start = micros();
+    I2Cdev::queueRead(MPU_ADDRESS, 0x3B, 6, accel, &accelStatus);
+    I2Cdev::queueRead(MPU_ADDRESS, 0x41, 2, temperature, &temperatureStatus);
+    I2Cdev::queueRead(MPU_ADDRESS, 0x43, 6, gyro, &gyroStatus);
+    I2Cdev::queueRead(MS5611_ADDRESS, 0x00, 3, pressure, &pressureStatus);
+    controlMath();
+    // only completed results are used
+    while (I2Cdev::queuePending()) {}
+    if (pressureStatus != 3) pressureFailed++;
+    startConversion();
+    return micros() - start;
+}
+
+void setup() {
+    Wire.begin();
+    TWBR = 12;  // 400 kHz
+    Serial.begin(115200);
+    I2Cdev::writeByte(MPU_ADDRESS, 0x6B, 0);    // wake up
+    startConversion();
+
+    uint32_t blocking = 0;
+    for (uint16_t i = 0; i < CYCLES; i++) blocking += blockingCycle();
+    uint32_t queued = 0;
+    for (uint16_t i = 0; i < CYCLES; i++) queued += queuedCycle();
+
+    Serial.print(F("blocking\t"));
+    Serial.print(blocking / CYCLES);
+    Serial.println(F(" us per cycle"));
+    Serial.print(F("queued\t\t"));
+    Serial.print(queued / CYCLES);
+    Serial.println(F(" us per cycle"));
+    Serial.print(F("MPU-6050 reads\t"));
+    Serial.print(accelStatus);
+    Serial.print(' ');
+    Serial.print(temperatureStatus);
+    Serial.print(' ');
+    Serial.println(gyroStatus);
+    Serial.print(F("MS5611 failed\t"));
+    Serial.println(pressureFailed);
+}
+
+void loop() {
+}
@@ -0,0 +1,123 @@
+/* Copyright (C) 2012 Kristian Lauszus, TKJ Electronics. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus, TKJ Electronics
+ Web      :  http://www.tkjelectronics.com
+ e-mail   :  kristianl@tkjelectronics.com
+ */
+
+#ifndef _KalmanBank_h_
+#define _KalmanBank_h_
+
+#include <stdint.h>
+
+/*
+ * N copies of the filter in Kalman.cpp, one per axis, stepped together.
+ * The state is kept as one array per variable (structure of arrays) so
+ * update() is a single branch free loop over the axes, which the compiler
+ * can turn into vector code where there is a vector unit (the host build).
+ *
+ * All axes share the tuning and the time step: they are meant to be the
+ * axes of one IMU, read in one go. The covariance matrix is symmetric, so
+ * only P00, P01 and P11 are stored.
+ */
+
+/* Vectorize update() on targets that have the instructions for it */
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__AVR__)
+#define KALMAN_BANK_VECTORIZE __attribute__((optimize("tree-vectorize")))
+#else
+#define KALMAN_BANK_VECTORIZE
+#endif
+
+template <uint8_t N>
+class KalmanBank {
+public:
+    KalmanBank() {
+        /* Same defaults as Kalman */
+        Q_angle = 0.001f;
+        Q_bias = 0.003f;
+        R_measure = 0.03f;
+
+        for (uint8_t i = 0; i < N; i++) {
+            angle[i] = 0.0f;
+            bias[i] = 0.0f;
+            rate[i] = 0.0f;
+            P00[i] = 0.0f;
+            P01[i] = 0.0f;
+            P11[i] = 0.0f;
+        }
+    };
+
+    // Same units as Kalman::getAngle(): newAngle in degrees, newRate in degrees per second, one per axis, and dt in seconds
+    KALMAN_BANK_VECTORIZE void update(const float *newAngle, const float *newRate, float dt) {
+        const float Qa = Q_angle * dt;
+        const float Qb = Q_bias * dt;
+        const float R = R_measure;
+
+        for (uint8_t i = 0; i < N; i++) {
+            /* Step 1 - Project the state ahead */
+            float r = newRate[i] - bias[i];
+            float a = angle[i] + dt * r;
+
+            /* Step 2 - Project the error covariance ahead */
+            float p11 = P11[i];
+            float p01 = P01[i] - dt * p11;
+            float p00 = P00[i] + dt * (dt * p11 - 2.0f * P01[i]) + Qa;
+            p11 += Qb;
+
+            /* Step 4, 5 - Kalman gain */
+            float S = p00 + R;
+            float K0 = p00 / S;
+            float K1 = p01 / S;
+
+            /* Step 3, 6 - Update estimate with the measurement */
+            float y = newAngle[i] - a;
+            angle[i] = a + K0 * y;
+            bias[i] += K1 * y;
+            rate[i] = r;
+
+            /* Step 7 - Update the error covariance */
+            P00[i] = p00 - K0 * p00;
+            P01[i] = p01 - K0 * p01;
+            P11[i] = p11 - K1 * p01;
+        }
+    };
+
+    float getAngle(uint8_t axis) const { return angle[axis]; }; // Angle of one axis after the last update()
+    const float *getAngles() const { return angle; }; // All N angles
+    void setAngle(uint8_t axis, float newAngle) { angle[axis] = newAngle; }; // Used to set angle, this should be set as the starting angle
+    float getRate(uint8_t axis) const { return rate[axis]; }; // Return the unbiased rate
+
+    /* These are used to tune the filters, all axes at once */
+    void setQangle(float Q_angle) { this->Q_angle = Q_angle; };
+    void setQbias(float Q_bias) { this->Q_bias = Q_bias; };
+    void setRmeasure(float R_measure) { this->R_measure = R_measure; };
+
+    float getQangle() const { return Q_angle; };
+    float getQbias() const { return Q_bias; };
+    float getRmeasure() const { return R_measure; };
+
+private:
+    float Q_angle; // Process noise variance for the accelerometer
+    float Q_bias; // Process noise variance for the gyro bias
+    float R_measure; // Measurement noise variance
+
+    float angle[N]; // The angles calculated by the filters
+    float bias[N]; // The gyro biases
+    float rate[N]; // Unbiased rates from the last update()
+
+    float P00[N]; // Error covariance matrices, P10 == P01
+    float P01[N];
+    float P11[N];
+};
+
+#endif
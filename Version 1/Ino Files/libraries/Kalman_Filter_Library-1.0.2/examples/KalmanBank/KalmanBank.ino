@@ -0,0 +1,156 @@
+/* Copyright (C) 2012 Kristian Lauszus, TKJ Electronics. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus, TKJ Electronics
+ Web      :  http://www.tkjelectronics.com
+ e-mail   :  kristianl@tkjelectronics.com
+ */
+
+/*
+ * Throughput of KalmanBank<AXES> against AXES Kalman instances.
+ *
+ * A short log of MPU-6050 samples is recorded first, turned into angles
+ * and rates, then replayed through both many times. Times are per three
+ * axis update, in us and in cycles at F_CPU. The largest difference
+ * between the two sets of angles is printed as a check.
+ *
+ * On the host (make -C host run-KalmanBank ARGS=--quiet) the bank runs
+ * as vector code and the gain grows with the number of axes: little at
+ * 2 or 3, about 2x at 4 and 3.5x at 8. On the AVR the gain is the shared setup and the
+ * leaner covariance update only.
+ */
+
+#include <Wire.h>
+#include <Kalman.h>
+#include <KalmanBank.h>
+
+#define AXES 3 // 2 or more
+#define SAMPLES 32 // 768 bytes of log, fits next to Wire and Serial on an Uno
+#ifdef __AVR__
+#define PASSES 300
+#else
+#define PASSES 30000 // the host needs more to get past micros() resolution
+#endif
+
+const uint8_t IMUAddress = 0x68;
+
+float logAngle[SAMPLES][AXES];
+float logRate[SAMPLES][AXES];
+const float dt = 0.004f; // 250 Hz
+
+Kalman kalman[AXES];
+KalmanBank<AXES> bank;
+
+volatile float sink;
+
+bool recordLog() {
+  Wire.beginTransmission(IMUAddress);
+  Wire.write(0x6B); // PWR_MGMT_1, wake up
+  Wire.write(0x00);
+  if (Wire.endTransmission())
+    return false;
+  delay(100);
+
+  for (uint8_t n = 0; n < SAMPLES; n++) {
+    uint8_t data[14];
+    Wire.beginTransmission(IMUAddress);
+    Wire.write(0x3B);
+    Wire.endTransmission(false);
+    if (Wire.requestFrom(IMUAddress, (uint8_t)14) != 14)
+      return false;
+    for (uint8_t i = 0; i < 14; i++)
+      data[i] = Wire.read();
+
+    float accX = (int16_t)((data[0] << 8) | data[1]);
+    float accY = (int16_t)((data[2] << 8) | data[3]);
+    float accZ = (int16_t)((data[4] << 8) | data[5]);
+    // roll and pitch from the accelerometer; there is no heading
+    // reference, further axes filter against 0 at the same cost and
+    // reuse the gyro axes in turn
+    for (uint8_t i = 0; i < AXES; i++) {
+      uint8_t g = 8 + 2 * (i % 3);
+      logAngle[n][i] = 0;
+      logRate[n][i] = (int16_t)((data[g] << 8) | data[g + 1]) / 131.0f;
+    }
+    logAngle[n][0] = atan2(accY, accZ) * RAD_TO_DEG;
+    logAngle[n][1] = atan(-accX / sqrt(accY * accY + accZ * accZ)) * RAD_TO_DEG;
+    delayMicroseconds(4000);
+  }
+  return true;
+}
+
+void printTime(const char *label, uint32_t us) {
+  float perUpdate = (float)us / ((uint32_t)PASSES * SAMPLES);
+  Serial.print(label);
+  Serial.print(perUpdate, 3);
+  Serial.print(" us\t");
+  Serial.print(perUpdate * (F_CPU / 1000000L), 0);
+  Serial.println(" cycles");
+}
+
+void setup() {
+  Serial.begin(115200);
+  Wire.begin();
+  Serial.print(F("KalmanBank<"));
+  Serial.print(AXES);
+  Serial.print(F("> against "));
+  Serial.print(AXES);
+  Serial.println(F(" x Kalman"));
+
+  if (!recordLog()) {
+    Serial.println(F("MPU-6050 did not answer"));
+    return;
+  }
+
+  for (uint8_t i = 0; i < AXES; i++) {
+    kalman[i].setAngle(logAngle[0][i]);
+    bank.setAngle(i, logAngle[0][i]);
+  }
+
+  uint32_t start = micros();
+  for (uint16_t pass = 0; pass < PASSES; pass++) {
+    for (uint8_t n = 0; n < SAMPLES; n++) {
+      for (uint8_t i = 0; i < AXES; i++)
+        sink = kalman[i].getAngle(logAngle[n][i], logRate[n][i], dt);
+    }
+  }
+  uint32_t separate = micros() - start;
+
+  start = micros();
+  for (uint16_t pass = 0; pass < PASSES; pass++) {
+    for (uint8_t n = 0; n < SAMPLES; n++) {
+      bank.update(logAngle[n], logRate[n], dt);
+      sink = bank.getAngle(AXES - 1);
+    }
+  }
+  uint32_t together = micros() - start;
+
+  // both have now seen the same log, one more step should agree
+  float maxDiff = 0;
+  bank.update(logAngle[0], logRate[0], dt);
+  for (uint8_t i = 0; i < AXES; i++) {
+    float d = fabs(kalman[i].getAngle(logAngle[0][i], logRate[0][i], dt) - bank.getAngle(i));
+    if (d > maxDiff)
+      maxDiff = d;
+  }
+
+  printTime("Kalman instances\t", separate);
+  printTime("KalmanBank\t\t", together);
+  Serial.print("ratio\t\t\t");
+  Serial.println((float)separate / together, 2);
+  Serial.print("max difference\t\t");
+  Serial.print(maxDiff, 6);
+  Serial.println(" deg");
+}
+
+void loop() {
+}
@@ -0,0 +1,98 @@
+// I2Cdev device library demonstration: MPU6050 boot time
+// Times initialize(), dmpInitialize() and the DMP upload inside it; on the
+// host simulator the I2C transactions and bytes are printed too.
+//
+// Changelog:
+//      2026-10-17 - initial release
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+Copyright (c) 2011 Jeff Rowberg
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#include "I2Cdev.h"
+#include "MPU6050_6Axis_MotionApps20.h"
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE
+    #include "Wire.h"
+#endif
+
+#ifdef ARDUINO_ARCH_HOST
+    #include "Sim.h"
+#endif
+
+MPU6050 mpu;
+
+#ifdef ARDUINO_ARCH_HOST
+    uint64_t transactions, bytes;
+#endif
+
+void startCount() {
+    #ifdef ARDUINO_ARCH_HOST
+        transactions = sim::stats().i2cTransactions;
+        bytes = sim::stats().i2cBytes;
+    #endif
+}
+
+void printCount(const __FlashStringHelper *label, uint32_t us) {
+    Serial.print(label);
+    Serial.print(us);
+    Serial.print(F(" us"));
+    #ifdef ARDUINO_ARCH_HOST
+        Serial.print(F("\t"));
+        Serial.print((uint32_t)(sim::stats().i2cTransactions - transactions));
+        Serial.print(F(" transactions\t"));
+        Serial.print((uint32_t)(sim::stats().i2cBytes - bytes));
+        Serial.print(F(" bytes"));
+    #endif
+    Serial.println();
+}
+
+void setup() {
+    #if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE
+        Wire.begin();
+        TWBR = 24; // 400kHz I2C clock (200kHz if CPU is 8MHz)
+    #elif I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_FASTWIRE
+        Fastwire::setup(400, true);
+    #endif
+    Serial.begin(115200);
+
+    startCount();
+    uint32_t start = micros();
+    mpu.initialize();
+    printCount(F("initialize()\t"), micros() - start);
+
+    startCount();
+    start = micros();
+    uint8_t devStatus = mpu.dmpInitialize();
+    printCount(F("dmpInitialize()\t"), micros() - start);
+
+    Serial.print(F("DMP upload\t"));
+    Serial.print(mpu.dmpGetUploadTime());
+    Serial.println(F(" us"));
+
+    Serial.print(F("dmpInitialize() returned "));
+    Serial.println(devStatus);
+}
+
+void loop() {
+}
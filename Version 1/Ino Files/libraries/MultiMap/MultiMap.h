@@ -1,17 +1,18 @@
 //
 //    FILE: multiMap.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.00
+// VERSION: 0.1.01
 // PURPOSE: MultiMap library for Arduino
 //     URL: http://playground.arduino.cc/Main/MultiMap
 //
 // HISTORY: see playground article
+// 0.1.01  2026-10-18 added multiMapBS() and MultiMapTable
 //
 
 #ifndef multimap_h
 #define multimap_h
 
-#define MULTIMAP_LIB_VERSION "0.1.00"
+#define MULTIMAP_LIB_VERSION "0.1.01"
 
 #if ARDUINO < 100
 #include <WProgram.h>
@@ -39,6 +40,172 @@ T multiMap(T val, T* _in, T* _out, uint8_t size)
     return (val - _in[pos-1]) * (_out[pos] - _out[pos-1]) / (_in[pos] - _in[pos-1]) + _out[pos-1];
 }
 
+
+// as multiMap(), with a binary search for the interval: log2(size)
+// compares instead of up to size
+template<typename T>
+T multiMapBS(T val, const T* _in, const T* _out, uint8_t size)
+{
+    if (val <= _in[0]) return _out[0];
+    if (val >= _in[size-1]) return _out[size-1];
+
+    // _in[lower] < val <= _in[upper]
+    uint8_t lower = 0;
+    uint8_t upper = size - 1;
+    while (upper - lower > 1)
+    {
+        uint8_t mid = (lower + upper) / 2;
+        if (val > _in[mid]) lower = mid;
+        else upper = mid;
+    }
+    if (val == _in[upper]) return _out[upper];
+    return (val - _in[lower]) * (_out[upper] - _out[lower]) / (_in[upper] - _in[lower]) + _out[lower];
+}
+
+
+// the arithmetic of MultiMapTable for integers: slopes in fixed point,
+// results rounded to the nearest, values up to 16 bits
+template<typename T>
+struct MultiMapMath
+{
+    typedef int32_t Slope;
+    typedef uint32_t Reciprocal;
+
+    // fraction bits that keep |dOut| << shift below 2^30
+    static uint8_t shift(int32_t maxOut)
+    {
+        uint8_t s = 16;
+        while (s > 0 && (maxOut >> (30 - s)) != 0) s--;
+        return s;
+    }
+    static Slope slope(T dIn, T dOut, uint8_t shift)
+    {
+        int32_t num = (int32_t)dOut << shift;
+        return (num + (num < 0 ? -1 : 1) * (int32_t)dIn / 2) / (int32_t)dIn;
+    }
+    static T apply(T base, T d, Slope slope, uint8_t shift)
+    {
+        int32_t half = shift ? (int32_t)1 << (shift - 1) : 0;
+        return base + (T)(((int32_t)d * slope + half) >> shift);
+    }
+
+    // 2^24 / step, rounded down: at most N - 1 steps times it fit in 32
+    // bits, and the segment comes out right or one too low
+    static Reciprocal reciprocal(T step)
+    {
+        return ((uint32_t)1 << 24) / (uint32_t)step;
+    }
+    static uint32_t segment(T d, Reciprocal reciprocal)
+    {
+        return ((uint32_t)d * reciprocal) >> 24;
+    }
+};
+
+template<typename F>
+struct MultiMapFloatMath
+{
+    typedef F Slope;
+    typedef F Reciprocal;
+
+    static uint8_t shift(int32_t) { return 0; }
+    static Slope slope(F dIn, F dOut, uint8_t) { return dOut / dIn; }
+    static F apply(F base, F d, Slope slope, uint8_t) { return base + d * slope; }
+    static Reciprocal reciprocal(F step) { return 1 / step; }
+    static uint32_t segment(F d, Reciprocal reciprocal) { return (uint32_t)(d * reciprocal); }
+};
+
+template<> struct MultiMapMath<float> : MultiMapFloatMath<float> {};
+template<> struct MultiMapMath<double> : MultiMapFloatMath<double> {};
+
+
+// multiMap() over a table of N points with the work done once in
+// begin(): the slope of every segment, and whether the inputs are evenly
+// spaced. map() then finds the segment by index for an even table,
+// by binary search otherwise, and interpolates with one multiply-add.
+// The arrays stay the caller's and must not change after begin().
+//
+//   MultiMapTable<int, 33> throttle;
+//   throttle.begin(in, out);
+//   int us = throttle.map(stick);
+//
+// Integer tables round to the nearest where multiMap() truncates.
+// RAM: N - 1 slopes of 4 bytes.
+template<typename T, uint8_t N>
+class MultiMapTable
+{
+public:
+    typedef MultiMapMath<T> Math;
+
+    MultiMapTable() : _in(NULL), _out(NULL), _uniform(false), _shift(0) {}
+
+    void begin(const T* in, const T* out)
+    {
+        _in = in;
+        _out = out;
+
+        int32_t maxOut = 0;
+        for (uint8_t i = 0; i < N - 1; i++)
+        {
+            int32_t d = (int32_t)(out[i+1] - out[i]);
+            if (d < 0) d = -d;
+            if (d > maxOut) maxOut = d;
+        }
+        _shift = Math::shift(maxOut);
+        for (uint8_t i = 0; i < N - 1; i++)
+        {
+            _slope[i] = Math::slope(in[i+1] - in[i], out[i+1] - out[i], _shift);
+        }
+
+        T step = in[1] - in[0];
+        _uniform = true;
+        for (uint8_t i = 1; i < N - 1; i++)
+        {
+            if (in[i+1] - in[i] != step) _uniform = false;
+        }
+        _reciprocal = Math::reciprocal(step);
+    }
+
+    T map(T val) const
+    {
+        if (val <= _in[0]) return _out[0];
+        if (val >= _in[N-1]) return _out[N-1];
+        uint8_t i = segment(val);
+        return Math::apply(_out[i], val - _in[i], _slope[i], _shift);
+    }
+
+    bool uniform() const { return _uniform; };
+
+private:
+    // _in[i] <= val < _in[i+1]
+    uint8_t segment(T val) const
+    {
+        if (_uniform)
+        {
+            uint32_t estimate = Math::segment(val - _in[0], _reciprocal);
+            uint8_t i = estimate > N - 2 ? N - 2 : estimate;
+            if (val < _in[i]) i--;
+            else if (i < N - 2 && val >= _in[i+1]) i++;
+            return i;
+        }
+        uint8_t lower = 0;
+        uint8_t upper = N - 1;
+        while (upper - lower > 1)
+        {
+            uint8_t mid = (lower + upper) / 2;
+            if (val >= _in[mid]) lower = mid;
+            else upper = mid;
+        }
+        return lower;
+    }
+
+    const T* _in;
+    const T* _out;
+    typename Math::Slope      _slope[N - 1];
+    typename Math::Reciprocal _reciprocal;
+    bool     _uniform;
+    uint8_t  _shift;
+};
+
 /*
 #include "multiMap.h"
 
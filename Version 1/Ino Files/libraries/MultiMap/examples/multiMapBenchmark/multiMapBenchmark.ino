@@ -0,0 +1,128 @@
+//
+//    FILE: multiMapBenchmark.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: multiMap() against multiMapBS() and MultiMapTable over table sizes
+//    DATE: 2026-10-18
+//     URL:
+//
+// Released to the public domain
+//
+// A throttle curve, 1000..2000 us in, a quadratic out, with evenly
+// spaced inputs and with inputs bunched at the low end, 6 to 51 points,
+// int and float. Per call over an input sweep: multiMap() (linear search
+// and a division), multiMapBS() (binary search and a division) and
+// MultiMapTable (index or binary search, then a multiply-add), and the
+// largest difference of the last two from multiMap().
+//
+// On the host: build/multiMapBenchmark --bare --loops 1
+// times the host in real time, for the ratios only, and noisy. At 51
+// points multiMap() takes 30 to 55 ns, multiMapBS() about 20 and
+// MultiMapTable 3 to 10 on an even table; on a bunched one the table
+// still has the binary search and the host divides fast, so it is about
+// as fast as multiMapBS(). The division saved counts more on AVR. Integer
+// results differ by 1 at most, MultiMapTable rounding where multiMap()
+// truncates.
+//
+
+#include "MultiMap.h"
+
+#ifdef __AVR__
+#define PASSES 1
+#else
+#define PASSES 2000 // the host needs more to get past micros() resolution
+#endif
+
+#define SWEEP_FIRST 900
+#define SWEEP_LAST  2100
+#define SWEEP_STEP  3
+
+volatile float sink;
+volatile int   first;     // keeps the compiler from folding the loops
+
+template <typename T, uint8_t N>
+void bench(const char * type, bool even)
+{
+  T in[N];
+  T out[N];
+  for (uint8_t i = 0; i < N; i++)
+  {
+    float x = (float)i / (N - 1);
+    // bunched inputs: closer together at the low end
+    if (even) in[i] = 1000 + i * (1000 / (N - 1));
+    else in[i] = i == N - 1 ? 2000 : 1000 + (int)(1000 * x * x * x);
+    if (i > 0 && in[i] <= in[i - 1]) in[i] = in[i - 1] + 1;
+    out[i] = 1000 + 1000 * x * x;
+  }
+  MultiMapTable<T, N> table;
+  table.begin(in, out);
+
+  float calls = (float)PASSES * ((SWEEP_LAST - SWEEP_FIRST) / SWEEP_STEP + 1);
+  uint32_t start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (int v = first + SWEEP_FIRST; v <= SWEEP_LAST; v += SWEEP_STEP) sink = multiMap<T>(v, in, out, N);
+  uint32_t linear = micros() - start;
+
+  start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (int v = first + SWEEP_FIRST; v <= SWEEP_LAST; v += SWEEP_STEP) sink = multiMapBS<T>(v, in, out, N);
+  uint32_t binary = micros() - start;
+
+  start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (int v = first + SWEEP_FIRST; v <= SWEEP_LAST; v += SWEEP_STEP) sink = table.map(v);
+  uint32_t precomputed = micros() - start;
+
+  float diffBS = 0, diffTable = 0;
+  for (int v = SWEEP_FIRST; v <= SWEEP_LAST; v++)
+  {
+    float reference = multiMap<T>(v, in, out, N);
+    diffBS = max(diffBS, fabs(multiMapBS<T>(v, in, out, N) - reference));
+    diffTable = max(diffTable, fabs(table.map(v) - reference));
+  }
+
+  Serial.print(type);
+  Serial.print("\t");
+  Serial.print(N);
+  Serial.print(table.uniform() ? "\teven\t" : "\tbunched\t");
+  Serial.print(linear * 1000.0 / calls, 1);
+  Serial.print("\t");
+  Serial.print(binary * 1000.0 / calls, 1);
+  Serial.print("\t");
+  Serial.print(precomputed * 1000.0 / calls, 1);
+  Serial.print("\t");
+  Serial.print(diffBS, 4);
+  Serial.print("\t");
+  Serial.println(diffTable, 4);
+}
+
+template <typename T>
+void sizes(const char * type)
+{
+  for (uint8_t even = 1; even < 2; even--)
+  {
+    bench<T, 6>(type, even);
+    bench<T, 11>(type, even);
+    bench<T, 26>(type, even);
+    bench<T, 51>(type, even);
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("MULTIMAP_LIB_VERSION: ");
+  Serial.println(MULTIMAP_LIB_VERSION);
+
+  Serial.println("\n\t\t\tns per call\t\tlargest difference\ntype\tpoints\tinputs\tlinear\tbinary\ttable\tbinary\ttable");
+  sizes<int>("int");
+  sizes<float>("float");
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
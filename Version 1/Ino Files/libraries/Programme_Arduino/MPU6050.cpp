@@ -2674,8 +2674,11 @@ uint8_t MPU6050::getFIFOByte() {
     I2Cdev::readByte(devAddr, MPU6050_RA_FIFO_R_W, buffer);
     return buffer[0];
 }
-void MPU6050::getFIFOBytes(uint8_t *data, uint8_t length) {
-    I2Cdev::readBytes(devAddr, MPU6050_RA_FIFO_R_W, length, data);
+/** Read several bytes from the FIFO buffer.
+ * @return Number of bytes read, as I2Cdev::readBytes() (-1 indicates failure)
+ */
+int8_t MPU6050::getFIFOBytes(uint8_t *data, uint8_t length) {
+    return I2Cdev::readBytes(devAddr, MPU6050_RA_FIFO_R_W, length, data);
 }
 /** Write byte to FIFO buffer.
  * @see getFIFOByte()
@@ -2938,7 +2941,7 @@ void MPU6050::readMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank, ui
     uint8_t chunkSize;
     for (uint16_t i = 0; i < dataSize;) {
         // determine correct chunk size according to bank position and data size
-        chunkSize = MPU6050_DMP_MEMORY_CHUNK_SIZE;
+        chunkSize = MPU6050_DMP_MEMORY_BURST_SIZE;
 
         // make sure we don't go past the data size
         if (i + chunkSize > dataSize) chunkSize = dataSize - i;
@@ -2955,27 +2958,91 @@ void MPU6050::readMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank, ui
         // uint8_t automatically wraps to 0 at 256
         address += chunkSize;
 
-        // if we aren't done, update bank (if necessary) and address
-        if (i < dataSize) {
-            if (address == 0) bank++;
+        // the memory address counts up by itself, but doesn't carry into the
+        // next bank
+        if (i < dataSize && address == 0) {
+            bank++;
             setMemoryBank(bank);
             setMemoryStartAddress(address);
         }
     }
 }
-bool MPU6050::writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, bool verify, bool useProgMem) {
+/** Add bytes to a memory checksum.
+ * Two running 16-bit sums, Fletcher style without the modulo, so swapped or
+ * shifted bytes change the result as well as wrong ones.
+ * @param checksum Checksum so far (0 to start)
+ * @param data Bytes to add
+ * @param length Number of bytes
+ * @return Updated checksum
+ */
+static uint32_t addMemoryChecksum(uint32_t checksum, const uint8_t *data, uint8_t length) {
+    uint16_t sum1 = checksum, sum2 = checksum >> 16;
+    for (uint8_t j = 0; j < length; j++) {
+        sum1 += data[j];
+        sum2 += sum1;
+    }
+    return ((uint32_t)sum2 << 16) | sum1;
+}
+/** Read back a block of DMP memory as a checksum.
+ * Costs the same bus time as readMemoryBlock() but only one chunk of RAM.
+ * @param dataSize Number of bytes to read
+ * @param bank Memory bank to start from
+ * @param address Address in the bank to start from
+ * @return Checksum of the bytes read, 0 if out of memory
+ */
+uint32_t MPU6050::readMemoryChecksum(uint16_t dataSize, uint8_t bank, uint8_t address) {
+    uint8_t *chunk = (uint8_t *)malloc(MPU6050_DMP_MEMORY_BURST_SIZE);
+    if (!chunk) return 0;
     setMemoryBank(bank);
     setMemoryStartAddress(address);
+    uint32_t checksum = 0;
     uint8_t chunkSize;
-    uint8_t *verifyBuffer;
-    uint8_t *progBuffer;
+    for (uint16_t i = 0; i < dataSize;) {
+        chunkSize = MPU6050_DMP_MEMORY_BURST_SIZE;
+        if (i + chunkSize > dataSize) chunkSize = dataSize - i;
+        if (chunkSize > 256 - address) chunkSize = 256 - address;
+        I2Cdev::readBytes(devAddr, MPU6050_RA_MEM_R_W, chunkSize, chunk);
+        checksum = addMemoryChecksum(checksum, chunk, chunkSize);
+        i += chunkSize;
+        address += chunkSize;
+        if (i < dataSize && address == 0) {
+            bank++;
+            setMemoryBank(bank);
+            setMemoryStartAddress(address);
+        }
+    }
+    free(chunk);
+    return checksum;
+}
+/** Write a block of DMP memory.
+ * Data goes out in chunks of MPU6050_DMP_MEMORY_BURST_SIZE bytes, as large
+ * as the bus buffer allows; bank and address are only set again when a
+ * chunk crosses into the next bank.
+ * @param data Bytes to write
+ * @param dataSize Number of bytes to write
+ * @param bank Memory bank to start in
+ * @param address Address in the bank to start at
+ * @param verify MPU6050_DMP_VERIFY_NONE, _CHUNK (read back and compare every
+ *        chunk) or _CHECKSUM (read everything back once at the end and
+ *        compare checksums)
+ * @param useProgMem True if data is in PROGMEM
+ * @return True if written (and verified, if asked)
+ */
+bool MPU6050::writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, uint8_t verify, bool useProgMem) {
+    setMemoryBank(bank);
+    setMemoryStartAddress(address);
+    uint8_t chunkSize;
+    uint8_t *verifyBuffer = 0;
+    uint8_t *progBuffer = 0;
     uint16_t i;
     uint8_t j;
-    if (verify) verifyBuffer = (uint8_t *)malloc(MPU6050_DMP_MEMORY_CHUNK_SIZE);
-    if (useProgMem) progBuffer = (uint8_t *)malloc(MPU6050_DMP_MEMORY_CHUNK_SIZE);
+    uint8_t startBank = bank, startAddress = address;
+    uint32_t checksum = 0;
+    if (verify == MPU6050_DMP_VERIFY_CHUNK) verifyBuffer = (uint8_t *)malloc(MPU6050_DMP_MEMORY_BURST_SIZE);
+    if (useProgMem) progBuffer = (uint8_t *)malloc(MPU6050_DMP_MEMORY_BURST_SIZE);
     for (i = 0; i < dataSize;) {
         // determine correct chunk size according to bank position and data size
-        chunkSize = MPU6050_DMP_MEMORY_CHUNK_SIZE;
+        chunkSize = MPU6050_DMP_MEMORY_BURST_SIZE;
 
         // make sure we don't go past the data size
         if (i + chunkSize > dataSize) chunkSize = dataSize - i;
@@ -2994,7 +3061,10 @@ bool MPU6050::writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t b
         I2Cdev::writeBytes(devAddr, MPU6050_RA_MEM_R_W, chunkSize, progBuffer);
 
         // verify data if needed
-        if (verify && verifyBuffer) {
+        if (verify == MPU6050_DMP_VERIFY_CHECKSUM) {
+            checksum = addMemoryChecksum(checksum, progBuffer, chunkSize);
+        } else if (verify && verifyBuffer) {
+            // the read leaves the address where the write did
             setMemoryBank(bank);
             setMemoryStartAddress(address);
             I2Cdev::readBytes(devAddr, MPU6050_RA_MEM_R_W, chunkSize, verifyBuffer);
@@ -3028,21 +3098,25 @@ bool MPU6050::writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t b
         // uint8_t automatically wraps to 0 at 256
         address += chunkSize;
 
-        // if we aren't done, update bank (if necessary) and address
-        if (i < dataSize) {
-            if (address == 0) bank++;
+        // the memory address counts up by itself, but doesn't carry into the
+        // next bank
+        if (i < dataSize && address == 0) {
+            bank++;
             setMemoryBank(bank);
             setMemoryStartAddress(address);
         }
     }
-    if (verify) free(verifyBuffer);
+    if (verifyBuffer) free(verifyBuffer);
     if (useProgMem) free(progBuffer);
+    if (verify == MPU6050_DMP_VERIFY_CHECKSUM) {
+        return readMemoryChecksum(dataSize, startBank, startAddress) == checksum;
+    }
     return true;
 }
-bool MPU6050::writeProgMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, bool verify) {
+bool MPU6050::writeProgMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, uint8_t verify) {
     return writeMemoryBlock(data, dataSize, bank, address, verify, true);
 }
-bool MPU6050::writeDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, bool useProgMem) {
+bool MPU6050::writeDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, bool useProgMem, uint8_t verify) {
     uint8_t *progBuffer, success, special;
     uint16_t i, j;
     if (useProgMem) {
@@ -3078,7 +3152,7 @@ bool MPU6050::writeDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, b
             } else {
                 progBuffer = (uint8_t *)data + i;
             }
-            success = writeMemoryBlock(progBuffer, length, bank, offset, true);
+            success = writeMemoryBlock(progBuffer, length, bank, offset, verify);
             i += length;
         } else {
             // special instruction
@@ -3117,8 +3191,8 @@ bool MPU6050::writeDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, b
     if (useProgMem) free(progBuffer);
     return true;
 }
-bool MPU6050::writeProgDMPConfigurationSet(const uint8_t *data, uint16_t dataSize) {
-    return writeDMPConfigurationSet(data, dataSize, true);
+bool MPU6050::writeProgDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, uint8_t verify) {
+    return writeDMPConfigurationSet(data, dataSize, true, verify);
 }
 
 // DMP_CFG_1 register
@@ -396,9 +396,31 @@ THE SOFTWARE.
 #define MPU6050_DMP_MEMORY_BANK_SIZE    256
 #define MPU6050_DMP_MEMORY_CHUNK_SIZE   16
 
+// largest MEM_R_W write: the register address and the data share the bus buffer
+#ifndef MPU6050_DMP_MEMORY_BURST_SIZE
+    #if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE && defined(BUFFER_LENGTH)
+        #define MPU6050_DMP_MEMORY_BURST_SIZE   (BUFFER_LENGTH - 1)
+    #elif I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_NBWIRE
+        #define MPU6050_DMP_MEMORY_BURST_SIZE   (NBWIRE_BUFFER_LENGTH - 1)
+    #else
+        #define MPU6050_DMP_MEMORY_BURST_SIZE   MPU6050_DMP_MEMORY_CHUNK_SIZE
+    #endif
+#endif
+
+// writeMemoryBlock() verify modes (false and true keep their old meaning)
+#define MPU6050_DMP_VERIFY_NONE         0
+#define MPU6050_DMP_VERIFY_CHUNK        1 // read back and compare every chunk
+#define MPU6050_DMP_VERIFY_CHECKSUM     2 // read back once at the end, compare checksums
+
 // note: DMP code memory blocks defined at end of header file
 
 class MPU6050 {
+    // first, so MPU6050.cpp and a sketch with the DMP members below
+    // agree on where they are
+    private:
+        uint8_t devAddr;
+        uint8_t buffer[14];
+
     public:
         MPU6050();
         MPU6050(uint8_t address);
@@ -671,7 +693,7 @@ class MPU6050 {
         // FIFO_R_W register
         uint8_t getFIFOByte();
         void setFIFOByte(uint8_t data);
-        void getFIFOBytes(uint8_t *data, uint8_t length);
+        int8_t getFIFOBytes(uint8_t *data, uint8_t length);
 
         // WHO_AM_I register
         uint8_t getDeviceID();
@@ -762,11 +784,12 @@ class MPU6050 {
         uint8_t readMemoryByte();
         void writeMemoryByte(uint8_t data);
         void readMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0);
-        bool writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, bool verify=true, bool useProgMem=false);
-        bool writeProgMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, bool verify=true);
+        uint32_t readMemoryChecksum(uint16_t dataSize, uint8_t bank=0, uint8_t address=0);
+        bool writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, uint8_t verify=MPU6050_DMP_VERIFY_CHUNK, bool useProgMem=false);
+        bool writeProgMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, uint8_t verify=MPU6050_DMP_VERIFY_CHUNK);
 
-        bool writeDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, bool useProgMem=false);
-        bool writeProgDMPConfigurationSet(const uint8_t *data, uint16_t dataSize);
+        bool writeDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, bool useProgMem=false, uint8_t verify=MPU6050_DMP_VERIFY_CHUNK);
+        bool writeProgDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, uint8_t verify=MPU6050_DMP_VERIFY_CHUNK);
 
         // DMP_CFG_1 register
         uint8_t getDMPConfig1();
@@ -780,8 +803,10 @@ class MPU6050 {
         #ifdef MPU6050_INCLUDE_DMP_MOTIONAPPS20
             uint8_t *dmpPacketBuffer;
             uint16_t dmpPacketSize;
+            uint32_t dmpUploadTime;
 
             uint8_t dmpInitialize();
+            uint32_t dmpGetUploadTime();
             bool dmpPacketAvailable();
 
             uint8_t dmpSetFIFORate(uint8_t fifoRate);
@@ -979,9 +1004,6 @@ class MPU6050 {
             uint16_t dmpGetFIFOPacketSize();
         #endif
 
-    private:
-        uint8_t devAddr;
-        uint8_t buffer[14];
 };
 
 #endif /* _MPU6050_H_ */
@@ -117,6 +117,15 @@ THE SOFTWARE.
 #define MPU6050_DMP_CONFIG_SIZE     192     // dmpConfig[]
 #define MPU6050_DMP_UPDATES_SIZE    47      // dmpUpdates[]
 
+// how dmpInitialize() checks the DMP code, config and updates it writes:
+// _NONE (default) not at all, MPU6050_DMP_VERIFY_CHECKSUM reads everything
+// back once (about twice the upload time), _CHUNK after every chunk (slower
+// still, but finds the chunk that failed). Define it before including this
+// file to opt in.
+#ifndef MPU6050_DMP_UPLOAD_VERIFY
+    #define MPU6050_DMP_UPLOAD_VERIFY MPU6050_DMP_VERIFY_NONE
+#endif
+
 /* ================================================================================================ *
  | Default MotionApps v2.0 42-byte FIFO packet structure:                                           |
  |                                                                                                  |
@@ -383,15 +392,21 @@ uint8_t MPU6050::dmpInitialize() {
     DEBUG_PRINT(F("Writing DMP code to MPU memory banks ("));
     DEBUG_PRINT(MPU6050_DMP_CODE_SIZE);
     DEBUG_PRINTLN(F(" bytes)"));
-    if (writeProgMemoryBlock(dmpMemory, MPU6050_DMP_CODE_SIZE)) {
+    dmpUploadTime = 0;
+    uint32_t uploadStart = micros();
+    if (writeProgMemoryBlock(dmpMemory, MPU6050_DMP_CODE_SIZE, 0, 0, MPU6050_DMP_UPLOAD_VERIFY)) {
         DEBUG_PRINTLN(F("Success! DMP code written and verified."));
 
         // write DMP configuration
         DEBUG_PRINT(F("Writing DMP configuration to MPU memory banks ("));
         DEBUG_PRINT(MPU6050_DMP_CONFIG_SIZE);
         DEBUG_PRINTLN(F(" bytes in config def)"));
-        if (writeProgDMPConfigurationSet(dmpConfig, MPU6050_DMP_CONFIG_SIZE)) {
+        if (writeProgDMPConfigurationSet(dmpConfig, MPU6050_DMP_CONFIG_SIZE, MPU6050_DMP_UPLOAD_VERIFY)) {
             DEBUG_PRINTLN(F("Success! DMP configuration written and verified."));
+            dmpUploadTime = micros() - uploadStart;
+            DEBUG_PRINT(F("DMP code and configuration took "));
+            DEBUG_PRINT(dmpUploadTime);
+            DEBUG_PRINTLN(F(" us"));
 
             DEBUG_PRINTLN(F("Setting clock source to Z Gyro..."));
             setClockSource(MPU6050_CLOCK_PLL_ZGYRO);
@@ -432,11 +447,11 @@ uint8_t MPU6050::dmpInitialize() {
             uint8_t dmpUpdate[16], j;
             uint16_t pos = 0;
             for (j = 0; j < 4 || j < dmpUpdate[2] + 3; j++, pos++) dmpUpdate[j] = pgm_read_byte(&dmpUpdates[pos]);
-            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1]);
+            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1], MPU6050_DMP_UPLOAD_VERIFY);
 
             DEBUG_PRINTLN(F("Writing final memory update 2/7 (function unknown)..."));
             for (j = 0; j < 4 || j < dmpUpdate[2] + 3; j++, pos++) dmpUpdate[j] = pgm_read_byte(&dmpUpdates[pos]);
-            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1]);
+            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1], MPU6050_DMP_UPLOAD_VERIFY);
 
             DEBUG_PRINTLN(F("Resetting FIFO..."));
             resetFIFO();
@@ -475,15 +490,15 @@ uint8_t MPU6050::dmpInitialize() {
 
             DEBUG_PRINTLN(F("Writing final memory update 3/7 (function unknown)..."));
             for (j = 0; j < 4 || j < dmpUpdate[2] + 3; j++, pos++) dmpUpdate[j] = pgm_read_byte(&dmpUpdates[pos]);
-            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1]);
+            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1], MPU6050_DMP_UPLOAD_VERIFY);
 
             DEBUG_PRINTLN(F("Writing final memory update 4/7 (function unknown)..."));
             for (j = 0; j < 4 || j < dmpUpdate[2] + 3; j++, pos++) dmpUpdate[j] = pgm_read_byte(&dmpUpdates[pos]);
-            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1]);
+            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1], MPU6050_DMP_UPLOAD_VERIFY);
 
             DEBUG_PRINTLN(F("Writing final memory update 5/7 (function unknown)..."));
             for (j = 0; j < 4 || j < dmpUpdate[2] + 3; j++, pos++) dmpUpdate[j] = pgm_read_byte(&dmpUpdates[pos]);
-            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1]);
+            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1], MPU6050_DMP_UPLOAD_VERIFY);
 
             DEBUG_PRINTLN(F("Waiting for FIFO count > 2..."));
             while ((fifoCount = getFIFOCount()) < 3);
@@ -520,7 +535,7 @@ uint8_t MPU6050::dmpInitialize() {
 
             DEBUG_PRINTLN(F("Writing final memory update 7/7 (function unknown)..."));
             for (j = 0; j < 4 || j < dmpUpdate[2] + 3; j++, pos++) dmpUpdate[j] = pgm_read_byte(&dmpUpdates[pos]);
-            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1]);
+            writeMemoryBlock(dmpUpdate + 3, dmpUpdate[2], dmpUpdate[0], dmpUpdate[1], MPU6050_DMP_UPLOAD_VERIFY);
 
             DEBUG_PRINTLN(F("DMP is good to go! Finally."));
 
@@ -738,4 +753,12 @@ uint16_t MPU6050::dmpGetFIFOPacketSize() {
     return dmpPacketSize;
 }
 
+/** Time the last dmpInitialize() took to write and verify the DMP code and
+ * configuration.
+ * @return Microseconds, 0 if the upload failed
+ */
+uint32_t MPU6050::dmpGetUploadTime() {
+    return dmpUploadTime;
+}
+
 #endif /* _MPU6050_6AXIS_MOTIONAPPS20_H_ */
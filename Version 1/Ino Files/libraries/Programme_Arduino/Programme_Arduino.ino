@@ -8,6 +8,8 @@
 MPU6050 mpu;
 #define OUTPUT_READABLE_YAWPITCHROLL
 #define LED_PIN 13 
+#define DRAIN_MAX_PACKETS 3     // packets read per I2C burst; 3 x 42 bytes, within the 127 readBytes() reports
+#define FIFO_SIZE 1024
 bool blinkState = false;
 
 // MPU control/status vars
@@ -16,7 +18,7 @@ uint8_t mpuIntStatus;   // holds actual interrupt status byte from MPU
 uint8_t devStatus;      // return status after each device operation (0 = success, !0 = error)
 uint16_t packetSize;    // expected DMP packet size (default is 42 bytes)
 uint16_t fifoCount;     // count of all bytes currently in FIFO
-uint8_t fifoBuffer[64]; // FIFO storage buffer
+uint8_t fifoBuffer[DRAIN_MAX_PACKETS * 42]; // FIFO storage buffer, several packets per burst
 
 // orientation/motion vars
 Quaternion q;           // [w, x, y, z]         quaternion container
@@ -92,130 +94,142 @@ void setup() {
 }
 
 // ================================================================
-// ===                    MAIN PROGRAM LOOP                     ===
+// ===                    PACKET PROCESSING                     ===
 // ================================================================
 
-void loop() {
-    // if programming failed, don't try to do anything
-    if (!dmpReady) return;
+void processPacket(const uint8_t *packet) {
+    #ifdef OUTPUT_READABLE_QUATERNION
+        // display quaternion values in easy matrix form: w x y z
+        mpu.dmpGetQuaternion(&q, packet);
+        Serial.print("quat\t");
+        Serial.print(q.w);
+        Serial.print("\t");
+        Serial.print(q.x);
+        Serial.print("\t");
+        Serial.print(q.y);
+        Serial.print("\t");
+        Serial.println(q.z);
+    #endif
 
-    // wait for MPU interrupt or extra packet(s) available
-    while (!mpuInterrupt && fifoCount < packetSize) {
- 
-    }
+    #ifdef OUTPUT_READABLE_EULER
+        // display Euler angles in degrees
+        mpu.dmpGetQuaternion(&q, packet);
+        mpu.dmpGetEuler(euler, &q);
+        Serial.print("euler\t");
+        Serial.print(euler[0] * 180/M_PI);
+        Serial.print("\t");
+        Serial.print(euler[1] * 180/M_PI);
+        Serial.print("\t");
+        Serial.println(euler[2] * 180/M_PI);
+    #endif
 
-    // reset interrupt flag and get INT_STATUS byte
-    mpuInterrupt = false;
-    mpuIntStatus = mpu.getIntStatus();
+    #ifdef OUTPUT_READABLE_YAWPITCHROLL
+        // display Euler angles in degrees
+        mpu.dmpGetQuaternion(&q, packet);
+        mpu.dmpGetGravity(&gravity, &q);
+        mpu.dmpGetYawPitchRoll(ypr, &q, &gravity);
+        Serial.print("Phi: ");
+        Serial.print(ypr[2] * 18/M_PI);
+        Serial.print("\t Theta: ");
+        Serial.print(" ");
+        Serial.print(ypr[1] * 180/M_PI);
+        Serial.print("\t Psi: ");
+        Serial.print(" ");
+        Serial.println(ypr[0] * 180/M_PI);
+        //delay(100);
+    #endif
+
+    #ifdef OUTPUT_READABLE_REALACCEL
+        // display real acceleration, adjusted to remove gravity
+        mpu.dmpGetQuaternion(&q, packet);
+        mpu.dmpGetAccel(&aa, packet);
+        mpu.dmpGetGravity(&gravity, &q);
+        mpu.dmpGetLinearAccel(&aaReal, &aa, &gravity);
+        Serial.print("areal\t");
+        Serial.print(aaReal.x);
+        Serial.print("\t");
+        Serial.print(aaReal.y);
+        Serial.print("\t");
+        Serial.println(aaReal.z);
+    #endif
+
+    #ifdef OUTPUT_READABLE_WORLDACCEL
+        // display initial world-frame acceleration, adjusted to remove gravity
+        // and rotated based on known orientation from quaternion
+        mpu.dmpGetQuaternion(&q, packet);
+        mpu.dmpGetAccel(&aa, packet);
+        mpu.dmpGetGravity(&gravity, &q);
+        mpu.dmpGetLinearAccel(&aaReal, &aa, &gravity);
+        mpu.dmpGetLinearAccelInWorld(&aaWorld, &aaReal, &q);
+        Serial.print("aworld\t");
+        Serial.print(aaWorld.x);
+        Serial.print("\t");
+        Serial.print(aaWorld.y);
+        Serial.print("\t");
+        Serial.println(aaWorld.z);
+    #endif
+
+    #ifdef OUTPUT_TEAPOT
+        // display quaternion values in InvenSense Teapot demo format:
+        teapotPacket[2] = packet[0];
+        teapotPacket[3] = packet[1];
+        teapotPacket[4] = packet[4];
+        teapotPacket[5] = packet[5];
+        teapotPacket[6] = packet[8];
+        teapotPacket[7] = packet[9];
+        teapotPacket[8] = packet[12];
+        teapotPacket[9] = packet[13];
+        Serial.write(teapotPacket, 14);
+        teapotPacket[11]++; // packetCount, loops at 0xFF on purpose
+    #endif
+}
+
+// ================================================================
+// ===                       FIFO DRAIN                         ===
+// ================================================================
 
-    // get current FIFO count
+// Reads every complete packet in the FIFO, DRAIN_MAX_PACKETS per burst
+// (one I2C read each with a Wire that reads into fifoBuffer), and processes them
+// oldest first. The FIFO count is the only register polled: the FIFO
+// only fills up when it overflowed, and then the packet boundaries are
+// lost (the MPU keeps writing over the oldest bytes), so it is reset and
+// the next interrupt starts on a clean packet.
+void drainFIFO() {
     fifoCount = mpu.getFIFOCount();
 
     // check for overflow (this should never happen unless our code is too inefficient)
-    if ((mpuIntStatus & 0x10) || fifoCount == 1024) {
-        // reset so we can continue cleanly
+    if (fifoCount >= FIFO_SIZE) {
         mpu.resetFIFO();
         //Serial.println(F("FIFO overflow!"));
+        return;
+    }
 
-    // otherwise, check for DMP data ready interrupt (this should happen frequently)
-    } else if (mpuIntStatus & 0x02) {
-        // wait for correct available data length, should be a VERY short wait
-        while (fifoCount < packetSize) fifoCount = mpu.getFIFOCount();
-
-        // read a packet from FIFO
-        mpu.getFIFOBytes(fifoBuffer, packetSize);
-        
-        // track FIFO count here in case there is > 1 packet available
-        // (this lets us immediately read more without waiting for an interrupt)
-        fifoCount -= packetSize;
-
-        #ifdef OUTPUT_READABLE_QUATERNION
-            // display quaternion values in easy matrix form: w x y z
-            mpu.dmpGetQuaternion(&q, fifoBuffer);
-            Serial.print("quat\t");
-            Serial.print(q.w);
-            Serial.print("\t");
-            Serial.print(q.x);
-            Serial.print("\t");
-            Serial.print(q.y);
-            Serial.print("\t");
-            Serial.println(q.z);
-        #endif
-
-        #ifdef OUTPUT_READABLE_EULER
-            // display Euler angles in degrees
-            mpu.dmpGetQuaternion(&q, fifoBuffer);
-            mpu.dmpGetEuler(euler, &q);
-            Serial.print("euler\t");
-            Serial.print(euler[0] * 180/M_PI);
-            Serial.print("\t");
-            Serial.print(euler[1] * 180/M_PI);
-            Serial.print("\t");
-            Serial.println(euler[2] * 180/M_PI);
-        #endif
-
-        #ifdef OUTPUT_READABLE_YAWPITCHROLL
-            // display Euler angles in degrees
-            mpu.dmpGetQuaternion(&q, fifoBuffer);
-            mpu.dmpGetGravity(&gravity, &q);
-            mpu.dmpGetYawPitchRoll(ypr, &q, &gravity);
-            Serial.print("Phi: ");
-            Serial.print(ypr[2] * 18/M_PI);
-            Serial.print("\t Theta: ");
-            Serial.print(" ");
-            Serial.print(ypr[1] * 180/M_PI);
-            Serial.print("\t Psi: ");
-            Serial.print(" ");
-            Serial.println(ypr[0] * 180/M_PI);
-            //delay(100);
-        #endif
-
-        #ifdef OUTPUT_READABLE_REALACCEL
-            // display real acceleration, adjusted to remove gravity
-            mpu.dmpGetQuaternion(&q, fifoBuffer);
-            mpu.dmpGetAccel(&aa, fifoBuffer);
-            mpu.dmpGetGravity(&gravity, &q);
-            mpu.dmpGetLinearAccel(&aaReal, &aa, &gravity);
-            Serial.print("areal\t");
-            Serial.print(aaReal.x);
-            Serial.print("\t");
-            Serial.print(aaReal.y);
-            Serial.print("\t");
-            Serial.println(aaReal.z);
-        #endif
-
-        #ifdef OUTPUT_READABLE_WORLDACCEL
-            // display initial world-frame acceleration, adjusted to remove gravity
-            // and rotated based on known orientation from quaternion
-            mpu.dmpGetQuaternion(&q, fifoBuffer);
-            mpu.dmpGetAccel(&aa, fifoBuffer);
-            mpu.dmpGetGravity(&gravity, &q);
-            mpu.dmpGetLinearAccel(&aaReal, &aa, &gravity);
-            mpu.dmpGetLinearAccelInWorld(&aaWorld, &aaReal, &q);
-            Serial.print("aworld\t");
-            Serial.print(aaWorld.x);
-            Serial.print("\t");
-            Serial.print(aaWorld.y);
-            Serial.print("\t");
-            Serial.println(aaWorld.z);
-        #endif
-    
-        #ifdef OUTPUT_TEAPOT
-            // display quaternion values in InvenSense Teapot demo format:
-            teapotPacket[2] = fifoBuffer[0];
-            teapotPacket[3] = fifoBuffer[1];
-            teapotPacket[4] = fifoBuffer[4];
-            teapotPacket[5] = fifoBuffer[5];
-            teapotPacket[6] = fifoBuffer[8];
-            teapotPacket[7] = fifoBuffer[9];
-            teapotPacket[8] = fifoBuffer[12];
-            teapotPacket[9] = fifoBuffer[13];
-            Serial.write(teapotPacket, 14);
-            teapotPacket[11]++; // packetCount, loops at 0xFF on purpose
-        #endif
-
-        // blink LED to indicate activity
-        blinkState = !blinkState;
-        digitalWrite(LED_PIN, blinkState);
+    while (fifoCount >= packetSize) {
+        uint8_t packets = min(fifoCount / packetSize, DRAIN_MAX_PACKETS);
+        // a short read leaves the FIFO off its packet boundaries
+        if (mpu.getFIFOBytes(fifoBuffer, packets * packetSize) != (int8_t)(packets * packetSize)) {
+            mpu.resetFIFO();
+            return;
+        }
+        fifoCount -= packets * packetSize;
+        for (uint8_t i = 0; i < packets; i++) processPacket(fifoBuffer + i * packetSize);
     }
+
+    // blink LED to indicate activity
+    blinkState = !blinkState;
+    digitalWrite(LED_PIN, blinkState);
+}
+
+// ================================================================
+// ===                    MAIN PROGRAM LOOP                     ===
+// ================================================================
+
+void loop() {
+    // if programming failed, don't try to do anything
+    if (!dmpReady) return;
+
+    // wait for MPU interrupt, loop() is free until then
+    if (!mpuInterrupt) return;
+    mpuInterrupt = false;
+    drainFIFO();
 }
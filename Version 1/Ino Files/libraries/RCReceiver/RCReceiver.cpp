@@ -0,0 +1,140 @@
+//
+//    FILE: RCReceiver.cpp
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: PWM RC receiver decoder on pin change interrupts
+//
+// HISTORY:
+// 0.1.0 - 2026-10-18 initial version
+//
+// Released to the public domain
+//
+
+#include "RCReceiver.h"
+
+RCReceiver::RCReceiver(const uint8_t firstPin, const uint8_t channels)
+  : _firstPin(firstPin), _channels(channels), _firstBit(0), _mask(0),
+    _clock(RC_RECEIVER_MICROS), _shift(0),
+    _levels(0), _armed(0), _fresh(0), _glitches(0),
+    _valid(0), _jumping(0), _maxJump(300), _timeout(100), _spikes(0)
+{
+  if (_channels > RC_RECEIVER_MAX_CHANNELS) _channels = RC_RECEIVER_MAX_CHANNELS;
+  for (uint8_t n = 0; n < RC_RECEIVER_MAX_CHANNELS; n++)
+  {
+    _width[n] = 0;
+    _failsafe[n] = 0;
+    _lastPulse[n] = 0;
+  }
+  setLimits(800, 2200);
+}
+
+void RCReceiver::begin(const uint8_t clock)
+{
+  _clock = clock;
+  _shift = 0;
+  if (_clock == RC_RECEIVER_TIMER1)
+  {
+    // normal mode, prescaler 8: 0.5 us ticks, wraps every 32.8 ms
+    TCCR1A = 0;
+    TCCR1B = _BV(CS11);
+    _shift = 1;
+  }
+  setLimits(_minimum, _maximum);
+
+  _firstBit = digitalPinToPCMSKbit(_firstPin);
+  _mask = (1 << _channels) - 1;
+  uint8_t levels = 0;
+  for (uint8_t n = 0; n < _channels; n++)
+  {
+    uint8_t pin = _firstPin + n;
+    pinMode(pin, INPUT);
+    if (digitalRead(pin)) levels |= 1 << n;
+  }
+
+  // start over: every channel lost until its first pulse
+  _valid = 0;
+  _jumping = 0;
+  noInterrupts();
+  _levels = levels;
+  _armed = 0;
+  _fresh = 0;
+  *digitalPinToPCMSK(_firstPin) |= _mask << _firstBit;
+  PCIFR |= _BV(digitalPinToPCICRbit(_firstPin));   // no interrupt from before
+  PCICR |= _BV(digitalPinToPCICRbit(_firstPin));
+  interrupts();
+}
+
+bool RCReceiver::update()
+{
+  uint16_t pulse[RC_RECEIVER_MAX_CHANNELS];
+  noInterrupts();
+  uint8_t fresh = _fresh;
+  _fresh = 0;
+  for (uint8_t n = 0; n < _channels; n++) pulse[n] = _pulse[n];
+  interrupts();
+  if (fresh == 0) return false;
+
+  uint32_t now = millis();
+  for (uint8_t n = 0; n < _channels; n++)
+  {
+    uint8_t bit = 1 << n;
+    if (!(fresh & bit)) continue;
+    _lastPulse[n] = now;
+    uint16_t width = pulse[n] >> _shift;
+
+    // a first pulse, a small step, or the second pulse of a jump; a jump
+    // that the next pulse does not confirm was a spike
+    bool small = abs((int16_t)(width - _width[n])) <= (int16_t)_maxJump;
+    bool confirmed = (_jumping & bit) && abs((int16_t)(width - _candidate[n])) <= (int16_t)_maxJump;
+    if ((_jumping & bit) && !confirmed) _spikes++;
+    if (!(_valid & bit) || small || confirmed)
+    {
+      _width[n] = width;
+      _valid |= bit;
+      _jumping &= ~bit;
+    }
+    else
+    {
+      _candidate[n] = width;
+      _jumping |= bit;
+    }
+  }
+  return true;
+}
+
+uint16_t RCReceiver::width(const uint8_t channel) const
+{
+  if (channel >= _channels) return 0;
+  return lost(channel) ? _failsafe[channel] : _width[channel];
+}
+
+bool RCReceiver::lost(const uint8_t channel) const
+{
+  if (channel >= _channels || !(_valid & (1 << channel))) return true;
+  return millis() - _lastPulse[channel] > _timeout;
+}
+
+void RCReceiver::setLimits(const uint16_t minimum, const uint16_t maximum)
+{
+  _minimum = minimum;
+  _maximum = maximum;
+  noInterrupts();
+  _minTicks = minimum << _shift;
+  _maxTicks = maximum << _shift;
+  interrupts();
+}
+
+void RCReceiver::setFailsafe(const uint8_t channel, const uint16_t us)
+{
+  if (channel < _channels) _failsafe[channel] = us;
+}
+
+uint16_t RCReceiver::glitches() const
+{
+  noInterrupts();
+  uint16_t glitches = _glitches;
+  interrupts();
+  return glitches + _spikes;
+}
+
+// END OF FILE
@@ -0,0 +1,143 @@
+//
+//    FILE: RCReceiver.h
+//  AUTHOR: Keyrim
+// PURPOSE: PWM RC receiver decoder on pin change interrupts
+// VERSION: 0.1.0
+// HISTORY: See RCReceiver.cpp
+//
+// Released to the public domain
+//
+// Up to 8 channels on consecutive pins of one port, i.e. one pin change
+// group. The sketch's ISR reads the port once and hands it over:
+//
+//   ISR(PCINT0_vect) { receiver.handleInterrupt(PINB); }
+//
+// handleInterrupt() diffs the port against the previous read and
+// timestamps all the edges it finds with a single clock read:
+//   RC_RECEIVER_TIMER1  Timer1 free running, 0.5 us; fine with
+//                       SoftwareServo, not with the Servo library, which
+//                       restarts Timer1 every frame
+//   RC_RECEIVER_MICROS  micros(), 4 us
+// A pulse outside the limits is a glitch and is dropped right there.
+//
+// update(), from the loop, takes the new pulses. A jump of more than
+// maxJump from the last width is only taken once the next pulse confirms
+// it, so a single bad pulse never reaches the outputs. A channel without
+// a pulse for the timeout is lost and width() returns its failsafe.
+//
+
+#ifndef RCReceiver_h
+#define RCReceiver_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <inttypes.h>
+
+#define RC_RECEIVER_LIB_VERSION "0.1.0"
+
+#define RC_RECEIVER_MAX_CHANNELS  8
+
+// clocks for begin()
+#define RC_RECEIVER_MICROS        0
+#define RC_RECEIVER_TIMER1        1
+
+
+class RCReceiver
+{
+public:
+  // channels on firstPin, firstPin + 1, ... in the same port
+  RCReceiver(const uint8_t firstPin, const uint8_t channels);
+
+  // inputs, pin change interrupts and the clock; all channels are lost
+  // until their first pulse
+  void begin(const uint8_t clock = RC_RECEIVER_MICROS);
+
+  // from ISR(PCINTn_vect) with the port's PINx
+  inline void handleInterrupt(const uint8_t port)
+  {
+    uint16_t now = _clock == RC_RECEIVER_TIMER1 ? TCNT1 : (uint16_t)micros();
+    uint8_t levels = port >> _firstBit;
+    uint8_t changed = (levels ^ _levels) & _mask;
+    _levels = levels;
+    uint8_t bit = 1;
+    for (uint8_t n = 0; changed; n++, bit <<= 1)
+    {
+      if (!(changed & bit)) continue;
+      changed &= ~bit;
+      if (levels & bit)
+      {
+        _rise[n] = now;
+        _armed |= bit;
+      }
+      else if (_armed & bit)
+      {
+        uint16_t width = now - _rise[n];
+        if (width < _minTicks || width > _maxTicks) _glitches++;
+        else
+        {
+          _pulse[n] = width;
+          _fresh |= bit;
+        }
+      }
+    }
+  };
+
+  // takes the pulses received since the last call, call it from the loop
+  // at least once per frame; true if there was a new one
+  bool update();
+
+  // us, the failsafe when the channel is lost
+  uint16_t width(const uint8_t channel) const;
+  // no pulse yet, or none for the timeout
+  bool     lost(const uint8_t channel) const;
+
+  // pulses outside are glitches, default 800..2200 us
+  void setLimits(const uint16_t minimum, const uint16_t maximum);
+  // larger steps wait for a second pulse, default 300 us
+  void setMaxJump(const uint16_t us)   { _maxJump = us; };
+  // default 100 ms, 5 frames
+  void setTimeout(const uint16_t ms)   { _timeout = ms; };
+  // default 0
+  void setFailsafe(const uint8_t channel, const uint16_t us);
+
+  // out of the limits plus unconfirmed jumps
+  uint16_t glitches() const;
+  uint8_t  channels() const { return _channels; };
+
+private:
+  uint8_t  _firstPin;
+  uint8_t  _channels;
+  uint8_t  _firstBit;         // of firstPin in the port
+  uint8_t  _mask;             // channel bits, after the shift by _firstBit
+  uint8_t  _clock;
+  uint8_t  _shift;            // clock ticks to us
+
+  // written by handleInterrupt()
+  volatile uint8_t  _levels;
+  volatile uint8_t  _armed;   // rising edge seen
+  volatile uint8_t  _fresh;   // pulse not taken by update() yet
+  volatile uint16_t _glitches;
+  volatile uint16_t _rise[RC_RECEIVER_MAX_CHANNELS];
+  volatile uint16_t _pulse[RC_RECEIVER_MAX_CHANNELS];    // ticks
+  uint16_t _minTicks;
+  uint16_t _maxTicks;
+
+  uint16_t _width[RC_RECEIVER_MAX_CHANNELS];
+  uint16_t _candidate[RC_RECEIVER_MAX_CHANNELS];       // a jump to confirm
+  uint16_t _failsafe[RC_RECEIVER_MAX_CHANNELS];
+  uint32_t _lastPulse[RC_RECEIVER_MAX_CHANNELS];       // millis()
+  uint8_t  _valid;            // a width was taken
+  uint8_t  _jumping;          // _candidate holds a jump
+  uint16_t _minimum;
+  uint16_t _maximum;
+  uint16_t _maxJump;
+  uint16_t _timeout;
+  uint16_t _spikes;
+};
+
+#endif
+// END OF FILE
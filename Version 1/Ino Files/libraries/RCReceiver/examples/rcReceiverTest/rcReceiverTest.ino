@@ -0,0 +1,97 @@
+//
+//    FILE: rcReceiverTest.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: RCReceiver on pins 8..11, resolution of the clocks, glitches and signal loss
+//    DATE: 2026-10-18
+//     URL:
+//
+// Released to the public domain
+//
+// Two seconds on micros(), then two on Timer1: the spread (max - min) of
+// each channel shows the resolution. Then the widths every 250 ms, with
+// the glitch count and L for a lost channel (failsafe 1500, 1500, 1000,
+// 1500).
+//
+// On the host: build/rcReceiverTest --virtual --rc 1101,1502,1903,1000
+//              --rc-glitch 10 --rc-loss 6,7 --seconds 9
+// reads 1100, 1500, 1904, 1000 on micros() and 1101, 1502, 1903, 1000 on
+// Timer1; the noise pulses are counted as glitches and never show in the
+// widths, and the outage turns into the failsafe values.
+//
+
+#include <RCReceiver.h>
+
+RCReceiver receiver(8, 4);
+uint32_t last;
+
+ISR(PCINT0_vect)
+{
+  receiver.handleInterrupt(PINB);
+}
+
+void measure(uint8_t clock)
+{
+  receiver.begin(clock);
+  uint16_t low[4] = { 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF };
+  uint16_t high[4] = { 0, 0, 0, 0 };
+  uint32_t start = millis();
+  while (millis() - start < 2000)
+  {
+    if (!receiver.update()) continue;
+    for (uint8_t n = 0; n < 4; n++)
+    {
+      if (receiver.lost(n)) continue;
+      uint16_t w = receiver.width(n);
+      if (w < low[n]) low[n] = w;
+      if (w > high[n]) high[n] = w;
+    }
+  }
+  Serial.print(clock == RC_RECEIVER_TIMER1 ? "Timer1\t" : "micros\t");
+  for (uint8_t n = 0; n < 4; n++)
+  {
+    Serial.print(low[n]);
+    Serial.print("..");
+    Serial.print(high[n]);
+    Serial.print("\t");
+  }
+  Serial.println();
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("RC_RECEIVER_LIB_VERSION: ");
+  Serial.println(RC_RECEIVER_LIB_VERSION);
+
+  receiver.setFailsafe(0, 1500);
+  receiver.setFailsafe(1, 1500);
+  receiver.setFailsafe(2, 1000);
+  receiver.setFailsafe(3, 1500);
+
+  Serial.println("\nclock\tch 0\t\tch 1\t\tch 2\t\tch 3");
+  measure(RC_RECEIVER_MICROS);
+  measure(RC_RECEIVER_TIMER1);
+  Serial.println("\nms\tch 0\tch 1\tch 2\tch 3\tglitches");
+  last = millis();
+}
+
+void loop()
+{
+  receiver.update();
+  if (millis() - last < 250) return;
+  last += 250;
+
+  Serial.print(millis());
+  for (uint8_t n = 0; n < 4; n++)
+  {
+    Serial.print("\t");
+    Serial.print(receiver.width(n));
+    if (receiver.lost(n)) Serial.print(" L");
+  }
+  Serial.print("\t");
+  Serial.println(receiver.glitches());
+}
+
+// END OF FILE
@@ -1,7 +1,7 @@
 //
 //    FILE: RunningAverage.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.2.13
+// VERSION: 0.2.14
 //    DATE: 2015-July-10
 // PURPOSE: RunningAverage library for Arduino
 //
@@ -28,6 +28,7 @@
 // 0.2.12 - 2016-12-01 added GetStandardDeviation() GetStandardError() BufferIsFull()  (V0v1kkk)
 // 0.2.13 - 2017-07-26 revert double to float - issue #33;
 //                     refactored a bit; marked some TODO's; all function names to camelCase
+// 0.2.14 - 2026-10-18 added RunningAverageT, size fixed at compile time, integer sum
 //
 // Released to the public domain
 //
@@ -1,7 +1,7 @@
 //
 //    FILE: RunningAverage.h
 //  AUTHOR: Rob.Tillaart@gmail.com
-// VERSION: 0.2.13
+// VERSION: 0.2.14
 //    DATE: 2016-dec-01
 // PURPOSE: RunningAverage library for Arduino
 //     URL: https://github.com/RobTillaart/Arduino/tree/master/libraries/RunningAverage
@@ -17,7 +17,7 @@
 #ifndef RunningAverage_h
 #define RunningAverage_h
 
-#define RUNNINGAVERAGE_LIB_VERSION "0.2.13"
+#define RUNNINGAVERAGE_LIB_VERSION "0.2.14"
 
 #include "Arduino.h"
 
@@ -67,5 +67,121 @@ protected:
   float   _max;
 };
 
+
+
+// accumulator of RunningAverageT: 32 bits for integers up to 16 bits,
+// whose sum of 255 values cannot overflow, 64 for wider ones, the type
+// itself for float and double
+template <typename S>
+struct RunningAverageInteger
+{
+  typedef S Sum;
+
+  // floor((sum + n / 2) / n), the shift floors by itself (arithmetic
+  // shift of a negative sum, as avr-gcc and gcc do)
+  static Sum divide(const Sum sum, const uint8_t n, const uint8_t shift)
+  {
+    Sum s = sum + n / 2;
+    if (shift) return s >> shift;
+    Sum q = s / n;
+    return q * n > s ? q - 1 : q;
+  };
+};
+
+template <typename F>
+struct RunningAverageFloat
+{
+  typedef F Sum;
+
+  static Sum divide(const Sum sum, const uint8_t n, const uint8_t) { return sum / n; };
+};
+
+template <typename T, uint8_t BYTES = sizeof(T)>
+struct RunningAverageMath : RunningAverageInteger<int32_t> {};
+template <typename T> struct RunningAverageMath<T, 4> : RunningAverageInteger<int64_t> {};
+template <typename T> struct RunningAverageMath<T, 8> : RunningAverageInteger<int64_t> {};
+template <> struct RunningAverageMath<float, sizeof(float)> : RunningAverageFloat<float> {};
+template <> struct RunningAverageMath<double, sizeof(double)> : RunningAverageFloat<double> {};
+
+// RunningAverage with the size fixed at compile time:
+//
+//   RunningAverageT<int, 64> ra;
+//   ra.addValue(x);
+//   ra.getAverage();
+//
+// The buffer is a member, no malloc(), and the running sum is kept in
+// an integer for integer T, so it never drifts and getAverage() is one
+// conversion and one multiply by the constant 1 / N once the buffer is
+// full. getRoundedAverage() gives the average as a T, for integer T
+// rounded to the nearest (halves upward) by a shift when N is a power of
+// two, by a division otherwise. For float T the sum picks up rounding
+// errors over time, as in getFastAverage(); clear() now and then.
+// No min, max or standard deviation, use RunningAverage for those.
+template <typename T, uint8_t N>
+class RunningAverageT
+{
+public:
+  static_assert(N > 0, "RunningAverageT needs a size");
+
+  typedef RunningAverageMath<T>     Math;
+  typedef typename Math::Sum        Sum;
+
+  RunningAverageT() { clear(); };
+
+  void clear()
+  {
+    _cnt = 0;
+    _idx = 0;
+    _sum = 0;
+    for (uint8_t i = 0; i < N; i++) _ar[i] = 0;   // keeps addValue simpler
+  };
+
+  void addValue(const T value)
+  {
+    _sum -= _ar[_idx];
+    _ar[_idx] = value;
+    _sum += value;
+    if (++_idx == N) _idx = 0;
+    if (_cnt < N) _cnt++;
+  };
+
+  // the param number determines how often value is added (weight)
+  void fillValue(const T value, const uint8_t number)
+  {
+    clear();
+    for (uint8_t i = 0; i < number; i++) addValue(value);
+  };
+
+  float getAverage() const
+  {
+    if (_cnt == N) return (float)_sum * (1.0f / N);
+    if (_cnt == 0) return NAN;
+    return (float)_sum / _cnt;
+  };
+
+  // 0 for an empty buffer
+  T getRoundedAverage() const
+  {
+    if (_cnt == N) return Math::divide(_sum, N, POWER_OF_TWO ? SHIFT : 0);
+    if (_cnt == 0) return 0;
+    return Math::divide(_sum, _cnt, 0);
+  };
+
+  Sum     getSum() const { return _sum; };
+  T       getElement(const uint8_t idx) const { return idx < _cnt ? _ar[idx] : 0; };
+  bool    bufferIsFull() const { return _cnt == N; };
+  uint8_t getSize() const { return N; };
+  uint8_t getCount() const { return _cnt; };
+
+  static constexpr bool    POWER_OF_TWO = (N & (N - 1)) == 0;
+  static constexpr uint8_t SHIFT = N >= 128 ? 7 : N >= 64 ? 6 : N >= 32 ? 5 : N >= 16 ? 4 : N >= 8 ? 3 : N >= 4 ? 2 : N >= 2 ? 1 : 0;
+
+private:
+  uint8_t _cnt;
+  uint8_t _idx;
+  Sum     _sum;
+  T       _ar[N];
+};
+
 #endif
 // END OF FILE
\ No newline at end of file
@@ -0,0 +1,164 @@
+//
+//    FILE: ra_templateBenchmark.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: RunningAverageT against RunningAverage and the Arduino_2 filter
+//    DATE: 2026-10-18
+//     URL:
+//
+// Released to the public domain
+//
+// The Arduino_2 angle filter, a float angle stored as an int in a window
+// of 50, done four ways: by hand as in Arduino_2 before RunningAverageT
+// (int buffer, float sum, / 50), with RunningAverage(50) and
+// getFastAverage(), with RunningAverageT<int, 50> and with
+// RunningAverageT<int, 64>, whose getRoundedAverage() is a shift. Prints
+// us per addValue() + average and the largest difference from the hand
+// rolled filter once the windows are full.
+//
+// On the host: build/ra_templateBenchmark --bare --loops 1
+// times the host in real time, for the ratios only, and noisy: 5 to 15
+// ns by hand, about 12 for RunningAverage and 2 to 7 for RunningAverageT.
+// RunningAverage gives the hand rolled averages exactly, RunningAverageT
+// within 0.000004, multiplying by 1 / 50 where they divide. The window
+// of 64 is a different filter and is only timed.
+//
+
+#include "RunningAverage.h"
+
+#ifdef __AVR__
+#define PASSES 1
+#else
+#define PASSES 1000 // the host needs more to get past micros() resolution
+#endif
+
+#define WINDOW  50
+#define SAMPLES 1000
+
+volatile float sink;
+volatile int   first;     // keeps the compiler from folding the loops
+
+// Arduino_2 before RunningAverageT
+int   valeurs[WINDOW];
+float somme;
+uint8_t i;
+
+float handRolled(const float angle)
+{
+  somme -= valeurs[i];
+  valeurs[i] = angle;
+  somme += valeurs[i];
+  if (++i == WINDOW) i = 0;
+  return somme / WINDOW;
+}
+
+// an angle swinging between -45 and 45 degrees with some noise
+float angle(const uint16_t n)
+{
+  return 45 * sin(n * 0.01) + (int)(n * 7919 % 13) - 6 + 0.5;
+}
+
+float angles[64];           // the samples cycle through these
+
+RunningAverage           ra(WINDOW);
+RunningAverageT<int, WINDOW> raInt;
+RunningAverageT<float, WINDOW> raFloat;
+RunningAverageT<int, 64> raShift;
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("RUNNINGAVERAGE_LIB_VERSION: ");
+  Serial.println(RUNNINGAVERAGE_LIB_VERSION);
+
+  for (uint8_t n = 0; n < 64; n++) angles[n] = angle(n);
+  float calls = (float)PASSES * SAMPLES;
+
+  uint32_t start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (uint16_t n = first; n < SAMPLES; n++) sink = handRolled(angles[n & 63]);
+  uint32_t handTime = micros() - start;
+
+  start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (uint16_t n = first; n < SAMPLES; n++)
+    {
+      ra.addValue((int)angles[n & 63]);
+      sink = ra.getFastAverage();
+    }
+  uint32_t raTime = micros() - start;
+
+  start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (uint16_t n = first; n < SAMPLES; n++)
+    {
+      raInt.addValue(angles[n & 63]);
+      sink = raInt.getAverage();
+    }
+  uint32_t intTime = micros() - start;
+
+  start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (uint16_t n = first; n < SAMPLES; n++)
+    {
+      raFloat.addValue((int)angles[n & 63]);
+      sink = raFloat.getAverage();
+    }
+  uint32_t floatTime = micros() - start;
+
+  start = micros();
+  for (uint16_t p = 0; p < PASSES; p++)
+    for (uint16_t n = first; n < SAMPLES; n++)
+    {
+      raShift.addValue(angles[n & 63]);
+      sink = raShift.getRoundedAverage();
+    }
+  uint32_t shiftTime = micros() - start;
+
+  // the same samples again, from clean filters
+  memset(valeurs, 0, sizeof(valeurs));
+  somme = 0;
+  i = 0;
+  ra.clear();
+  raInt.clear();
+  raFloat.clear();
+  float raDiff = 0, intDiff = 0, floatDiff = 0;
+  for (uint16_t n = 0; n < SAMPLES; n++)
+  {
+    float a = angle(n);
+    float reference = handRolled(a);
+    ra.addValue((int)a);
+    raInt.addValue(a);
+    raFloat.addValue((int)a);
+    if (n < WINDOW) continue;
+    raDiff = max(raDiff, fabs(ra.getFastAverage() - reference));
+    intDiff = max(intDiff, fabs(raInt.getAverage() - reference));
+    floatDiff = max(floatDiff, fabs(raFloat.getAverage() - reference));
+  }
+
+  Serial.println("\n\t\tus per call\tlargest difference");
+  Serial.print("by hand\t\t");
+  Serial.println(handTime / calls, 3);
+  Serial.print("RunningAverage\t");
+  Serial.print(raTime / calls, 3);
+  Serial.print("\t\t");
+  Serial.println(raDiff, 6);
+  Serial.print("<int, 50>\t");
+  Serial.print(intTime / calls, 3);
+  Serial.print("\t\t");
+  Serial.println(intDiff, 6);
+  Serial.print("<float, 50>\t");
+  Serial.print(floatTime / calls, 3);
+  Serial.print("\t\t");
+  Serial.println(floatDiff, 6);
+  Serial.print("<int, 64> shift\t");
+  Serial.println(shiftTime / calls, 3);
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
@@ -1,7 +1,7 @@
 //
 //    FILE: RunningMedian.cpp
 //  AUTHOR: Rob.Tillaart at gmail.com
-// VERSION: 0.1.15
+// VERSION: 0.2.1
 // PURPOSE: RunningMedian library for Arduino
 //
 // HISTORY:
@@ -21,6 +21,8 @@
 // 0.1.13 - 2015-10-30 fix getElement(n) - kudos to Gdunge
 // 0.1.14 - 2017-07-26 revert double to float - issue #33
 // 0.1.15 - 2018-08-24 make runningMedian Configurable #110
+// 0.2.0  - 2026-10-17 keep _p sorted in add() instead of bubble sorting on query
+// 0.2.1  - 2026-10-18 add() ignores NaN, which would break the order
 //
 // Released to the public domain
 //
@@ -52,26 +54,42 @@ void RunningMedian::clear()
 {
   _cnt = 0;
   _idx = 0;
-  _sorted = false;
-  for (uint8_t i = 0; i < _size; i++) _p[i] = i;
 }
 
 // adds a new value to the data-set
 // or overwrites the oldest if full.
+// _p stays in value order: the slot of the oldest value is taken out,
+// the new one goes in where a binary search puts it. Compares are the
+// expensive part on an AVR, the moves are single bytes.
+// NaN compares false with everything and has no place in that order:
+// it is not added.
 void RunningMedian::add(float value)
 {
+  if (isnan(value)) return;
+
+  if (_cnt < _size)
+  {
+    _cnt++;
+  }
+  else
+  {
+    // find the oldest slot; equal values sit together, step over them
+    uint8_t pos = lowerBound(_ar[_idx], _cnt);
+    while (_p[pos] != _idx) pos++;
+    memmove(&_p[pos], &_p[pos + 1], _cnt - 1 - pos);
+  }
+
+  uint8_t pos = upperBound(value, _cnt - 1);
+  memmove(&_p[pos + 1], &_p[pos], _cnt - 1 - pos);
+  _p[pos] = _idx;
   _ar[_idx++] = value;
   if (_idx >= _size) _idx = 0; // wrap around
-  if (_cnt < _size) _cnt++;
-  _sorted = false;
 }
 
 float RunningMedian::getMedian()
 {
   if (_cnt == 0) return NAN;
 
-  if (_sorted == false) sort();
-
   if (_cnt & 0x01) return _ar[_p[_cnt/2]];
   else return (_ar[_p[_cnt/2]] + _ar[_p[_cnt/2 - 1]]) / 2;
 }
@@ -94,8 +112,6 @@ float RunningMedian::getAverage(uint8_t nMedians)
   uint8_t start = ((_cnt - nMedians) / 2);
   uint8_t stop = start + nMedians;
 
-  if (_sorted == false) sort();
-
   float sum = 0;
   for (uint8_t i = start; i < stop; i++) sum += _ar[_p[i]];
   return sum / nMedians;
@@ -117,7 +133,6 @@ float RunningMedian::getSortedElement(const uint8_t n)
 {
   if ((_cnt == 0) || (n >= _cnt)) return NAN;
 
-  if (_sorted == false) sort();
   return _ar[_p[n]];
 }
 
@@ -126,7 +141,7 @@ float RunningMedian::predict(const uint8_t n)
 {
   if ((_cnt == 0) || (n >= _cnt/2)) return NAN;
 
-  float med = getMedian();  // takes care of sorting !
+  float med = getMedian();
   if (_cnt & 0x01)
   {
     return max(med - _ar[_p[_cnt/2-n]], _ar[_p[_cnt/2+n]] - med);
@@ -140,25 +155,30 @@ float RunningMedian::predict(const uint8_t n)
 }
 #endif
 
-void RunningMedian::sort()
+uint8_t RunningMedian::lowerBound(const float value, const uint8_t count)
+{
+  uint8_t lo = 0;
+  uint8_t hi = count;
+  while (lo < hi)
+  {
+    uint8_t mid = (lo + hi) / 2;
+    if (_ar[_p[mid]] < value) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+uint8_t RunningMedian::upperBound(const float value, const uint8_t count)
 {
-  // bubble sort with flag
-  for (uint8_t i = 0; i < _cnt-1; i++)
+  uint8_t lo = 0;
+  uint8_t hi = count;
+  while (lo < hi)
   {
-    bool flag = true;
-    for (uint8_t j = 1; j < _cnt-i; j++)
-    {
-      if (_ar[_p[j-1]] > _ar[_p[j]])
-      {
-        uint8_t t = _p[j-1];
-        _p[j-1] = _p[j];
-        _p[j] = t;
-        flag = false;
-      }
-    }
-    if (flag) break;
+    uint8_t mid = (lo + hi) / 2;
+    if (_ar[_p[mid]] <= value) lo = mid + 1;
+    else hi = mid;
   }
-  _sorted = true;
+  return lo;
 }
 
 // END OF FILE
\ No newline at end of file
@@ -2,7 +2,7 @@
 //    FILE: RunningMedian.h
 //  AUTHOR: Rob dot Tillaart at gmail dot com
 // PURPOSE: RunningMedian library for Arduino
-// VERSION: 0.1.15
+// VERSION: 0.2.1
 //     URL: http://arduino.cc/playground/Main/RunningMedian
 // HISTORY: See RunningMedian.cpp
 //
@@ -20,7 +20,7 @@
 
 #include <inttypes.h>
 
-#define RUNNING_MEDIAN_VERSION "0.1.15"
+#define RUNNING_MEDIAN_VERSION "0.2.1"
 
 // prepare for dynamic version
 // not tested use at own risk :)
@@ -51,8 +51,9 @@ public:
   ~RunningMedian();                            // destructor
 
   void clear();                        // resets internal buffer and var
-  void add(const float value);        // adds a new value to internal buffer, optionally replacing the oldest element.
-  float getMedian();                  // returns the median == middle element
+  void add(const float value);        // adds a new value to internal buffer, optionally replacing the oldest element; NaN is ignored.
+                                      // keeps the buffer sorted, O(log n) compares + O(n) byte moves
+  float getMedian();                  // returns the median == middle element, O(1)
 
 #ifdef RUNNING_MEDIAN_ALL
   float getAverage();                 // returns average of the values in the internal buffer
@@ -69,7 +70,6 @@ public:
 #endif
 
 protected:
-  boolean _sorted;
   uint8_t _size;
   uint8_t _cnt;
   uint8_t _idx;
@@ -79,9 +79,10 @@ protected:
   uint8_t * _p;
 #else
   float _ar[MEDIAN_MAX_SIZE];
-  uint8_t _p[MEDIAN_MAX_SIZE];
+  uint8_t _p[MEDIAN_MAX_SIZE];        // indices into _ar, always in value order
 #endif
-  void sort();
+  uint8_t lowerBound(const float value, const uint8_t count);  // first of _p[0..count) not below value
+  uint8_t upperBound(const float value, const uint8_t count);  // first of _p[0..count) above value
 };
 
 #endif
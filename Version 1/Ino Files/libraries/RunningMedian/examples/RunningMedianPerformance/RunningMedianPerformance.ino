@@ -0,0 +1,184 @@
+//
+//    FILE: RunningMedianPerformance.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.1
+// PURPOSE: time add() + getMedian() against the 0.1.15 bubble sort, per window size
+//    DATE: 2026-10-17
+//
+// Released to the public domain
+//
+// Every sample is one add() followed by one getMedian(), the way a
+// filter uses it. BubbleMedian below is what RunningMedian did up to
+// 0.1.15: add() only stores, getMedian() bubble sorts the indirection
+// array. Both see the same data and their medians must agree.
+//
+// Then a window of 7 fed 20% NaN: RunningMedian leaves them out, so its
+// median must match the bubble sort fed only the other samples.
+//
+// Sizes above MEDIAN_MAX_SIZE are skipped; on the host build them all
+// with: CXXFLAGS="-O2 -DMEDIAN_MAX_SIZE=255" make BUILD=build-big build-big/RunningMedianPerformance
+//
+
+#include <RunningMedian.h>
+
+const uint8_t sizes[] = { 5, 9, 19, 49, 99, 199 };
+const uint16_t SAMPLES = 1000;
+
+class BubbleMedian
+{
+public:
+  explicit BubbleMedian(const uint8_t size) : _size(size), _cnt(0), _idx(0)
+  {
+    for (uint8_t i = 0; i < _size; i++) _p[i] = i;
+  }
+
+  void add(const float value)
+  {
+    _ar[_idx++] = value;
+    if (_idx >= _size) _idx = 0;
+    if (_cnt < _size) _cnt++;
+    _sorted = false;
+  }
+
+  float getMedian()
+  {
+    if (!_sorted) sort();
+    if (_cnt & 0x01) return _ar[_p[_cnt/2]];
+    return (_ar[_p[_cnt/2]] + _ar[_p[_cnt/2 - 1]]) / 2;
+  }
+
+private:
+  void sort()
+  {
+    for (uint8_t i = 0; i < _cnt - 1; i++)
+    {
+      bool flag = true;
+      for (uint8_t j = 1; j < _cnt - i; j++)
+      {
+        if (_ar[_p[j-1]] > _ar[_p[j]])
+        {
+          uint8_t t = _p[j-1];
+          _p[j-1] = _p[j];
+          _p[j] = t;
+          flag = false;
+        }
+      }
+      if (flag) break;
+    }
+    _sorted = true;
+  }
+
+  uint8_t _size;
+  uint8_t _cnt;
+  uint8_t _idx;
+  bool    _sorted;
+  float   _ar[MEDIAN_MAX_SIZE];
+  uint8_t _p[MEDIAN_MAX_SIZE];
+};
+
+uint32_t seed;
+
+// noisy sensor: a slow ramp, noise and the odd spike
+float sample(uint16_t n)
+{
+  seed = seed * 1103515245UL + 12345;
+  float noise = ((seed >> 16) & 0x3FF) / 100.0;
+  if ((seed & 0xF00) == 0) noise *= 20;
+  return n * 0.05 + noise;
+}
+
+void printTime(uint32_t us)
+{
+  float perSample = (float)us / SAMPLES;
+  Serial.print(perSample, 2);
+  Serial.print(" us (");
+  Serial.print(perSample * (F_CPU / 1000000L), 0);
+  Serial.print(" cycles)\t");
+}
+
+void nanTest()
+{
+  RunningMedian rm(7);
+  BubbleMedian bm(7);
+  uint16_t mismatches = 0;
+  uint16_t nans = 0;
+
+  seed = 7;
+  for (uint16_t n = 0; n < SAMPLES; n++)
+  {
+    float value = sample(n);
+    if ((seed >> 24) % 5 == 0)
+    {
+      value = NAN;
+      nans++;
+    }
+    else bm.add(value);
+    rm.add(value);
+    if (bm.getMedian() != rm.getMedian()) mismatches++;
+  }
+  Serial.print("\nwindow 7, ");
+  Serial.print(nans);
+  Serial.print(" NaN in ");
+  Serial.print(SAMPLES);
+  Serial.print(" samples: mismatches ");
+  Serial.println(mismatches);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("RUNNING_MEDIAN_VERSION: ");
+  Serial.println(RUNNING_MEDIAN_VERSION);
+  Serial.print("MEDIAN_MAX_SIZE: ");
+  Serial.println(MEDIAN_MAX_SIZE);
+  Serial.println();
+  Serial.println("size\tRunningMedian\t\t\tbubble sort (0.1.15)\t\tratio\tmismatches");
+
+  for (uint8_t s = 0; s < sizeof(sizes); s++)
+  {
+    uint8_t size = sizes[s];
+    if (size > MEDIAN_MAX_SIZE) break;
+
+    RunningMedian rm(size);
+    BubbleMedian bm(size);
+    float a[SAMPLES / 10];
+    uint16_t mismatches = 0;
+
+    seed = size;
+    uint32_t start = micros();
+    for (uint16_t n = 0; n < SAMPLES; n++)
+    {
+      rm.add(sample(n));
+      float m = rm.getMedian();
+      if (n % 10 == 0) a[n / 10] = m;
+    }
+    uint32_t incremental = micros() - start;
+
+    seed = size;
+    start = micros();
+    for (uint16_t n = 0; n < SAMPLES; n++)
+    {
+      bm.add(sample(n));
+      float m = bm.getMedian();
+      if (n % 10 == 0 && m != a[n / 10]) mismatches++;
+    }
+    uint32_t bubble = micros() - start;
+
+    Serial.print(size);
+    Serial.print('\t');
+    printTime(incremental);
+    printTime(bubble);
+    Serial.print((float)bubble / incremental, 1);
+    Serial.print('\t');
+    Serial.println(mismatches);
+  }
+  nanTest();
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
@@ -0,0 +1,104 @@
+//
+//    FILE: ServoMixer.cpp
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: elevon / V-tail mixer, RC microseconds in, servo microseconds out
+//
+// HISTORY:
+// 0.1.0 - 2026-10-18 initial version
+//
+// Released to the public domain
+//
+
+#include "ServoMixer.h"
+
+ServoMixer::ServoMixer()
+{
+  for (uint8_t n = 0; n < 2; n++)
+  {
+    setInput(n, 1000, 1500, 2000);
+    setExpo(n, 0);
+    _trim[n] = 0;
+    setOutput(n, 1000, 1500, 2000);
+  }
+  setMix(0, 1, 1);
+  setMix(1, 1, -1);
+}
+
+void ServoMixer::setInput(const uint8_t input, const uint16_t low, const uint16_t center, const uint16_t high)
+{
+  uint8_t n = input & 1;
+  _inCenter[n] = center;
+  _inLow[n].init(low, center, -1, 0);
+  _inHigh[n].init(center, high, 0, 1);
+}
+
+void ServoMixer::setExpo(const uint8_t input, const float expo)
+{
+  uint8_t n = input & 1;
+  _cubic[n] = constrain(expo, 0, 1);
+  _linear[n] = 1 - _cubic[n];
+}
+
+void ServoMixer::setMix(const uint8_t output, const float weight0, const float weight1)
+{
+  uint8_t n = output & 1;
+  _weight[n][0] = weight0;
+  _weight[n][1] = weight1;
+}
+
+void ServoMixer::setOutput(const uint8_t output, const uint16_t low, const uint16_t center, const uint16_t high)
+{
+  uint8_t n = output & 1;
+  _low[n] = low;
+  _center[n] = center;
+  _high[n] = high;
+  updateOutput(n);
+}
+
+void ServoMixer::setTrim(const uint8_t output, const int16_t us)
+{
+  uint8_t n = output & 1;
+  _trim[n] = us;
+  updateOutput(n);
+}
+
+void ServoMixer::mix(const uint16_t in0, const uint16_t in1)
+{
+  float a = input(0, in0);
+  float b = input(1, in1);
+  for (uint8_t n = 0; n < 2; n++)
+  {
+    float m = _weight[n][0] * a + _weight[n][1] * b;
+    // + 0.5: round to the nearest us
+    if (m <= -1) _out[n] = _low[n];
+    else if (m >= 1) _out[n] = _high[n];
+    else if (m < 0) _out[n] = _outLow[n].map(m) + 0.5;
+    else _out[n] = _outHigh[n].map(m) + 0.5;
+  }
+}
+
+/////////////////////////////////////////////////////
+//
+// PRIVATE
+//
+
+// the trimmed center stays between the endpoints
+void ServoMixer::updateOutput(const uint8_t output)
+{
+  uint8_t n = output;
+  int32_t center = (int32_t)_center[n] + _trim[n];
+  center = constrain(center, (int32_t)_low[n], (int32_t)_high[n]);
+  _outLow[n].init(-1, 0, _low[n], center);
+  _outHigh[n].init(0, 1, center, _high[n]);
+}
+
+// -1..1 with the expo
+float ServoMixer::input(const uint8_t input, const uint16_t us)
+{
+  float x = us < _inCenter[input] ? _inLow[input].lowerConstrainedMap(us) : _inHigh[input].upperConstrainedMap(us);
+  if (_cubic[input] == 0) return x;
+  return x * (_linear[input] + _cubic[input] * x * x);
+}
+
+// END OF FILE
@@ -0,0 +1,85 @@
+//
+//    FILE: ServoMixer.h
+//  AUTHOR: Keyrim
+// PURPOSE: elevon / V-tail mixer, RC microseconds in, servo microseconds out
+// VERSION: 0.1.0
+// HISTORY: See ServoMixer.cpp
+//
+// Released to the public domain
+//
+// Two inputs, two outputs:
+//   elevons   pitch and roll in, left and right elevon out
+//   V-tail    pitch and yaw in, left and right ruddervator out
+// The defaults mix out0 = in0 + in1 and out1 = in0 - in1.
+//
+// Each step is a precomputed slope and offset (FastMap), one side of the
+// center each so that the calibration and the endpoints can be
+// asymmetric:
+//   input     us -> -1..1 around the stick center, clamped
+//   expo      x * (1 - expo) + x^3 * expo, softer around the center
+//   mix       a weight per input and output, clamped to -1..1
+//   output    -1..1 -> low endpoint .. center + trim .. high endpoint
+// No division at run time, the setters do them.
+//
+//   mixer.mix(pitch, roll);
+//   mixer.write(left, right);     // writeMicroseconds() on each
+//
+
+#ifndef ServoMixer_h
+#define ServoMixer_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "FastMap.h"
+
+#define SERVO_MIXER_LIB_VERSION "0.1.0"
+
+
+class ServoMixer
+{
+public:
+  ServoMixer();
+
+  // stick calibration in us, default 1000, 1500, 2000
+  void setInput(const uint8_t input, const uint16_t low, const uint16_t center, const uint16_t high);
+  // 0 linear .. 1 cubic
+  void setExpo(const uint8_t input, const float expo);
+  // share of each input in an output, negative to reverse
+  void setMix(const uint8_t output, const float weight0, const float weight1);
+  // servo endpoints in us, default 1000, 1500, 2000
+  void setOutput(const uint8_t output, const uint16_t low, const uint16_t center, const uint16_t high);
+  // us added to the center, the endpoints stay where they are
+  void setTrim(const uint8_t output, const int16_t us);
+
+  // the outputs for two input pulses
+  void mix(const uint16_t in0, const uint16_t in1);
+  uint16_t output(const uint8_t output) const { return _out[output & 1]; };
+
+  // to a Servo, SoftwareServo or anything with writeMicroseconds()
+  template <class S>
+  void write(S & servo0, S & servo1)
+  {
+    servo0.writeMicroseconds(_out[0]);
+    servo1.writeMicroseconds(_out[1]);
+  };
+
+private:
+  void  updateOutput(const uint8_t output);
+  float input(const uint8_t input, const uint16_t us);
+
+  FastMap  _inLow[2], _inHigh[2];      // below and above the center
+  uint16_t _inCenter[2];
+  float    _linear[2], _cubic[2];      // expo
+  float    _weight[2][2];              // [output][input]
+  FastMap  _outLow[2], _outHigh[2];
+  uint16_t _low[2], _center[2], _high[2];
+  int16_t  _trim[2];
+  uint16_t _out[2];
+};
+
+#endif
+// END OF FILE
@@ -0,0 +1,145 @@
+//
+//    FILE: servoMixerTest.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: ServoMixer outputs and cost against map() + Servo.write()
+//    DATE: 2026-10-18
+//     URL:
+//
+// Released to the public domain
+//
+// The Arduino_2 elevons both ways: two map() to degrees, then the degrees
+// back to us as Servo.write() does, against one mix() set up to give the
+// same outputs. Prints both for a few stick positions, then the us per
+// call over the whole stick range, then what expo, trim and asymmetric
+// endpoints do to the default elevon mix.
+//
+// On the host: build/servoMixerTest --bare --loops 1
+// ServoMixer is within 10 us of the reference everywhere: Servo.write()
+// takes whole degrees of 10.3 us, and map() truncates on the way. The
+// us per call only mean something on the board.
+//
+
+#include <ServoMixer.h>
+
+const float amplitude = 35;     // degrees of pitch
+const float amplitude2 = 45;    // degrees of roll
+
+ServoMixer mixer;
+
+volatile uint16_t sink;
+
+// Arduino_2 before ServoMixer
+void reference(uint16_t in0, uint16_t in1, uint16_t * out)
+{
+  float erreur_y = map(in0 - 1000, 0, 1000, amplitude, -amplitude);
+  float erreur_x = map(in1 - 1000, 0, 1000, -amplitude2, amplitude2);
+  int angle[2] = { (int)(erreur_y + erreur_x + 80), (int)(erreur_y - erreur_x + 80) };
+  for (uint8_t n = 0; n < 2; n++)
+  {
+    // Servo.write(angle)
+    angle[n] = constrain(angle[n], 0, 180);
+    out[n] = map(angle[n], 0, 180, 544, 2400);
+  }
+}
+
+// the same elevons: 80 degrees of travel either side of 80 degrees
+void setupElevons()
+{
+  mixer = ServoMixer();
+  for (uint8_t n = 0; n < 2; n++) mixer.setOutput(n, 544, 1369, 2194);
+  mixer.setMix(0, -amplitude / 80, amplitude2 / 80);
+  mixer.setMix(1, -amplitude / 80, -amplitude2 / 80);
+}
+
+void table()
+{
+  const uint16_t in[][2] = { { 1500, 1500 }, { 1000, 1500 }, { 2000, 1500 }, { 1500, 1000 },
+                             { 1500, 2000 }, { 1000, 2000 }, { 1250, 1750 }, { 1111, 1900 } };
+  Serial.println("\nin0\tin1\tmap\t\tServoMixer");
+  for (uint8_t i = 0; i < sizeof(in) / sizeof(in[0]); i++)
+  {
+    uint16_t out[2];
+    reference(in[i][0], in[i][1], out);
+    mixer.mix(in[i][0], in[i][1]);
+    Serial.print(in[i][0]);
+    Serial.print("\t");
+    Serial.print(in[i][1]);
+    Serial.print("\t");
+    Serial.print(out[0]);
+    Serial.print("\t");
+    Serial.print(out[1]);
+    Serial.print("\t");
+    Serial.print(mixer.output(0));
+    Serial.print("\t");
+    Serial.println(mixer.output(1));
+  }
+}
+
+void timing()
+{
+  uint16_t out[2];
+  uint32_t start = micros();
+  for (uint16_t us = 1000; us < 2000; us++)
+  {
+    reference(us, 3000 - us, out);
+    sink = out[0] + out[1];
+  }
+  uint32_t mapTime = micros() - start;
+
+  start = micros();
+  for (uint16_t us = 1000; us < 2000; us++)
+  {
+    mixer.mix(us, 3000 - us);
+    sink = mixer.output(0) + mixer.output(1);
+  }
+  uint32_t mixTime = micros() - start;
+
+  Serial.print("\nus per call: map ");
+  Serial.print(mapTime / 1000.0, 2);
+  Serial.print(", ServoMixer ");
+  Serial.println(mixTime / 1000.0, 2);
+}
+
+void features()
+{
+  mixer = ServoMixer();
+  Serial.println("\nelevons, pitch only\nin0\tlinear\t\texpo 0.5\ttrim +50\tendpoints 1100..1700");
+  for (uint16_t us = 1000; us <= 2000; us += 125)
+  {
+    Serial.print(us);
+    for (uint8_t step = 0; step < 4; step++)
+    {
+      mixer = ServoMixer();
+      if (step == 1) mixer.setExpo(0, 0.5);
+      if (step == 2) mixer.setTrim(0, 50);
+      if (step == 3) mixer.setOutput(0, 1100, 1500, 1700);
+      mixer.mix(us, 1500);
+      Serial.print("\t");
+      Serial.print(mixer.output(0));
+      Serial.print("\t");
+      Serial.print(mixer.output(1));
+    }
+    Serial.println();
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("SERVO_MIXER_LIB_VERSION: ");
+  Serial.println(SERVO_MIXER_LIB_VERSION);
+
+  setupElevons();
+  table();
+  timing();
+  features();
+  Serial.println("done...");
+}
+
+void loop()
+{
+}
+
+// END OF FILE
@@ -1,128 +1,284 @@
-#include <SoftwareServo.h>
+//
+//    FILE: SoftwareServo.cpp
+//  AUTHOR: Keyrim, from the Arduino playground SoftwareServo
+// VERSION: 0.2.0
+// PURPOSE: servo and ESC pulses on any pins, driven by Timer1 compare A
+//
+// HISTORY:
+// 0.1   - playground version, pulses timed on TCNT0 in a busy loop in refresh()
+// 0.2.0 - 2026-10-18 Timer1 compare interrupt per edge, double buffered
+//         sorted edge list, writeMicroseconds(), setRate(), setFrameRate()
+//
+// Released to the public domain
+//
 
-SoftwareServo *SoftwareServo::first;
+#include "SoftwareServo.h"
 
-#define NO_ANGLE (0xff)
+#define NO_ANGLE  (0xff)
+#define FRAME_END (0xff)
 
-SoftwareServo::SoftwareServo() : pin(0),angle(NO_ANGLE),pulse0(0),min16(34),max16(150),next(0)
-{}
+SoftwareServo *SoftwareServo::_first = 0;
+uint16_t SoftwareServo::_frameRate = 50;
 
-void SoftwareServo::setMinimumPulse(uint16_t t)
+SoftwareServo::Edge SoftwareServo::_lists[2][SOFTWARE_SERVO_MAX];
+uint8_t  SoftwareServo::_count[2] = { 0, 0 };
+uint16_t SoftwareServo::_period[2];
+volatile uint8_t SoftwareServo::_active = 0;
+volatile bool    SoftwareServo::_pending = false;
+bool     SoftwareServo::_running = false;
+
+uint8_t  SoftwareServo::_edge = FRAME_END;
+uint8_t  SoftwareServo::_raised = 0;
+uint16_t SoftwareServo::_frameStart;
+uint16_t SoftwareServo::_next;
+
+ISR(TIMER1_COMPA_vect)
 {
-    min16 = t/16;
+  SoftwareServo::handleInterrupt();
 }
 
-void SoftwareServo::setMaximumPulse(uint16_t t)
+SoftwareServo::SoftwareServo()
+  : _pin(0), _us(0), _minimum(540), _maximum(2400), _rate(0),
+    _every(1), _countdown(1), _nextServo(0)
 {
-    max16 = t/16;
 }
 
-uint8_t SoftwareServo::attach(int pinArg)
+uint8_t SoftwareServo::attach(int pin)
 {
-    pin = pinArg;
-    angle = NO_ANGLE;
-    pulse0 = 0;
-    next = first;
-    first = this;
-    digitalWrite(pin,0);
-    pinMode(pin,OUTPUT);
-    return 1;
+  if (!attached())
+  {
+    uint8_t count = 0;
+    for (SoftwareServo *p = _first; p != 0; p = p->_nextServo) count++;
+    if (count >= SOFTWARE_SERVO_MAX) return 0;
+  }
+  else detach();
+
+  _pin = pin;
+  _us = 0;
+#if defined(__AVR__)
+  _out = portOutputRegister(digitalPinToPort(_pin));
+  _bit = digitalPinToBitMask(_pin);
+#endif
+  digitalWrite(_pin, LOW);
+  pinMode(_pin, OUTPUT);
+  updateEvery();
+  _countdown = 1;
+  _nextServo = _first;
+  _first = this;
+  start();
+  return 1;
 }
 
 void SoftwareServo::detach()
 {
-    for ( SoftwareServo **p = &first; *p != 0; p = &((*p)->next) ) {
-	if ( *p == this) {
-	    *p = this->next;
-	    this->next = 0;
-	    return;
-	}
+  for (SoftwareServo **p = &_first; *p != 0; p = &((*p)->_nextServo))
+  {
+    if (*p == this)
+    {
+      *p = _nextServo;
+      _nextServo = 0;
+      // a pulse in progress still ends on time, the next frame has the
+      // list without this servo
+      rebuild();
+      return;
     }
+  }
+}
+
+uint8_t SoftwareServo::attached()
+{
+  for (SoftwareServo *p = _first; p != 0; p = p->_nextServo)
+  {
+    if (p == this) return 1;
+  }
+  return 0;
 }
 
-void SoftwareServo::write(int angleArg)
+void SoftwareServo::write(int angle)
 {
-    if ( angleArg < 0) angleArg = 0;
-    if ( angleArg > 180) angleArg = 180;
-    angle = angleArg;
-    // bleh, have to use longs to prevent overflow, could be tricky if always a 16MHz clock, but not true
-    // That 64L on the end is the TCNT0 prescaler, it will need to change if the clock's prescaler changes,
-    // but then there will likely be an overflow problem, so it will have to be handled by a human.
-    pulse0 = (min16*16L*clockCyclesPerMicrosecond() + (max16-min16)*(16L*clockCyclesPerMicrosecond())*angle/180L)/64L;
+  if (angle < 0) angle = 0;
+  if (angle > 180) angle = 180;
+  writeMicroseconds(_minimum + (uint32_t)(_maximum - _minimum) * angle / 180);
 }
 
 uint8_t SoftwareServo::read()
 {
-    return angle;
+  if (_us == 0) return NO_ANGLE;
+  if (_us <= _minimum) return 0;
+  if (_us >= _maximum) return 180;
+  return ((uint32_t)(_us - _minimum) * 180 + (_maximum - _minimum) / 2) / (_maximum - _minimum);
 }
 
-uint8_t SoftwareServo::attached()
+void SoftwareServo::writeMicroseconds(uint16_t us)
+{
+  if (us == _us) return;
+  _us = us;
+  if (attached()) rebuild();
+}
+
+uint16_t SoftwareServo::readMicroseconds()
+{
+  return _us;
+}
+
+void SoftwareServo::setMinimumPulse(uint16_t us)
+{
+  _minimum = us;
+}
+
+void SoftwareServo::setMaximumPulse(uint16_t us)
+{
+  _maximum = us;
+}
+
+void SoftwareServo::setRate(uint16_t hz)
+{
+  _rate = hz;
+  updateEvery();
+}
+
+void SoftwareServo::setFrameRate(uint16_t hz)
 {
-    for ( SoftwareServo *p = first; p != 0; p = p->next ) {
-	if ( p == this) return 1;
+  // the frame has to fit in the 16 bit timer
+  if (hz < 31) hz = 31;
+  if (hz > 1000) hz = 1000;
+  _frameRate = hz;
+  for (SoftwareServo *p = _first; p != 0; p = p->_nextServo) p->updateEvery();
+  rebuild();
+}
+
+void SoftwareServo::handleInterrupt()
+{
+  for (;;)
+  {
+    if (_edge == FRAME_END)
+    {
+      // a new frame: take the new list if there is one, raise the due pins
+      if (_pending)
+      {
+        _active ^= 1;
+        _pending = false;
+      }
+      _frameStart = _next;
+      _raised = 0;
+      Edge *list = _lists[_active];
+      for (uint8_t i = 0; i < _count[_active]; i++)
+      {
+        SoftwareServo *servo = list[i].servo;
+        if (--servo->_countdown) continue;
+        servo->_countdown = servo->_every;
+        servo->high();
+        _raised |= 1 << i;
+      }
+      _edge = 0;
+    }
+    else
+    {
+      _lists[_active][_edge].servo->low();
+      _edge++;
+    }
+
+    // the next edge of a raised pin, or the next frame
+    uint8_t count = _count[_active];
+    while (_edge < count && !(_raised & (1 << _edge))) _edge++;
+    if (_edge < count)
+    {
+      _next = _frameStart + _lists[_active][_edge].ticks;
     }
-    return 0;
-}
-
-void SoftwareServo::refresh()
-{
-    uint8_t count = 0, i = 0;
-    uint16_t base = 0;
-    SoftwareServo *p;
-    static unsigned long lastRefresh = 0;
-    unsigned long m = millis();
-
-    // if we haven't wrapped millis, and 20ms have not passed, then don't do anything
-    if ( m >= lastRefresh && m < lastRefresh + 20) return;
-    lastRefresh = m;
-
-    for ( p = first; p != 0; p = p->next ) if ( p->pulse0) count++;
-    if ( count == 0) return;
-
-    // gather all the SoftwareServos in an array
-    SoftwareServo *s[count];
-    for ( p = first; p != 0; p = p->next ) if ( p->pulse0) s[i++] = p;
-
-    // bubblesort the SoftwareServos by pulse time, ascending order
-    for(;;) {
-	uint8_t moved = 0;
-	for ( i = 1; i < count; i++) {
-	    if ( s[i]->pulse0 < s[i-1]->pulse0) {
-		SoftwareServo *t = s[i];
-		s[i] = s[i-1];
-		s[i-1] = t;
-		moved = 1;
-	    }
-	}
-	if ( !moved) break;
+    else
+    {
+      _edge = FRAME_END;
+      _next = _frameStart + _period[_active];
     }
 
-    // turn on all the pins
-    // Note the timing error here... when you have many SoftwareServos going, the
-    // ones at the front will get a pulse that is a few microseconds too long.
-    // Figure about 4uS/SoftwareServo after them. This could be compensated, but I feel
-    // it is within the margin of error of software SoftwareServos that could catch
-    // an extra interrupt handler at any time.
-    for ( i = 0; i < count; i++) digitalWrite( s[i]->pin, 1);
-
-    uint8_t start = TCNT0;
-    uint8_t now = start;
-    uint8_t last = now;
-
-    // Now wait for each pin's time in turn..
-    for ( i = 0; i < count; i++) {
-	uint16_t go = start + s[i]->pulse0;
-
-	// loop until we reach or pass 'go' time
-	for (;;) {
-	    now = TCNT0;
-	    if ( now < last) base += 256;
-	    last = now;
-
-	    if ( base+now > go) {
-		digitalWrite( s[i]->pin,0);
-		break;
-	    }
-	}
+    // counted from the start of the frame: a 50 Hz frame is longer than
+    // half the timer, so _next - TCNT1 could not tell late from early
+    uint16_t due = _next - _frameStart;
+    uint16_t now = TCNT1 - _frameStart;
+    if (due > now && due - now > SOFTWARE_SERVO_MIN_TICKS)
+    {
+      OCR1A = _next;
+      return;
     }
+    // too close for another interrupt
+#if defined(__AVR__)
+    while ((uint16_t)(TCNT1 - _frameStart) < due);
+#else
+    // the host's clock only moves when waited on
+    if (due > now) delayMicroseconds((due - now + SOFTWARE_SERVO_TICKS_PER_US - 1) / SOFTWARE_SERVO_TICKS_PER_US);
+#endif
+  }
+}
+
+/////////////////////////////////////////////////////
+//
+// PRIVATE
+//
+void SoftwareServo::updateEvery()
+{
+  uint16_t every = _rate ? (_frameRate + _rate / 2) / _rate : 1;
+  if (every < 1) every = 1;
+  if (every > 255) every = 255;
+  _every = every;
+}
+
+void SoftwareServo::high()
+{
+#if defined(__AVR__)
+  *_out |= _bit;
+#else
+  digitalWrite(_pin, HIGH);
+#endif
+}
+
+void SoftwareServo::low()
+{
+#if defined(__AVR__)
+  *_out &= ~_bit;
+#else
+  digitalWrite(_pin, LOW);
+#endif
 }
+
+// the servos with a width into the spare list, sorted by width
+void SoftwareServo::rebuild()
+{
+  _pending = false;          // the interrupt must not take it half built
+  uint8_t spare = _active ^ 1;
+  Edge *list = _lists[spare];
+  uint16_t period = SOFTWARE_SERVO_TICKS_PER_US * 1000000UL / _frameRate;
+  uint16_t longest = period - SOFTWARE_SERVO_GAP_TICKS;
+  uint8_t count = 0;
+  for (SoftwareServo *p = _first; p != 0; p = p->_nextServo)
+  {
+    if (p->_us == 0) continue;
+    uint32_t ticks = (uint32_t)p->_us * SOFTWARE_SERVO_TICKS_PER_US;
+    if (ticks > longest) ticks = longest;
+    uint8_t i = count++;
+    for (; i > 0 && list[i - 1].ticks > ticks; i--) list[i] = list[i - 1];
+    list[i].ticks = ticks;
+    list[i].servo = p;
+  }
+  _count[spare] = count;
+  _period[spare] = period;
+  _pending = true;
+}
+
+// Timer1 free running at prescaler 8, first frame right away
+void SoftwareServo::start()
+{
+  if (_running) return;
+  _running = true;
+  rebuild();
+  noInterrupts();
+  TCCR1A = 0;
+  TCCR1B = _BV(CS11);
+  _edge = FRAME_END;
+  _next = TCNT1 + 4 * SOFTWARE_SERVO_MIN_TICKS;
+  OCR1A = _next;
+  TIFR1 = _BV(OCF1A);
+  TIMSK1 |= _BV(OCIE1A);
+  interrupts();
+}
+
+// END OF FILE
@@ -1,31 +1,138 @@
+//
+//    FILE: SoftwareServo.h
+//  AUTHOR: Keyrim, from the Arduino playground SoftwareServo
+// PURPOSE: servo and ESC pulses on any pins, driven by Timer1 compare A
+// VERSION: 0.2.0
+// HISTORY: See SoftwareServo.cpp
+//
+// Released to the public domain
+//
+// Timer1 runs free at prescaler 8 (0.5 us at 16 MHz) and is never reset,
+// so RCReceiver can time its pulses on it too. A frame raises all the
+// servos due in it, then the compare A interrupt lowers them one by one
+// from a list sorted by width: one interrupt per edge and the CPU is
+// free in between. Edges closer than SOFTWARE_SERVO_MIN_TICKS are
+// handled in the same interrupt.
+//
+// write() and friends rebuild the sorted list in a spare buffer, the
+// interrupt takes it at the start of the next frame, so a frame never
+// mixes old and new widths.
+//
+// The frame rate is common to all servos, 50 Hz by default; a servo can
+// pulse on every Nth frame only with setRate(), e.g. an ESC at 400 Hz and
+// the control surfaces at 50 Hz:
+//
+//   SoftwareServo::setFrameRate(400);
+//   esc.attach(3);                // every frame
+//   aileron.attach(5);
+//   aileron.setRate(50);          // every 8th frame
+//
+// Defines ISR(TIMER1_COMPA_vect): not with Servo or PulsePattern in the
+// same sketch.
+//
+
 #ifndef SoftwareServo_h
 #define SoftwareServo_h
 
-#include <WProgram.h>
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
 #include <inttypes.h>
 
+#define SOFTWARE_SERVO_LIB_VERSION "0.2.0"
+
+#define SOFTWARE_SERVO_MAX            8
+
+// Timer1 at prescaler 8
+#define SOFTWARE_SERVO_TICKS_PER_US   (F_CPU / 8000000L)
+// an edge closer than this is waited for in the interrupt, ~8 us
+#define SOFTWARE_SERVO_MIN_TICKS      (8 * SOFTWARE_SERVO_TICKS_PER_US)
+// low time left at the end of a frame for the last edges
+#define SOFTWARE_SERVO_GAP_TICKS      (100 * SOFTWARE_SERVO_TICKS_PER_US)
+
+
 class SoftwareServo
 {
-  private:
-    uint8_t pin;
-    uint8_t angle;       // in degrees
-    uint16_t pulse0;     // pulse width in TCNT0 counts
-    uint8_t min16;       // minimum pulse, 16uS units  (default is 34)
-    uint8_t max16;       // maximum pulse, 16uS units, 0-4ms range (default is 150)
-    class SoftwareServo *next;
-    static SoftwareServo* first;
-  public:
-    SoftwareServo();
-    uint8_t attach(int);     // attach to a pin, sets pinMode, returns 0 on failure, won't
-                             // position the servo until a subsequent write() happens
-    void detach();
-    void write(int);         // specify the angle in degrees, 0 to 180
-    uint8_t read();
-    uint8_t attached();
-    void setMinimumPulse(uint16_t);  // pulse length for 0 degrees in microseconds, 540uS default
-    void setMaximumPulse(uint16_t);  // pulse length for 180 degrees in microseconds, 2400uS default
-    static void refresh();    // must be called at least every 50ms or so to keep servo alive
-                              // you can call more often, it won't happen more than once every 20ms
+public:
+  SoftwareServo();
+
+  // sets the pin as output, low; no pulses until the first write();
+  // 0 when all SOFTWARE_SERVO_MAX servos are in use
+  uint8_t  attach(int pin);
+  void     detach();
+  uint8_t  attached();
+
+  // 0..180 degrees between the minimum and the maximum pulse
+  void     write(int angle);
+  uint8_t  read();
+  // us, limited to the frame minus SOFTWARE_SERVO_GAP_TICKS
+  void     writeMicroseconds(uint16_t us);
+  uint16_t readMicroseconds();
+
+  // pulse for 0 and 180 degrees in us, default 540 and 2400
+  void     setMinimumPulse(uint16_t us);
+  void     setMaximumPulse(uint16_t us);
+
+  // pulses per second of this servo, rounded to a divisor of the frame
+  // rate; 0 for every frame (default)
+  void     setRate(uint16_t hz);
+
+  // frames per second of all servos, 31..1000 Hz at 16 MHz, default 50
+  static void setFrameRate(uint16_t hz);
+
+  // nothing to do anymore, kept for the sketches written for 0.1
+  static void refresh() {};
+
+  // from ISR(TIMER1_COMPA_vect)
+  static void handleInterrupt();
+
+private:
+  struct Edge
+  {
+    uint16_t      ticks;       // from the start of the frame
+    SoftwareServo *servo;
+  };
+
+  void   updateEvery();
+  void   high();
+  void   low();
+  static void rebuild();
+  static void start();
+
+  uint8_t  _pin;
+  uint16_t _us;                // 0: no pulses
+  uint16_t _minimum;
+  uint16_t _maximum;
+  uint16_t _rate;
+  uint8_t  _every;             // frames per pulse
+  uint8_t  _countdown;         // frames to the next pulse, interrupt only
+#if defined(__AVR__)
+  volatile uint8_t *_out;
+  uint8_t  _bit;
+#endif
+  SoftwareServo *_nextServo;
+
+  static SoftwareServo *_first;
+  static uint16_t _frameRate;
+
+  // two lists, the interrupt uses _lists[_active]; a rebuild fills the
+  // other one and sets _pending when it is complete
+  static Edge     _lists[2][SOFTWARE_SERVO_MAX];
+  static uint8_t  _count[2];
+  static uint16_t _period[2];  // ticks
+  static volatile uint8_t _active;
+  static volatile bool    _pending;
+  static bool     _running;
+
+  // interrupt state
+  static uint8_t  _edge;       // next edge in the list, or the next frame
+  static uint8_t  _raised;     // list entries raised in this frame
+  static uint16_t _frameStart;
+  static uint16_t _next;       // TCNT1 of the next event
 };
 
 #endif
+// END OF FILE
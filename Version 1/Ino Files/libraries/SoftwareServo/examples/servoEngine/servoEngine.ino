@@ -0,0 +1,104 @@
+//
+//    FILE: servoEngine.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: an ESC at 400 Hz and three servos at 50 Hz from the Timer1 engine
+//    DATE: 2026-10-18
+//     URL:
+//
+// Released to the public domain
+//
+// ESC on pin 3 every 2.5 ms frame, servos on 5, 6 and 9 every 8th frame.
+// First the passes per second of a tight loop without and with the
+// servos running, for what the interrupts cost. Then one second with the
+// widths held (ESC 1000, servos 1100, 1500, 1900 us) and a slow sweep,
+// the widths printed every 250 ms.
+//
+// On the host: build/servoEngine --virtual --bare --seconds 3 --pin-trace servo.csv
+//              build/pin_timing --trace servo.csv --from 0.5 --to 1.4
+// shows 360 pulses of 1000 us on pin 3 with a 2500 us period and 45
+// pulses of 1100, 1500 and 1900 us on 5, 6 and 9 with a 20000 us period,
+// all to the us of the trace. The interrupt cost only means something on
+// the board: in virtual time an interrupt takes no time.
+//
+
+#include <SoftwareServo.h>
+
+SoftwareServo esc;
+SoftwareServo servo[3];
+const uint8_t servoPin[3] = { 5, 6, 9 };
+const uint16_t servoHold[3] = { 1100, 1500, 1900 };
+
+uint32_t last;
+uint32_t start;
+
+uint32_t countPasses(uint16_t ms)
+{
+  uint32_t count = 0;
+  uint32_t begin = millis();
+  while (millis() - begin < ms) count++;
+  return count * 1000 / ms;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("SOFTWARE_SERVO_LIB_VERSION: ");
+  Serial.println(SOFTWARE_SERVO_LIB_VERSION);
+
+  uint32_t idle = countPasses(200);
+
+  SoftwareServo::setFrameRate(400);
+  esc.attach(3);
+  esc.writeMicroseconds(1000);
+  for (uint8_t n = 0; n < 3; n++)
+  {
+    servo[n].attach(servoPin[n]);
+    servo[n].setRate(50);
+    servo[n].writeMicroseconds(servoHold[n]);
+  }
+
+  uint32_t running = countPasses(200);
+  Serial.print("\nloop passes/s: ");
+  Serial.print(idle);
+  Serial.print(" idle, ");
+  Serial.print(running);
+  Serial.print(" with the servos, ");
+  Serial.print(100.0 - running * 100.0 / idle, 1);
+  Serial.println("% to the interrupts");
+
+  Serial.println("\nms\tesc\ts5\ts6\ts9");
+  start = millis();
+  last = start;
+}
+
+void loop()
+{
+  uint32_t now = millis();
+  uint32_t t = now - start;
+  if (t >= 1000)
+  {
+    // 1000..2000 us on the ESC and 0..180 degrees on the servos in 4 s
+    uint16_t phase = (t - 1000) % 4000;
+    uint16_t ramp = phase < 2000 ? phase : 4000 - phase;
+    esc.writeMicroseconds(1000 + ramp / 2);
+    servo[0].write(ramp * 180L / 2000);
+    servo[1].write(180 - ramp * 180L / 2000);
+    servo[2].write(90);
+  }
+
+  if (now - last < 250) return;
+  last += 250;
+  Serial.print(t);
+  Serial.print("\t");
+  Serial.print(esc.readMicroseconds());
+  for (uint8_t n = 0; n < 3; n++)
+  {
+    Serial.print("\t");
+    Serial.print(servo[n].readMicroseconds());
+  }
+  Serial.println();
+}
+
+// END OF FILE
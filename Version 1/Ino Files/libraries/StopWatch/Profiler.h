@@ -0,0 +1,146 @@
+#ifndef Profiler_h
+#define Profiler_h
+//
+//    FILE: Profiler.h
+//  AUTHOR: Keyrim
+// PURPOSE: time sections of code with micros(), min/mean/max per slot
+// HISTORY: See StopWatch.cpp
+//
+// Released to the public domain
+//
+// A sketch numbers its sections 0 .. PROFILER_SLOTS-1 and marks them with
+//
+//   PROFILE_SCOPE(slot);                 until the end of the block
+//   PROFILE_BEGIN(slot); ... PROFILE_END(slot);
+//
+// PROFILE_NAME(slot, "name") labels a slot for PROFILE_DUMP(Serial), which
+// prints count, min, mean and max in us; PROFILE_RESET() clears them all.
+//
+// The macros only do something when PROFILER is defined before this file
+// is included. Without it they are empty, and since everything below is
+// inline, nothing of it ends up in the sketch.
+//
+// A slot is 18 bytes of RAM. Times are clipped to 65535 us for min and
+// max; the mean holds while the total of a slot stays below 71 minutes.
+// Slot numbers are not checked.
+//
+
+#include "StopWatch.h"
+
+#ifndef PROFILER_SLOTS
+#define PROFILER_SLOTS 8
+#endif
+
+struct ProfilerSlot
+{
+  const __FlashStringHelper *name;
+  uint32_t count;
+  uint32_t total;
+  uint32_t start;
+  uint16_t minimum;
+  uint16_t maximum;
+};
+
+class Profiler
+{
+public:
+  static ProfilerSlot *slots()
+  {
+    static ProfilerSlot _slots[PROFILER_SLOTS];
+    return _slots;
+  }
+
+  static void name(const uint8_t slot, const __FlashStringHelper *name)
+  {
+    slots()[slot].name = name;
+  }
+
+  static void add(const uint8_t slot, const uint32_t us)
+  {
+    ProfilerSlot &s = slots()[slot];
+    uint16_t t = us > 0xFFFF ? 0xFFFF : us;
+    if (s.count == 0 || t < s.minimum) s.minimum = t;
+    if (t > s.maximum) s.maximum = t;
+    s.count++;
+    s.total += us;
+  }
+
+  static void begin(const uint8_t slot) { slots()[slot].start = micros(); };
+  static void end(const uint8_t slot)   { add(slot, micros() - slots()[slot].start); };
+
+  static uint32_t count(const uint8_t slot)   { return slots()[slot].count; };
+  static uint16_t minimum(const uint8_t slot) { return slots()[slot].minimum; };
+  static uint16_t maximum(const uint8_t slot) { return slots()[slot].maximum; };
+  static uint32_t mean(const uint8_t slot)
+  {
+    const ProfilerSlot &s = slots()[slot];
+    return s.count ? s.total / s.count : 0;
+  }
+
+  // keeps the names
+  static void reset()
+  {
+    for (uint8_t i = 0; i < PROFILER_SLOTS; i++)
+    {
+      ProfilerSlot &s = slots()[i];
+      s.count = s.total = 0;
+      s.minimum = s.maximum = 0;
+    }
+  }
+
+  // one line per slot that ran: slot, name, count, min, mean, max
+  static void dump(Print &out)
+  {
+    out.println(F("slot\tname\tcount\tmin\tmean\tmax (us)"));
+    for (uint8_t i = 0; i < PROFILER_SLOTS; i++)
+    {
+      const ProfilerSlot &s = slots()[i];
+      if (s.count == 0) continue;
+      out.print(i);
+      out.print('\t');
+      if (s.name) out.print(s.name);
+      out.print('\t');
+      out.print(s.count);
+      out.print('\t');
+      out.print(s.minimum);
+      out.print('\t');
+      out.print(mean(i));
+      out.print('\t');
+      out.println(s.maximum);
+    }
+  }
+};
+
+// times its own lifetime into a slot
+class ProfilerScope
+{
+public:
+  explicit ProfilerScope(const uint8_t slot) : _slot(slot), _start(micros()) {};
+  ~ProfilerScope() { Profiler::add(_slot, micros() - _start); };
+
+private:
+  uint8_t  _slot;
+  uint32_t _start;
+};
+
+#define PROFILER_CONCAT2(a, b) a ## b
+#define PROFILER_CONCAT(a, b)  PROFILER_CONCAT2(a, b)
+
+#ifdef PROFILER
+#define PROFILE_SCOPE(slot)       ProfilerScope PROFILER_CONCAT(_profilerScope, __LINE__)(slot)
+#define PROFILE_BEGIN(slot)       Profiler::begin(slot)
+#define PROFILE_END(slot)         Profiler::end(slot)
+#define PROFILE_NAME(slot, label) Profiler::name(slot, F(label))
+#define PROFILE_DUMP(out)         Profiler::dump(out)
+#define PROFILE_RESET()           Profiler::reset()
+#else
+#define PROFILE_SCOPE(slot)
+#define PROFILE_BEGIN(slot)
+#define PROFILE_END(slot)
+#define PROFILE_NAME(slot, label)
+#define PROFILE_DUMP(out)
+#define PROFILE_RESET()
+#endif
+
+#endif
+// END OF FILE
@@ -1,7 +1,7 @@
 //
 //    FILE: StopWatch.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.5
+// VERSION: 0.1.6
 // PURPOSE: Simple StopWatch library for Arduino
 //
 // The library is based upon millis() and therefore
@@ -15,6 +15,7 @@
 //             By mromani & Rob Tillaart
 // 0.1.4  2017-07-16 refactored
 // 0.1.5  2017-09-13 removed const from functions
+// 0.1.6  2026-10-17 added Profiler.h, scoped section timing
 //
 // Released to the public domain
 //
@@ -10,7 +10,7 @@
 // Released to the public domain
 //
 
-#define STOPWATCH_LIB_VERSION "0.1.5"
+#define STOPWATCH_LIB_VERSION "0.1.6"
 
 #if ARDUINO >= 100
 #include "Arduino.h"
@@ -0,0 +1,63 @@
+//
+//    FILE: profiler.ino
+//  AUTHOR: Keyrim
+// VERSION: 0.1.0
+// PURPOSE: demo of Profiler.h, three sections of loop() timed and dumped
+//    DATE: 2026-10-17
+//     URL:
+//
+// Released to the public domain
+//
+// Comment out the #define to see the sketch without any profiling code.
+//
+
+#define PROFILER
+#include <Profiler.h>
+
+enum { SLOT_LOOP, SLOT_MATH, SLOT_PRINT, SLOT_WAIT };
+
+volatile float sink;
+uint32_t lastDump = 0;
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("Version: ");
+  Serial.println(STOPWATCH_LIB_VERSION);
+
+  PROFILE_NAME(SLOT_LOOP, "loop");
+  PROFILE_NAME(SLOT_MATH, "math");
+  PROFILE_NAME(SLOT_PRINT, "print");
+  PROFILE_NAME(SLOT_WAIT, "wait");
+}
+
+void loop()
+{
+  PROFILE_SCOPE(SLOT_LOOP);
+
+  {
+    PROFILE_SCOPE(SLOT_MATH);
+    float x = analogRead(A0);
+    for (uint8_t i = 0; i < 10; i++) x = sqrt(x * x + i);
+    sink = x;
+  }
+
+  PROFILE_BEGIN(SLOT_PRINT);
+  Serial.print('.');
+  PROFILE_END(SLOT_PRINT);
+
+  PROFILE_BEGIN(SLOT_WAIT);
+  delayMicroseconds(random(100, 500));
+  PROFILE_END(SLOT_WAIT);
+
+  if (millis() - lastDump >= 1000)
+  {
+    lastDump = millis();
+    Serial.println();
+    PROFILE_DUMP(Serial);
+    PROFILE_RESET();
+  }
+}
+
+// END OF FILE
@@ -105,6 +105,33 @@ uint8_t TwoWire::requestFrom(int address, int quantity, int sendStop)
   return requestFrom((uint8_t)address, (uint8_t)quantity, (uint8_t)sendStop);
 }
 
+//
+//	Reads quantity bytes straight into buffer, up to 255 whatever
+//	BUFFER_LENGTH is: the twi interrupt stores each byte there, so
+//	there is no copy and no split into BUFFER_LENGTH transactions.
+//	Returns the number of bytes read; read() has nothing after it.
+//
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t *buffer, uint8_t quantity, uint8_t sendStop)
+{
+  rxBufferIndex = 0;
+  rxBufferLength = 0;
+  return twi_readFrom(address, buffer, quantity, sendStop);
+}
+
+//
+//	Reads quantity bytes starting at register reg without waiting:
+//	the whole transaction (register write, repeated start, read)
+//	runs in the twi interrupt and ends by calling callback(data,
+//	count) from it, count 0 meaning the device did not answer.
+//	Copy the data out in the callback, it is not kept. Returns 0
+//	when started, 1 if quantity does not fit, 4 if the bus is busy.
+//	Does not touch the buffer used by read().
+//
+uint8_t TwoWire::requestFromAsync(uint8_t address, uint8_t reg, uint8_t quantity, void (*callback)(uint8_t*, uint8_t))
+{
+  return twi_readRegisterAsync(address, reg, quantity, callback);
+}
+
 void TwoWire::beginTransmission(uint8_t address)
 {
   // indicate that we are transmitting
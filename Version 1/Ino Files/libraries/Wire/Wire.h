@@ -25,7 +25,20 @@
 #include <inttypes.h>
 #include "Stream.h"
 
+// size of the read() and write() buffers, set it for the whole build
+// (e.g. -DBUFFER_LENGTH=130 for 128 byte EEPROM pages) so Wire.cpp and
+// every library see the same value
+#ifndef BUFFER_LENGTH
 #define BUFFER_LENGTH 32
+#endif
+#if BUFFER_LENGTH > 255
+#error "BUFFER_LENGTH is indexed with uint8_t, 255 at most"
+#endif
+
+// requestFrom(address, buffer, quantity) reads into the caller's buffer
+#define WIRE_HAS_BUFFER_READ
+// requestFromAsync(address, reg, quantity, callback) is available
+#define WIRE_HAS_ASYNC_READ
 
 class TwoWire : public Stream
 {
@@ -57,6 +70,8 @@ class TwoWire : public Stream
     uint8_t requestFrom(uint8_t, uint8_t, uint8_t);
     uint8_t requestFrom(int, int);
     uint8_t requestFrom(int, int, int);
+    uint8_t requestFrom(uint8_t, uint8_t*, uint8_t, uint8_t sendStop = true);
+    uint8_t requestFromAsync(uint8_t, uint8_t, uint8_t, void (*)(uint8_t*, uint8_t));
     virtual size_t write(uint8_t);
     virtual size_t write(const uint8_t *, size_t);
     virtual int available(void);
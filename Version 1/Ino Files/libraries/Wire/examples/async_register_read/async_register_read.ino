@@ -0,0 +1,101 @@
+// Wire Async Register Read
+//
+// Compares the CPU time one 14 byte MPU-6050 burst read (0x3B..0x48)
+// costs the caller: the blocking endTransmission / requestFrom path
+// against requestFromAsync, where the TWI interrupt does the transfer
+// and only the start and the copy in the callback remain.
+//
+// Times are in microseconds (micros() resolution is 4 us) and in
+// cycles at F_CPU. The async read also reports how many loop passes
+// were free while the transfer ran.
+//
+// This example code is in the public domain.
+
+
+#include <Wire.h>
+
+const uint8_t MPU = 0x68;
+const uint8_t REG = 0x3B;
+const uint8_t COUNT = 14;
+const int RUNS = 100;
+
+uint8_t sample[COUNT];
+volatile bool done = false;
+volatile uint8_t received = 0;
+volatile uint32_t callbackTime = 0;
+
+void readDone(uint8_t *data, uint8_t length)
+{
+  uint32_t start = micros();
+  for (uint8_t i = 0; i < length; i++) sample[i] = data[i];
+  received = length;
+  done = true;
+  callbackTime += micros() - start;
+}
+
+void printTime(const char *label, uint32_t us)
+{
+  Serial.print(label);
+  Serial.print(us / (float)RUNS, 1);
+  Serial.print(" us\t");
+  Serial.print(us / (float)RUNS * (F_CPU / 1000000L), 0);
+  Serial.println(" cycles");
+}
+
+void setup()
+{
+  Wire.begin();
+  Serial.begin(115200);
+
+  // wake the MPU-6050
+  Wire.beginTransmission(MPU);
+  Wire.write(0x6B);
+  Wire.write(0);
+  Wire.endTransmission();
+
+  uint32_t blocking = 0;
+  for (int r = 0; r < RUNS; r++)
+  {
+    uint32_t start = micros();
+    Wire.beginTransmission(MPU);
+    Wire.write(REG);
+    Wire.endTransmission(false);
+    Wire.requestFrom(MPU, COUNT);
+    for (uint8_t i = 0; i < COUNT; i++) sample[i] = Wire.read();
+    blocking += micros() - start;
+  }
+
+  uint32_t kick = 0;
+  uint32_t latency = 0;
+  uint32_t idle = 0;
+  callbackTime = 0;
+  for (int r = 0; r < RUNS; r++)
+  {
+    done = false;
+    uint32_t start = micros();
+    Wire.requestFromAsync(MPU, REG, COUNT, readDone);
+    uint32_t started = micros();
+    kick += started - start;
+    // the loop is free until the data is in
+    uint32_t now = started;
+    while (!done)
+    {
+      now = micros();
+      idle++;
+    }
+    latency += now - start;
+  }
+
+  Serial.println("14 byte burst read, mean of 100");
+  printTime("blocking          \t", blocking);
+  printTime("async start       \t", kick);
+  printTime("async callback    \t", callbackTime);
+  printTime("async until data  \t", latency);
+  Serial.print("free loop passes per read\t");
+  Serial.println(idle / RUNS);
+  if (received != COUNT) Serial.println("MPU-6050 did not answer");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,129 @@
+// Wire Transfer Size
+//
+// Reads blocks of 14 to 252 bytes from the MPU-6050 FIFO two ways:
+// the way I2Cdev does it with the Wire buffer, one register write and
+// one requestFrom per BUFFER_LENGTH bytes, and in one transaction with
+// requestFrom(address, buffer, quantity), which the TWI interrupt
+// fills directly. The FIFO is loaded with a known pattern first so
+// both reads can be checked.
+//
+// For each size: transactions, bytes on the bus (address and register
+// bytes included), time in us and us per byte at 400 kHz. Build with
+// another -DBUFFER_LENGTH to see the chunked side move.
+//
+// This example code is in the public domain.
+
+
+#include <Wire.h>
+
+const uint8_t MPU = 0x68;
+const uint8_t USER_CTRL = 0x6A;
+const uint8_t FIFO_R_W = 0x74;
+const uint8_t sizes[] = { 14, 32, 42, 84, 168, 252 };
+
+uint8_t block[252];
+uint16_t errors = 0;
+
+void writeRegister(uint8_t reg, uint8_t value)
+{
+  Wire.beginTransmission(MPU);
+  Wire.write(reg);
+  Wire.write(value);
+  Wire.endTransmission();
+}
+
+// FIFO_EN stays 0, so only what is written here comes back out
+void fillFIFO(uint8_t size, uint8_t seed)
+{
+  writeRegister(USER_CTRL, 0x44);   // FIFO enable + reset
+  for (uint8_t k = 0; k < size; )
+  {
+    Wire.beginTransmission(MPU);
+    Wire.write(FIFO_R_W);
+    for (uint8_t i = 0; i < BUFFER_LENGTH - 1 && k < size; i++, k++)
+    {
+      Wire.write((uint8_t)(seed + k));
+    }
+    Wire.endTransmission();
+  }
+}
+
+void check(uint8_t size, uint8_t seed)
+{
+  for (uint8_t k = 0; k < size; k++)
+  {
+    if (block[k] != (uint8_t)(seed + k)) errors++;
+  }
+}
+
+void pointAtFIFO()
+{
+  Wire.beginTransmission(MPU);
+  Wire.write(FIFO_R_W);
+  Wire.endTransmission();
+}
+
+void report(const char *label, uint8_t transactions, uint16_t bytes, uint32_t us, uint8_t size)
+{
+  Serial.print(label);
+  Serial.print(transactions);
+  Serial.print('\t');
+  Serial.print(bytes);
+  Serial.print('\t');
+  Serial.print(us);
+  Serial.print('\t');
+  Serial.print((float)us / size, 2);
+  Serial.print('\t');
+}
+
+void setup()
+{
+  Wire.begin();
+  TWBR = 12;  // 400 kHz
+  Serial.begin(115200);
+  Serial.print("BUFFER_LENGTH: ");
+  Serial.println(BUFFER_LENGTH);
+  Serial.println("size\tchunked: trans\tbytes\tus\tus/byte\tone read: trans\tbytes\tus\tus/byte\tgain");
+
+  writeRegister(0x6B, 0);           // wake up
+
+  for (uint8_t s = 0; s < sizeof(sizes); s++)
+  {
+    uint8_t size = sizes[s];
+
+    fillFIFO(size, s);
+    uint8_t transactions = 0;
+    uint32_t start = micros();
+    for (uint8_t k = 0; k < size; )
+    {
+      uint8_t n = min(size - k, BUFFER_LENGTH);
+      pointAtFIFO();
+      Wire.requestFrom(MPU, n);
+      while (Wire.available()) block[k++] = Wire.read();
+      transactions += 2;
+    }
+    uint32_t chunked = micros() - start;
+    check(size, s);
+
+    fillFIFO(size, s + 100);
+    start = micros();
+    pointAtFIFO();
+    Wire.requestFrom(MPU, block, size);
+    uint32_t single = micros() - start;
+    check(size, s + 100);
+
+    Serial.print(size);
+    Serial.print('\t');
+    // a write is address + register, a read is address + data
+    report("", transactions, transactions / 2 * 3 + size, chunked, size);
+    report("\t", 2, 3 + size, single, size);
+    Serial.println((float)chunked / single, 2);
+  }
+
+  Serial.print("errors: ");
+  Serial.println(errors);
+}
+
+void loop()
+{
+}
@@ -17,6 +17,8 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
   Modified 2012 by Todd Krein (todd@krein.org) to implement repeated starts
+  Modified for Eagle: interrupt driven register reads (twi_readRegisterAsync)
+  Modified for Eagle: blocking transfers use the caller's buffer, no copy
 */
 
 #include <math.h>
@@ -47,6 +49,7 @@ static void (*twi_onSlaveTransmit)(void);
 static void (*twi_onSlaveReceive)(uint8_t*, int);
 
 static uint8_t twi_masterBuffer[TWI_BUFFER_LENGTH];
+static uint8_t* volatile twi_masterData;	// what the ISR reads from / writes to
 static volatile uint8_t twi_masterBufferIndex;
 static volatile uint8_t twi_masterBufferLength;
 
@@ -59,6 +62,9 @@ static volatile uint8_t twi_rxBufferIndex;
 
 static volatile uint8_t twi_error;
 
+static void (*twi_onMasterReceive)(uint8_t*, uint8_t);	// set while an async read is in flight
+static volatile uint8_t twi_asyncLength;
+
 /* 
  * Function twi_init
  * Desc     readys twi pins and sets twi bitrate
@@ -105,7 +111,9 @@ void twi_setAddress(uint8_t address)
 /* 
  * Function twi_readFrom
  * Desc     attempts to become twi bus master and read a
- *          series of bytes from a device on the bus
+ *          series of bytes from a device on the bus. The ISR
+ *          stores the bytes straight into data, so length is
+ *          not limited by TWI_BUFFER_LENGTH
  * Input    address: 7bit i2c device address
  *          data: pointer to byte array
  *          length: number of bytes to read into array
@@ -114,10 +122,8 @@ void twi_setAddress(uint8_t address)
  */
 uint8_t twi_readFrom(uint8_t address, uint8_t* data, uint8_t length, uint8_t sendStop)
 {
-  uint8_t i;
-
-  // ensure data will fit into buffer
-  if(TWI_BUFFER_LENGTH < length){
+  // nothing to read, and length-1 below would wrap
+  if(0 == length){
     return 0;
   }
 
@@ -131,6 +137,7 @@ uint8_t twi_readFrom(uint8_t address, uint8_t* data, uint8_t length, uint8_t sen
   twi_error = 0xFF;
 
   // initialize buffer iteration vars
+  twi_masterData = data;
   twi_masterBufferIndex = 0;
   twi_masterBufferLength = length-1;  // This is not intuitive, read on...
   // On receive, the previously configured ACK/NACK setting is transmitted in
@@ -166,18 +173,15 @@ uint8_t twi_readFrom(uint8_t address, uint8_t* data, uint8_t length, uint8_t sen
   if (twi_masterBufferIndex < length)
     length = twi_masterBufferIndex;
 
-  // copy twi buffer to data
-  for(i = 0; i < length; ++i){
-    data[i] = twi_masterBuffer[i];
-  }
-	
   return length;
 }
 
 /* 
  * Function twi_writeTo
  * Desc     attempts to become twi bus master and write a
- *          series of bytes to a device on the bus
+ *          series of bytes to a device on the bus. When waiting
+ *          the ISR sends straight from data, any length; otherwise
+ *          data is copied and must fit TWI_BUFFER_LENGTH
  * Input    address: 7bit i2c device address
  *          data: pointer to byte array
  *          length: number of bytes in array
@@ -194,7 +198,7 @@ uint8_t twi_writeTo(uint8_t address, uint8_t* data, uint8_t length, uint8_t wait
   uint8_t i;
 
   // ensure data will fit into buffer
-  if(TWI_BUFFER_LENGTH < length){
+  if(!wait && TWI_BUFFER_LENGTH < length){
     return 1;
   }
 
@@ -211,9 +215,14 @@ uint8_t twi_writeTo(uint8_t address, uint8_t* data, uint8_t length, uint8_t wait
   twi_masterBufferIndex = 0;
   twi_masterBufferLength = length;
   
-  // copy data to twi buffer
-  for(i = 0; i < length; ++i){
-    twi_masterBuffer[i] = data[i];
+  // data stays valid while we wait, otherwise copy it to the twi buffer
+  if(wait){
+    twi_masterData = data;
+  }else{
+    for(i = 0; i < length; ++i){
+      twi_masterBuffer[i] = data[i];
+    }
+    twi_masterData = twi_masterBuffer;
   }
   
   // build sla+w, slave device address + w bit
@@ -253,6 +262,74 @@ uint8_t twi_writeTo(uint8_t address, uint8_t* data, uint8_t length, uint8_t wait
     return 4;	// other twi error
 }
 
+/* 
+ * Function twi_readRegisterAsync
+ * Desc     starts a register read that runs entirely in the twi
+ *          interrupt: the register address is written, a repeated
+ *          start turns the bus around and the data is read. Returns
+ *          at once; callback is called from the ISR when done.
+ * Input    address: 7bit i2c device address
+ *          reg: register to read from
+ *          length: number of bytes to read
+ *          callback: called with the data and the number of bytes
+ *                    read, 0 if the device did not answer. The data
+ *                    is only valid during the call.
+ * Output   0 .. started
+ *          1 .. length to long for buffer
+ *          4 .. twi busy
+ */
+uint8_t twi_readRegisterAsync(uint8_t address, uint8_t reg, uint8_t length, void (*callback)(uint8_t*, uint8_t))
+{
+  // ensure data will fit into buffer
+  if(TWI_BUFFER_LENGTH < length || 0 == length){
+    return 1;
+  }
+
+  // don't wait for the bus, that is the point
+  if(TWI_READY != twi_state){
+    return 4;
+  }
+  twi_state = TWI_MTX;
+  twi_sendStop = false;
+  twi_error = 0xFF;
+  twi_onMasterReceive = callback;
+  twi_asyncLength = length;
+
+  // the write phase: just the register address
+  twi_masterData = twi_masterBuffer;
+  twi_masterBufferIndex = 0;
+  twi_masterBufferLength = 1;
+  twi_masterBuffer[0] = reg;
+
+  twi_slarw = TW_WRITE;
+  twi_slarw |= address << 1;
+
+  if (true == twi_inRepStart) {
+    // see twi_writeTo
+    twi_inRepStart = false;
+    TWDR = twi_slarw;
+    TWCR = _BV(TWINT) | _BV(TWEA) | _BV(TWEN) | _BV(TWIE);
+  }
+  else
+    TWCR = _BV(TWINT) | _BV(TWEA) | _BV(TWEN) | _BV(TWIE) | _BV(TWSTA);
+
+  return 0;
+}
+
+/*
+ * Function twi_asyncDone
+ * Desc     ends an async read: stop, then hand the data to the callback
+ * Input    length: number of bytes read
+ * Output   none
+ */
+static void twi_asyncDone(uint8_t length)
+{
+  void (*callback)(uint8_t*, uint8_t) = twi_onMasterReceive;
+  twi_onMasterReceive = 0;
+  twi_stop();
+  callback(twi_masterBuffer, length);
+}
+
 /* 
  * Function twi_transmit
  * Desc     fills slave tx buffer with data
@@ -377,8 +454,16 @@ ISR(TWI_vect)
       // if there is data to send, send it, otherwise stop 
       if(twi_masterBufferIndex < twi_masterBufferLength){
         // copy data to output register and ack
-        TWDR = twi_masterBuffer[twi_masterBufferIndex++];
+        TWDR = twi_masterData[twi_masterBufferIndex++];
         twi_reply(1);
+      }else if(twi_onMasterReceive){
+        // async register read: turn the bus around without leaving the ISR
+        twi_state = TWI_MRX;
+        twi_sendStop = true;
+        twi_masterBufferIndex = 0;
+        twi_masterBufferLength = twi_asyncLength - 1;
+        twi_slarw |= TW_READ;
+        TWCR = _BV(TWINT) | _BV(TWSTA) | _BV(TWEN) | _BV(TWIE);
       }else{
 	if (twi_sendStop)
           twi_stop();
@@ -394,21 +479,32 @@ ISR(TWI_vect)
       break;
     case TW_MT_SLA_NACK:  // address sent, nack received
       twi_error = TW_MT_SLA_NACK;
-      twi_stop();
+      if(twi_onMasterReceive)
+        twi_asyncDone(0);
+      else
+        twi_stop();
       break;
     case TW_MT_DATA_NACK: // data sent, nack received
       twi_error = TW_MT_DATA_NACK;
-      twi_stop();
+      if(twi_onMasterReceive)
+        twi_asyncDone(0);
+      else
+        twi_stop();
       break;
     case TW_MT_ARB_LOST: // lost bus arbitration
       twi_error = TW_MT_ARB_LOST;
       twi_releaseBus();
+      if(twi_onMasterReceive){
+        void (*callback)(uint8_t*, uint8_t) = twi_onMasterReceive;
+        twi_onMasterReceive = 0;
+        callback(twi_masterBuffer, 0);
+      }
       break;
 
     // Master Receiver
     case TW_MR_DATA_ACK: // data received, ack sent
       // put byte into buffer
-      twi_masterBuffer[twi_masterBufferIndex++] = TWDR;
+      twi_masterData[twi_masterBufferIndex++] = TWDR;
     case TW_MR_SLA_ACK:  // address sent, ack received
       // ack if more bytes are expected, otherwise nack
       if(twi_masterBufferIndex < twi_masterBufferLength){
@@ -419,8 +515,10 @@ ISR(TWI_vect)
       break;
     case TW_MR_DATA_NACK: // data received, nack sent
       // put final byte into buffer
-      twi_masterBuffer[twi_masterBufferIndex++] = TWDR;
-	if (twi_sendStop)
+      twi_masterData[twi_masterBufferIndex++] = TWDR;
+	if (twi_onMasterReceive)
+	  twi_asyncDone(twi_masterBufferIndex);
+	else if (twi_sendStop)
           twi_stop();
 	else {
 	  twi_inRepStart = true;	// we're gonna send the START
@@ -432,7 +530,10 @@ ISR(TWI_vect)
 	}    
 	break;
     case TW_MR_SLA_NACK: // address sent, nack received
-      twi_stop();
+      if(twi_onMasterReceive)
+        twi_asyncDone(0);
+      else
+        twi_stop();
       break;
     // TW_MR_ARB_LOST handled by TW_MT_ARB_LOST case
 
@@ -520,7 +621,10 @@ ISR(TWI_vect)
       break;
     case TW_BUS_ERROR: // bus error, illegal stop/start
       twi_error = TW_BUS_ERROR;
-      twi_stop();
+      if(twi_onMasterReceive)
+        twi_asyncDone(0);
+      else
+        twi_stop();
       break;
   }
 }
@@ -28,6 +28,8 @@
   #define TWI_FREQ 100000L
   #endif
 
+  // only slave mode, async reads and writes that don't wait go through
+  // this buffer; blocking master transfers use the caller's buffer
   #ifndef TWI_BUFFER_LENGTH
   #define TWI_BUFFER_LENGTH 32
   #endif
@@ -42,6 +44,7 @@
   void twi_setAddress(uint8_t);
   uint8_t twi_readFrom(uint8_t, uint8_t*, uint8_t, uint8_t);
   uint8_t twi_writeTo(uint8_t, uint8_t*, uint8_t, uint8_t, uint8_t);
+  uint8_t twi_readRegisterAsync(uint8_t, uint8_t, uint8_t, void (*)(uint8_t*, uint8_t));
   uint8_t twi_transmit(const uint8_t*, uint8_t);
   void twi_attachSlaveRxEvent( void (*)(uint8_t*, int) );
   void twi_attachSlaveTxEvent( void (*)(void) );
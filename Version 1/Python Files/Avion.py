@@ -3,30 +3,115 @@
 
 
 
+import struct
 import time
 import numpy as np
 import serial
 arduino = serial.Serial("COM7", 115200)
 arduino.close()
-input = np.empty(16)           # l'aruino envoi x en i0, y en en i1, batterie en i2, signal 1 a 4 en 3->6,                               
+input = np.empty(16)           # l'aruino envoi x en i0, y en i1, signal 1 a 4 en 2->5,                               
 output = np.empty(16)            #le pi envoi les comande servo moteurs en i0/i1, comande moteur principale en i2
 
-def ecriture_serie(valeur, indice):
+# Trames binaires echangees avec l'arduino :
+#   synchro, identifiant, champs int16 poids faible en premier, crc8 (identifiant + champs)
+#   telemetrie (arduino -> pi) : angles x et y en centiemes de degre, 4 signaux telecommande en us
+#   commandes  (pi -> arduino) : commande moteur principale, servo 1, servo 2
+#   demande de statistiques (pi -> arduino) : 1 pour remettre les compteurs a zero
+#   statistiques (arduino -> pi) : une trame par tache de l'ordonnanceur
+#   profil (arduino -> pi) : une trame par section mesuree, si l'arduino est compile avec PROFILER
+TRAME_SYNCHRO = 0xA5
+TRAME_TELEMETRIE = 0x01
+TRAME_COMMANDES = 0x02
+TRAME_DEMANDE_STATISTIQUES = 0x03
+TRAME_STATISTIQUES = 0x04
+TRAME_PROFIL = 0x05
+FORMATS_TRAMES = {TRAME_TELEMETRIE: struct.Struct("<6h"), TRAME_COMMANDES: struct.Struct("<3h"),
+                  TRAME_DEMANDE_STATISTIQUES: struct.Struct("<h"), TRAME_STATISTIQUES: struct.Struct("<7H"),
+                  TRAME_PROFIL: struct.Struct("<5H")}
+CHAMPS_STATISTIQUES = ("tache", "frequence", "executions", "depassements", "retard_moyen", "retard_max", "duree_max")
+CHAMPS_PROFIL = ("section", "executions", "duree_min", "duree_moyenne", "duree_max")
+# dans l'ordre de l'enum des profils de Arduino.ino
+SECTIONS_PROFIL = ("angles", "estimateur", "serie", "telemetrie", "envoi_trame", "moteurs")
+
+def table_crc8():
+    table = []
+    for octet in range(256):
+        crc = octet
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+        table.append(crc)
+    return table
+
+TABLE_CRC8 = table_crc8()
+
+def crc8(octets):
+    crc = 0
+    for octet in octets:
+        crc = TABLE_CRC8[crc ^ octet]
+    return crc
+
+def trame(identifiant, *champs):
+    corps = bytes([identifiant]) + FORMATS_TRAMES[identifiant].pack(*champs)
+    return bytes([TRAME_SYNCHRO]) + corps + bytes([crc8(corps)])
+
+class LecteurTrames:
+    """Decoupe un flux d'octets en trames valides, quelle que soit la facon dont il arrive"""
+
+    def __init__(self):
+        self.tampon = bytearray()
+        self.erreurs = 0
+
+    def ajouter(self, octets):
+        """Renvoie la liste des (identifiant, champs) completes dans ce qui a ete recu"""
+        self.tampon += octets
+        trames = []
+        while True:
+            debut = self.tampon.find(TRAME_SYNCHRO)
+            if debut < 0:
+                self.tampon.clear()
+                break
+            del self.tampon[:debut]
+            if len(self.tampon) < 2:
+                break
+            format_trame = FORMATS_TRAMES.get(self.tampon[1])
+            if format_trame is None:
+                del self.tampon[0]
+                continue
+            longueur = 2 + format_trame.size + 1
+            if len(self.tampon) < longueur:
+                break
+            if crc8(self.tampon[1:longueur - 1]) != self.tampon[longueur - 1]:
+                # fausse synchro ou octets perdus : on repart de l'octet suivant
+                self.erreurs += 1
+                del self.tampon[0]
+                continue
+            trames.append((self.tampon[1], format_trame.unpack_from(self.tampon, 2)))
+            del self.tampon[:longueur]
+        return trames
+
+lecteur = LecteurTrames()
+
+def ecriture_commandes(commandes):
     if(arduino.is_open):
-        mess = str((valeur<<4)+indice )+ '\n'
-        arduino.write(mess.encode('utf-8'))
+        arduino.write(trame(TRAME_COMMANDES, *[int(c) for c in commandes[0:3]]))
         return 1
     else : 
         return 0
 
 
-def lecture_serie():    
-    mess = arduino.readline()
-    str_mess = mess.decode("utf-8")
-    str_mess = str_mess[0:len(str_mess)-2]
-    nombre = int(str_mess)
-    nombre = nombre & 15
-    return (int(str_mess)-nombre)>>4, nombre
+def demande_statistiques(remise_a_zero=False):
+    """L'arduino repond par une trame TRAME_STATISTIQUES par tache"""
+    if(arduino.is_open):
+        arduino.write(trame(TRAME_DEMANDE_STATISTIQUES, 1 if remise_a_zero else 0))
+        return 1
+    else :
+        return 0
+
+
+def lecture_serie():
+    """Lit tout ce qui est arrive et renvoie les trames (identifiant, champs) recues"""
+    recu = arduino.read(arduino.in_waiting)
+    return lecteur.ajouter(recu)
 
 def ouverture_port_arduino():
     mess = ""
@@ -41,8 +126,13 @@ def ouverture_port_arduino():
     return(mess)
 
 def init_tableau():
-    for i in range(0, 15):
+    for i in range(0, 16):
         input[i]=0
+        output[i]=0
+    # valeurs par defaut de commandes_moteur dans Arduino.ino : servos au neutre
+    output[0] = 1000
+    output[1] = 80
+    output[2] = 80
 
 def initialisation():
     init_tableau()
@@ -60,13 +150,27 @@ if __name__ == "__main__" :
         while arduino.in_waiting == 0:
             a=1
         if(arduino.in_waiting > 0 and arduino.is_open):
-            valeur, i = lecture_serie()
-            input[i]= valeur 
-            print("valeur", str(input[0]), "indice", str(i))
-
-        if input[0] == 40  :
-            arduino.write(b'16\n')
-        #else :            ecriture_serie(0, 0)
+            for identifiant, champs in lecture_serie():
+                if identifiant == TRAME_TELEMETRIE:
+                    input[0] = champs[0] / 100.0
+                    input[1] = champs[1] / 100.0
+                    input[2:6] = champs[2:6]
+                    print("x", str(input[0]), "y", str(input[1]), "signaux", str(input[2:6]))
+                elif identifiant == TRAME_STATISTIQUES:
+                    print(dict(zip(CHAMPS_STATISTIQUES, champs)))
+                elif identifiant == TRAME_PROFIL:
+                    profil = dict(zip(CHAMPS_PROFIL, champs))
+                    profil["section"] = SECTIONS_PROFIL[champs[0]] if champs[0] < len(SECTIONS_PROFIL) else champs[0]
+                    print(profil)
+
+        # statistiques de l'ordonnanceur toutes les 10 s
+        if time.time() - t0 > 10:
+            t0 = time.time()
+            demande_statistiques(True)
+
+        if int(input[0]) == 40  :
+            output[0] = 1
+            ecriture_commandes(output)
 
         
         while time.time()-0.01 < last_time :